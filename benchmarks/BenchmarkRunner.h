@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Minimal benchmark runner used as a performance regression gate.
+//
+// Every benchmark is a function that performs 1 iteration of some operation, together with the number of bytes
+// the operation reads and writes. The runner
+//   * pins the calling thread to a single CPU, so that timings are not disturbed by migrations;
+//   * warms up the caches (and the branch predictors) by running each benchmark several times before measuring;
+//   * measures many samples, each consisting of enough iterations to last at least kMinSampleDuration, and
+//     reports the median, the 90th and the 99th percentiles of the time per iteration;
+//   * reports the achieved bandwidth as a share of the bandwidth of std::memcpy over the same number of bytes
+//     (the "roofline" for memory-bound operations);
+//   * compares the median times with a baseline stored as a flat JSON object {"name": median_ns, ...} and fails if
+//     any benchmark is slower than the baseline by more than the given threshold.
+
+namespace imageview {
+namespace benchmarks {
+
+struct RunnerOptions {
+  // Only benchmarks whose names contain this substring are run.
+  std::string filter;
+  // The number of measured samples per benchmark.
+  unsigned int num_samples = 31;
+  // The number of unmeasured iterations before the samples.
+  unsigned int num_warmup_iterations = 3;
+  // CPU to pin the thread to, or -1 to leave the affinity unchanged.
+  int cpu = 0;
+  // Relative slowdown of the median time at which a benchmark is considered a regression.
+  double regression_threshold = 0.1;
+};
+
+struct BenchmarkResult {
+  std::string name;
+  std::size_t bytes_per_iteration = 0;
+  double median_ns = 0.0;
+  double p90_ns = 0.0;
+  double p99_ns = 0.0;
+  // Achieved bandwidth in GB/s, computed from the median time.
+  double bandwidth_gbps = 0.0;
+  // bandwidth_gbps divided by the bandwidth of std::memcpy over the same number of bytes.
+  double roofline_share = 0.0;
+};
+
+// Pins the calling thread to the specified CPU.
+// \return true on success, false if pinning failed or is not supported on this platform.
+inline bool pinCurrentThread(int cpu) {
+#if defined(_WIN32)
+  return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu) != 0;
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+// Volatile destination for doNotOptimize().
+inline volatile std::byte benchmark_sink{};
+
+// Prevents the compiler from optimizing away the computation of @value.
+template <class T>
+void doNotOptimize(const T& value) {
+  benchmark_sink = *reinterpret_cast<const volatile std::byte*>(&value);
+}
+
+// Parses a flat JSON object mapping benchmark names to median times in nanoseconds.
+// Names must not contain escaped characters.
+inline std::map<std::string, double> readBaseline(std::istream& stream) {
+  std::map<std::string, double> baseline;
+  const std::string text((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+  std::size_t position = 0;
+  while ((position = text.find('"', position)) != std::string::npos) {
+    const std::size_t name_end = text.find('"', position + 1);
+    const std::size_t colon = text.find(':', name_end);
+    if (name_end == std::string::npos || colon == std::string::npos) {
+      break;
+    }
+    baseline[text.substr(position + 1, name_end - position - 1)] = std::stod(text.substr(colon + 1));
+    position = colon + 1;
+  }
+  return baseline;
+}
+
+// Writes the median times of @results as a flat JSON object.
+inline void writeBaseline(std::ostream& stream, const std::vector<BenchmarkResult>& results) {
+  stream << "{\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    stream << "  \"" << results[i].name << "\": " << results[i].median_ns << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  stream << "}\n";
+}
+
+class BenchmarkRunner {
+ public:
+  // Each sample runs the benchmark repeatedly for at least this long.
+  static constexpr std::chrono::microseconds kMinSampleDuration{200};
+
+  explicit BenchmarkRunner(const RunnerOptions& options = RunnerOptions()) : options_(options) {}
+
+  // Registers a benchmark.
+  // \param name - unique name of the benchmark.
+  // \param bytes_per_iteration - the number of bytes read and written by 1 iteration.
+  // \param function - performs 1 iteration.
+  void add(std::string name, std::size_t bytes_per_iteration, std::function<void()> function) {
+    benchmarks_.push_back(Benchmark{std::move(name), bytes_per_iteration, std::move(function)});
+  }
+
+  // Runs all benchmarks that match the filter and prints a table of results into @stream.
+  std::vector<BenchmarkResult> run(std::ostream& stream) {
+    if (options_.cpu >= 0 && !pinCurrentThread(options_.cpu)) {
+      stream << "warning: failed to pin the thread to CPU " << options_.cpu << '\n';
+    }
+    std::vector<BenchmarkResult> results;
+    for (const Benchmark& benchmark : benchmarks_) {
+      if (benchmark.name.find(options_.filter) == std::string::npos) {
+        continue;
+      }
+      BenchmarkResult result = measure(benchmark.name, benchmark.bytes_per_iteration, benchmark.function);
+      const double roofline_gbps = getMemcpyBandwidth(benchmark.bytes_per_iteration);
+      result.roofline_share = (roofline_gbps > 0.0) ? result.bandwidth_gbps / roofline_gbps : 0.0;
+      stream << result.name << ": median " << result.median_ns / 1000.0 << " us, p90 " << result.p90_ns / 1000.0
+             << " us, p99 " << result.p99_ns / 1000.0 << " us, " << result.bandwidth_gbps << " GB/s ("
+             << result.roofline_share * 100.0 << "% of memcpy)\n";
+      results.push_back(result);
+    }
+    return results;
+  }
+
+  // Compares @results with @baseline and prints the regressions into @stream.
+  // Benchmarks missing from the baseline are ignored.
+  // \return the number of regressions.
+  std::size_t compare(const std::vector<BenchmarkResult>& results, const std::map<std::string, double>& baseline,
+                      std::ostream& stream) const {
+    std::size_t num_regressions = 0;
+    for (const BenchmarkResult& result : results) {
+      const auto it = baseline.find(result.name);
+      if (it == baseline.end() || it->second <= 0.0) {
+        continue;
+      }
+      const double slowdown = result.median_ns / it->second - 1.0;
+      if (slowdown > options_.regression_threshold) {
+        stream << "REGRESSION " << result.name << ": " << it->second / 1000.0 << " us -> "
+               << result.median_ns / 1000.0 << " us (+" << slowdown * 100.0 << "%)\n";
+        ++num_regressions;
+      }
+    }
+    return num_regressions;
+  }
+
+ private:
+  struct Benchmark {
+    std::string name;
+    std::size_t bytes_per_iteration;
+    std::function<void()> function;
+  };
+
+  BenchmarkResult measure(const std::string& name, std::size_t bytes_per_iteration,
+                          const std::function<void()>& function) const {
+    using Clock = std::chrono::steady_clock;
+    for (unsigned int i = 0; i < options_.num_warmup_iterations; ++i) {
+      function();
+    }
+    // Calibrate the number of iterations per sample.
+    std::size_t iterations_per_sample = 1;
+    while (true) {
+      const Clock::time_point start = Clock::now();
+      for (std::size_t i = 0; i < iterations_per_sample; ++i) {
+        function();
+      }
+      if (Clock::now() - start >= kMinSampleDuration) {
+        break;
+      }
+      iterations_per_sample *= 2;
+    }
+    std::vector<double> samples(std::max(options_.num_samples, 1u));
+    for (double& sample : samples) {
+      const Clock::time_point start = Clock::now();
+      for (std::size_t i = 0; i < iterations_per_sample; ++i) {
+        function();
+      }
+      const std::chrono::duration<double, std::nano> duration = Clock::now() - start;
+      sample = duration.count() / static_cast<double>(iterations_per_sample);
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto percentile = [&samples](double p) {
+      return samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1) + 0.5)];
+    };
+    BenchmarkResult result;
+    result.name = name;
+    result.bytes_per_iteration = bytes_per_iteration;
+    result.median_ns = percentile(0.5);
+    result.p90_ns = percentile(0.9);
+    result.p99_ns = percentile(0.99);
+    result.bandwidth_gbps = (result.median_ns > 0.0) ? static_cast<double>(bytes_per_iteration) / result.median_ns : 0.0;
+    return result;
+  }
+
+  // Returns the bandwidth of std::memcpy that reads and writes @num_bytes bytes in total.
+  double getMemcpyBandwidth(std::size_t num_bytes) {
+    const auto it = memcpy_bandwidth_.find(num_bytes);
+    if (it != memcpy_bandwidth_.end()) {
+      return it->second;
+    }
+    const std::size_t size = std::max<std::size_t>(num_bytes / 2, 1);
+    std::vector<std::byte> src(size, std::byte{1});
+    std::vector<std::byte> dst(size);
+    const BenchmarkResult result = measure("memcpy", 2 * size, [&] {
+      std::memcpy(dst.data(), src.data(), size);
+      doNotOptimize(dst[size / 2]);
+    });
+    return memcpy_bandwidth_[num_bytes] = result.bandwidth_gbps;
+  }
+
+  RunnerOptions options_;
+  std::vector<Benchmark> benchmarks_;
+  std::map<std::size_t, double> memcpy_bandwidth_;
+};
+
+}  // namespace benchmarks
+}  // namespace imageview
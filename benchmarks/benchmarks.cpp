@@ -0,0 +1,212 @@
+#include "BenchmarkRunner.h"
+
+#include <imageview/ConnectedComponents.h>
+#include <imageview/ContinuousImageView.h>
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageView.h>
+#include <imageview/ImageViewUtils.h>
+#include <imageview/MedianFilter.h>
+#include <imageview/Morphology.h>
+#include <imageview/Pyramid.h>
+#include <imageview/QoiCodec.h>
+#include <imageview/RleImage.h>
+#include <imageview/SrgbConversions.h>
+#include <imageview/Threshold.h>
+#include <imageview/ToneCurve.h>
+#include <imageview/YuvConversions.h>
+#include <imageview/YuvImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatLabel32.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+#include <imageview/pixel_formats/PixelFormatRGBF32.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Performance regression gate for the algorithms of the library.
+//
+// Usage:
+//   benchmarks [--filter=<substring>] [--samples=<n>] [--cpu=<n>] [--threshold=<fraction>]
+//              [--baseline=<path>] [--write-baseline=<path>]
+//
+// Every algorithm is measured on a 1920x1080 image of each built-in 8-bit pixel format (Grayscale8, RGB24,
+// RGBA32), both as a continuous image ("full") and as a crop of a larger image with gaps between rows ("cropped").
+// With --baseline the program exits with a non-zero code if any benchmark is slower than in the baseline by more
+// than the threshold (10% by default).
+
+namespace imageview {
+namespace benchmarks {
+namespace {
+
+constexpr unsigned int kHeight = 1080;
+constexpr unsigned int kWidth = 1920;
+// The cropped images are taken from images that are larger by this amount in each dimension.
+constexpr unsigned int kCropMargin = 32;
+
+// Owning image of kHeight x kWidth pixels, or a crop of a larger one, filled with a deterministic pattern.
+template <class PixelFormat>
+class TestImage {
+ public:
+  explicit TestImage(bool cropped) {
+    const unsigned int margin = cropped ? kCropMargin : 0;
+    const unsigned int height = kHeight + margin;
+    const unsigned int width = kWidth + margin;
+    data_.resize(static_cast<std::size_t>(height) * width * PixelFormat::kBytesPerPixel);
+    for (std::size_t i = 0; i < data_.size(); ++i) {
+      data_[i] = static_cast<std::byte>((i * 7 + i / 4096) % 251);
+    }
+    const ImageView<PixelFormat, true> image(height, width, width, data_);
+    view_ = crop(image, margin / 2, margin / 2, kHeight, kWidth);
+  }
+
+  ImageView<PixelFormat, true> view() const { return view_; }
+
+  std::size_t sizeInBytes() const { return view_.area() * static_cast<std::size_t>(PixelFormat::kBytesPerPixel); }
+
+ private:
+  std::vector<std::byte> data_;
+  ImageView<PixelFormat, true> view_;
+};
+
+template <class PixelFormat>
+void addFormatBenchmarks(BenchmarkRunner& runner, const std::string& format_name, bool cropped) {
+  const std::string suffix = "/" + format_name + (cropped ? "/cropped" : "/full");
+  const auto src = std::make_shared<TestImage<PixelFormat>>(cropped);
+  const auto dst = std::make_shared<TestImage<PixelFormat>>(cropped);
+  const std::size_t size = src->sizeInBytes();
+
+  runner.add("copy" + suffix, 2 * size, [src, dst] { copy(src->view(), dst->view()); });
+  runner.add("fill" + suffix, size, [dst] { fill(dst->view(), typename PixelFormat::color_type{}); });
+  runner.add("hash" + suffix, size, [src] { doNotOptimize(hash(src->view())); });
+  runner.add("sad" + suffix, 2 * size, [src, dst] { doNotOptimize(sad(src->view(), dst->view())); });
+  runner.add("applyToneCurve" + suffix, 2 * size, [src, dst, curve = ToneCurve::gamma(2.2)] {
+    applyToneCurve(src->view(), dst->view(), curve);
+  });
+  runner.add("medianFilter3x3" + suffix, 2 * size, [src, dst] { medianFilter(src->view(), dst->view(), 1); });
+  runner.add("medianFilter31x31" + suffix, 2 * size, [src, dst] { medianFilter(src->view(), dst->view(), 15); });
+  // The pyramid reads the source once and writes 1/4 + 1/16 + ... of it.
+  runner.add("buildPyramid6" + suffix, size + size / 3, [src] {
+    doNotOptimize(buildPyramid(src->view(), 6, PyramidMode::kGaussian5).size());
+  });
+  const auto qoi = std::make_shared<std::vector<std::byte>>();
+  encodeQoi(src->view(), *qoi);
+  runner.add("encodeQoi" + suffix, size + qoi->size(), [src, qoi] {
+    qoi->clear();
+    encodeQoi(src->view(), *qoi);
+  });
+  if constexpr (PixelFormat::kBytesPerPixel != 1) {
+    runner.add("decodeQoi" + suffix, qoi->size() + size, [dst, qoi] { decodeQoi(*qoi, dst->view()); });
+  }
+}
+
+void addGrayscaleBenchmarks(BenchmarkRunner& runner, bool cropped) {
+  const std::string suffix = cropped ? "/Grayscale8/cropped" : "/Grayscale8/full";
+  const auto src = std::make_shared<TestImage<PixelFormatGrayscale8>>(cropped);
+  const auto dst = std::make_shared<TestImage<PixelFormatGrayscale8>>(cropped);
+  const auto labels = std::make_shared<std::vector<std::byte>>(src->view().area() * PixelFormatLabel32::kBytesPerPixel);
+  const std::size_t size = src->sizeInBytes();
+
+  runner.add("threshold" + suffix, 2 * size, [src, dst] { threshold(src->view(), dst->view(), 128); });
+  runner.add("adaptiveThreshold15" + suffix, 2 * size, [src, dst] {
+    adaptiveThreshold(src->view(), dst->view(), 7, 0);
+  });
+  runner.add("computeHistogram" + suffix, size, [src] { doNotOptimize(computeHistogram(src->view())[0]); });
+  runner.add("erode15x15" + suffix, 2 * size, [src, dst] { erode(src->view(), dst->view(), 15, 15); });
+  runner.add("labelComponents" + suffix, size + 4 * size, [src, labels] {
+    const ImageView<PixelFormatLabel32, true> labels_view(kHeight, kWidth, kWidth, *labels);
+    doNotOptimize(labelComponents(src->view(), labels_view));
+  });
+  // Binary masks are what RleImage is for.
+  const auto mask = std::make_shared<TestImage<PixelFormatGrayscale8>>(cropped);
+  threshold(src->view(), mask->view(), 128);
+  const auto rle = std::make_shared<RleImage<PixelFormatGrayscale8>>(mask->view());
+  runner.add("encodeRle" + suffix, size, [mask] {
+    doNotOptimize(RleImage<PixelFormatGrayscale8>(mask->view()).numRuns());
+  });
+  runner.add("decompressRle" + suffix, size, [rle, dst] { decompress(*rle, dst->view()); });
+}
+
+void addColorBenchmarks(BenchmarkRunner& runner, bool cropped) {
+  const std::string suffix = cropped ? "/RGB24/cropped" : "/RGB24/full";
+  const auto src = std::make_shared<TestImage<PixelFormatRGB24>>(cropped);
+  const auto linear = std::make_shared<std::vector<std::byte>>(src->view().area() * PixelFormatRGBF32::kBytesPerPixel);
+  const auto yuv = std::make_shared<std::vector<std::byte>>(
+      static_cast<std::size_t>(kHeight) * kWidth + 2 * getChromaSize(kHeight) * getChromaSize(kWidth));
+  const std::size_t size = src->sizeInBytes();
+
+  runner.add("srgbToLinear" + suffix, size + 4 * size, [src, linear] {
+    srgbToLinear(src->view(), ImageView<PixelFormatRGBF32, true>(kHeight, kWidth, kWidth, *linear));
+  });
+  runner.add("convertToNV12" + suffix, size + yuv->size(), [src, yuv] {
+    convert(src->view(), NV12ImageView<true>(kHeight, kWidth, *yuv));
+  });
+  runner.add("convertFromNV12" + suffix, size + yuv->size(), [src, yuv] {
+    convert(NV12ImageView<false>(kHeight, kWidth, *yuv), src->view());
+  });
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace imageview
+
+int main(int argc, char** argv) {
+  using namespace imageview::benchmarks;
+  RunnerOptions options;
+  std::string baseline_path;
+  std::string write_baseline_path;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view argument = argv[i];
+    const auto value = [&argument](std::string_view prefix) {
+      return std::string(argument.substr(prefix.size()));
+    };
+    if (argument.starts_with("--filter=")) {
+      options.filter = value("--filter=");
+    } else if (argument.starts_with("--samples=")) {
+      options.num_samples = static_cast<unsigned int>(std::stoul(value("--samples=")));
+    } else if (argument.starts_with("--cpu=")) {
+      options.cpu = std::stoi(value("--cpu="));
+    } else if (argument.starts_with("--threshold=")) {
+      options.regression_threshold = std::stod(value("--threshold="));
+    } else if (argument.starts_with("--baseline=")) {
+      baseline_path = value("--baseline=");
+    } else if (argument.starts_with("--write-baseline=")) {
+      write_baseline_path = value("--write-baseline=");
+    } else {
+      std::cerr << "unknown argument: " << argument << '\n';
+      return EXIT_FAILURE;
+    }
+  }
+
+  BenchmarkRunner runner(options);
+  for (const bool cropped : {false, true}) {
+    addFormatBenchmarks<imageview::PixelFormatGrayscale8>(runner, "Grayscale8", cropped);
+    addFormatBenchmarks<imageview::PixelFormatRGB24>(runner, "RGB24", cropped);
+    addFormatBenchmarks<imageview::PixelFormatRGBA32>(runner, "RGBA32", cropped);
+    addGrayscaleBenchmarks(runner, cropped);
+    addColorBenchmarks(runner, cropped);
+  }
+  const std::vector<BenchmarkResult> results = runner.run(std::cout);
+
+  if (!write_baseline_path.empty()) {
+    std::ofstream stream(write_baseline_path);
+    writeBaseline(stream, results);
+  }
+  if (!baseline_path.empty()) {
+    std::ifstream stream(baseline_path);
+    if (!stream) {
+      std::cerr << "failed to open the baseline " << baseline_path << '\n';
+      return EXIT_FAILURE;
+    }
+    if (runner.compare(results, readBaseline(stream), std::cout) != 0) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
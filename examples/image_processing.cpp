@@ -1,5 +1,7 @@
 #include "image_processing.h"
 
+#include <imageview/SegmentedAlgorithms.h>
+
 namespace imageview {
 namespace examples {
 
@@ -10,15 +12,13 @@ RGB24 computeMeanColor(ImageView<PixelFormatRGB24> image) {
   unsigned int sum_red = 0;
   unsigned int sum_green = 0;
   unsigned int sum_blue = 0;
-  // ImageView is not necessarily continuous, so we cannot iterate over it in one loop
-  // (well, technically we could, but it would be ugly and likely less efficient).
-  for (int y = 0; y < image.height(); ++y) {
-    for (const RGB24& color : image.row(y)) {
-      sum_red += color.red;
-      sum_green += color.green;
-      sum_blue += color.blue;
-    }
-  }
+  // ImageView is not necessarily continuous. A range-based for loop over it works, but checks for the end of
+  // the row after every pixel; forEach() processes the image row by row instead.
+  forEach(image, [&](const RGB24& color) {
+    sum_red += color.red;
+    sum_green += color.green;
+    sum_blue += color.blue;
+  });
   return RGB24(static_cast<unsigned char>(sum_red / image.area()),
                static_cast<unsigned char>(sum_green / image.area()),
                static_cast<unsigned char>(sum_blue / image.area()));
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <imageview/ImageRowView.h>
+#include <imageview/ImageView.h>
+#include <imageview/ImageViewUtils.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+// Views that guarantee the alignment of every row.
+//
+// ImageView makes no promises about the alignment of its data, so a vectorized kernel has to use unaligned loads
+// or peel a prologue on every row. AlignedImageView<PixelFormat, Mutable, Alignment> is an ImageView whose first
+// row starts at an address that is a multiple of Alignment, and whose row pitch (stride * kBytesPerPixel) is a
+// multiple of Alignment, so every row is aligned. Both properties are validated at construction; alignedRow()
+// returns row pointers marked with std::assume_aligned, which lets the compiler use aligned loads and skip the
+// prologues.
+//
+// AlignedImageView converts implicitly to ImageView (dropping the guarantee), so it can be passed to any function
+// that takes an ImageView. crop() also returns an ImageView, because an arbitrary column offset breaks the
+// alignment; cropAligned() preserves it and throws if the column offset does not keep the rows aligned.
+
+namespace imageview {
+
+// Returns the smallest stride (in pixels) not less than @width such that stride * PixelFormat::kBytesPerPixel is
+// a multiple of Alignment.
+template <class PixelFormat, std::size_t Alignment>
+constexpr unsigned int getAlignedStride(unsigned int width) noexcept {
+  constexpr std::size_t kStep = Alignment / std::gcd(Alignment, static_cast<std::size_t>(PixelFormat::kBytesPerPixel));
+  return static_cast<unsigned int>((width + kStep - 1) / kStep * kStep);
+}
+
+// Non-owning view into an image whose rows are aligned to Alignment bytes.
+// \param PixelFormat - specifies how colors are stored in the bitmap.
+// \param Mutable - if true, the view provides write access to the bitmap.
+// \param Alignment - alignment of every row in bytes. Must be a power of 2.
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+class AlignedImageView {
+ public:
+  static_assert(std::has_single_bit(Alignment), "Alignment must be a power of 2.");
+
+  using byte_type = std::conditional_t<Mutable, std::byte, const std::byte>;
+  using reference = typename ImageView<PixelFormat, Mutable>::reference;
+  static constexpr std::size_t kAlignment = Alignment;
+
+  // Constructs a view from an ImageView.
+  // \param image - image whose data address and row pitch are multiples of Alignment. The row pitch is not
+  //        checked for images with fewer than 2 rows, and nothing is checked for empty images.
+  // \throw std::invalid_argument if @image is not aligned.
+  explicit AlignedImageView(ImageView<PixelFormat, Mutable> image);
+
+  // Constructs a view into an image.
+  // \param height - height of the image.
+  // \param width - width of the image.
+  // \param stride - the number of pixels between the beginnings of 2 consecutive rows.
+  //        stride * PixelFormat::kBytesPerPixel must be a multiple of Alignment (see getAlignedStride()).
+  // \param data - bitmap data; must be aligned to Alignment bytes.
+  // \param pixel_format - PixelFormat instance to use.
+  // \throw std::invalid_argument if the arguments are inconsistent or not aligned.
+  AlignedImageView(unsigned int height, unsigned int width, unsigned int stride, std::span<byte_type> data,
+                   const PixelFormat& pixel_format = PixelFormat());
+
+  // Construct a read-only view from a mutable view, and/or a view with a weaker alignment from a view with a
+  // stronger alignment.
+  template <bool OtherMutable, std::size_t OtherAlignment,
+            class Enable = std::enable_if_t<(Mutable <= OtherMutable) && (OtherAlignment % Alignment == 0) &&
+                                            (Mutable != OtherMutable || Alignment != OtherAlignment)>>
+  AlignedImageView(AlignedImageView<PixelFormat, OtherMutable, OtherAlignment> other) noexcept;
+
+  // Returns the view without the alignment guarantee.
+  constexpr ImageView<PixelFormat, Mutable> view() const noexcept;
+
+  // Implicit conversion to ImageView.
+  constexpr operator ImageView<PixelFormat, Mutable>() const noexcept;
+
+  // Implicit conversion to a read-only ImageView.
+  template <bool Enable = Mutable, class = std::enable_if_t<Enable>>
+  constexpr operator ImageView<PixelFormat, false>() const noexcept;
+
+  constexpr unsigned int height() const noexcept;
+
+  constexpr unsigned int width() const noexcept;
+
+  constexpr unsigned int stride() const noexcept;
+
+  constexpr unsigned int area() const noexcept;
+
+  constexpr bool empty() const noexcept;
+
+  constexpr const PixelFormat& pixelFormat() const noexcept;
+
+  constexpr std::span<byte_type> data() const noexcept;
+
+  constexpr reference operator()(unsigned int y, unsigned int x) const;
+
+  constexpr ImageRowView<PixelFormat, Mutable> row(unsigned int y) const;
+
+  // Returns a pointer to the first byte of the row @y, which is aligned to Alignment bytes.
+  // Unlike row(), doesn't check that @y is within [0; height()).
+  byte_type* alignedRow(unsigned int y) const noexcept;
+
+ private:
+  ImageView<PixelFormat, Mutable> image_;
+};
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+AlignedImageView<PixelFormat, Mutable, Alignment>::AlignedImageView(ImageView<PixelFormat, Mutable> image)
+    : image_(image) {
+  if (image.empty()) {
+    return;
+  }
+  if (reinterpret_cast<std::uintptr_t>(image.data().data()) % Alignment != 0)
+  {
+    throw std::invalid_argument("AlignedImageView(): the data is not aligned.");
+  }
+  if (image.height() > 1 && static_cast<std::size_t>(image.stride()) * PixelFormat::kBytesPerPixel % Alignment != 0)
+  {
+    throw std::invalid_argument("AlignedImageView(): the row pitch is not a multiple of the alignment.");
+  }
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+AlignedImageView<PixelFormat, Mutable, Alignment>::AlignedImageView(unsigned int height, unsigned int width,
+                                                                    unsigned int stride, std::span<byte_type> data,
+                                                                    const PixelFormat& pixel_format)
+    : AlignedImageView(ImageView<PixelFormat, Mutable>(height, width, stride, data, pixel_format)) {}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+template <bool OtherMutable, std::size_t OtherAlignment, class Enable>
+AlignedImageView<PixelFormat, Mutable, Alignment>::AlignedImageView(
+    AlignedImageView<PixelFormat, OtherMutable, OtherAlignment> other) noexcept
+    : image_(other.view()) {}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr ImageView<PixelFormat, Mutable> AlignedImageView<PixelFormat, Mutable, Alignment>::view() const noexcept {
+  return image_;
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr AlignedImageView<PixelFormat, Mutable, Alignment>::operator ImageView<PixelFormat, Mutable>() const noexcept {
+  return image_;
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+template <bool Enable, class>
+constexpr AlignedImageView<PixelFormat, Mutable, Alignment>::operator ImageView<PixelFormat, false>() const noexcept {
+  return ImageView<PixelFormat, false>(image_);
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr unsigned int AlignedImageView<PixelFormat, Mutable, Alignment>::height() const noexcept {
+  return image_.height();
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr unsigned int AlignedImageView<PixelFormat, Mutable, Alignment>::width() const noexcept {
+  return image_.width();
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr unsigned int AlignedImageView<PixelFormat, Mutable, Alignment>::stride() const noexcept {
+  return image_.stride();
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr unsigned int AlignedImageView<PixelFormat, Mutable, Alignment>::area() const noexcept {
+  return image_.area();
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr bool AlignedImageView<PixelFormat, Mutable, Alignment>::empty() const noexcept {
+  return image_.empty();
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr const PixelFormat& AlignedImageView<PixelFormat, Mutable, Alignment>::pixelFormat() const noexcept {
+  return image_.pixelFormat();
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr auto AlignedImageView<PixelFormat, Mutable, Alignment>::data() const noexcept -> std::span<byte_type> {
+  return image_.data();
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr auto AlignedImageView<PixelFormat, Mutable, Alignment>::operator()(unsigned int y, unsigned int x) const
+    -> reference {
+  return image_(y, x);
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+constexpr ImageRowView<PixelFormat, Mutable> AlignedImageView<PixelFormat, Mutable, Alignment>::row(
+    unsigned int y) const {
+  return image_.row(y);
+}
+
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+auto AlignedImageView<PixelFormat, Mutable, Alignment>::alignedRow(unsigned int y) const noexcept -> byte_type* {
+  byte_type* row = image_.data().data() + static_cast<std::size_t>(y) * image_.stride() * PixelFormat::kBytesPerPixel;
+  return std::assume_aligned<Alignment>(row);
+}
+
+// Same as crop() for ImageView; the result is not guaranteed to be aligned.
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+ImageView<PixelFormat, Mutable> crop(AlignedImageView<PixelFormat, Mutable, Alignment> image, unsigned int first_row,
+                                     unsigned int first_column, unsigned int num_rows, unsigned int num_columns) {
+  return crop(image.view(), first_row, first_column, num_rows, num_columns);
+}
+
+// Same as crop(), but preserves the alignment.
+// \throw std::invalid_argument if the arguments are invalid for crop(), or if first_column * kBytesPerPixel is not
+//        a multiple of Alignment.
+template <class PixelFormat, bool Mutable, std::size_t Alignment>
+AlignedImageView<PixelFormat, Mutable, Alignment> cropAligned(AlignedImageView<PixelFormat, Mutable, Alignment> image,
+                                                              unsigned int first_row, unsigned int first_column,
+                                                              unsigned int num_rows, unsigned int num_columns) {
+  if (static_cast<std::size_t>(first_column) * PixelFormat::kBytesPerPixel % Alignment != 0)
+  {
+    throw std::invalid_argument("imageview::cropAligned(): first_column breaks the alignment.");
+  }
+  return AlignedImageView<PixelFormat, Mutable, Alignment>(
+      crop(image.view(), first_row, first_column, num_rows, num_columns));
+}
+
+}  // namespace imageview
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <imageview/IsBitPackedPixelFormat.h>
+#include <imageview/internal/BitPixelRef.h>
+#include <imageview/internal/ImageViewStorage.h>
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+namespace imageview {
+
+// Non-owning view into a bitmap image whose pixels occupy less than a byte.
+//
+// BitImageView is the bit-packed counterpart of ImageView: pixels within the same row are
+// stored continuously (without any padding bits), and rows may have gaps between them.
+// Since a row doesn't have to start at a byte boundary, each row has its own bit offset
+// (see rowBitOffset()).
+//
+// \param PixelFormat - specifies how colors are stored in the bitmap. PixelFormat should satisfy
+//        IsBitPackedPixelFormat trait, i.e. be like
+//          class MyPixelFormat {
+//           public:
+//            using color_type = MyColor;
+//            static constexpr int kBitsPerPixel = N;  // 1, 2 or 4.
+//            color_type read(unsigned char code) const;
+//            unsigned char write(const color_type& color) const;
+//          };
+// \param Mutable - if true, BitImageView provides write access to the bitmap.
+template <class PixelFormat, bool Mutable = false>
+class BitImageView {
+ public:
+  static_assert(IsBitPackedPixelFormat<PixelFormat>::value, "Not a bit-packed PixelFormat.");
+
+  using byte_type = std::conditional_t<Mutable, std::byte, const std::byte>;
+  using value_type = typename PixelFormat::color_type;
+  // If `Mutable == false`, then `reference` is an alias to `value_type`.
+  // Otherwise, it is a proxy class, which mimics `value_type&`.
+  using reference = std::conditional_t<Mutable, detail::BitPixelRef<PixelFormat>, value_type>;
+
+  // Construct an empty view.
+  template <class Enable = std::enable_if_t<std::is_default_constructible_v<PixelFormat>>>
+  constexpr BitImageView() noexcept(noexcept(std::is_nothrow_default_constructible_v<PixelFormat>)) {}
+
+  // Construct a view into an image.
+  // This constructor is only available if PixelFormat is default-constructible.
+  // \param height - height of the image.
+  // \param width - width of the image.
+  // \param stride - distance (in pixels) between the first pixels of consecutive rows.
+  // \param bit_offset - offset (in bits) of the pixel (0, 0) within the first byte of @data.
+  //        Should be within [0; 8) and be a multiple of PixelFormat::kBitsPerPixel.
+  // \param data - bitmap data. The size of the array should be exactly
+  //          ceil((bit_offset + ((height - 1) * stride + width) * PixelFormat::kBitsPerPixel) / 8)
+  //        bytes, or 0 if height is 0.
+  template <class Enable = std::enable_if_t<std::is_default_constructible_v<PixelFormat>>>
+  constexpr BitImageView(unsigned int height, unsigned int width, unsigned int stride, unsigned int bit_offset,
+                         std::span<byte_type> data);
+
+  // Construct a view into an image.
+  // \param height - height of the image.
+  // \param width - width of the image.
+  // \param stride - distance (in pixels) between the first pixels of consecutive rows.
+  // \param bit_offset - offset (in bits) of the pixel (0, 0) within the first byte of @data.
+  // \param data - bitmap data.
+  // \param pixel_format - PixelFormat instance to use.
+  constexpr BitImageView(unsigned int height, unsigned int width, unsigned int stride, unsigned int bit_offset,
+                         std::span<byte_type> data, const PixelFormat& pixel_format);
+  constexpr BitImageView(unsigned int height, unsigned int width, unsigned int stride, unsigned int bit_offset,
+                         std::span<byte_type> data, PixelFormat&& pixel_format);
+
+  // Construct a read-only view from a mutable view.
+  template <class Enable = std::enable_if_t<!Mutable>>
+  constexpr BitImageView(BitImageView<PixelFormat, !Mutable> other);
+
+  // Returns the height of the image.
+  constexpr unsigned int height() const noexcept;
+
+  // Returns the width of the image.
+  constexpr unsigned int width() const noexcept;
+
+  // Returns the distance (in pixels) between the first pixels of consecutive rows.
+  constexpr unsigned int stride() const noexcept;
+
+  // Returns the offset (in bits) of the pixel (0, 0) within the first byte of data().
+  constexpr unsigned int bitOffset() const noexcept;
+
+  // Returns the total number of pixels.
+  constexpr std::size_t area() const noexcept;
+
+  // Returns true if the image has zero area, false otherwise.
+  constexpr bool empty() const noexcept;
+
+  // Returns the pixel format used by this image.
+  constexpr const PixelFormat& pixelFormat() const noexcept;
+
+  // Returns the bitmap data.
+  constexpr std::span<byte_type> data() const noexcept;
+
+  // Returns the offset (in bits from the beginning of data()) of the first pixel in the specified row.
+  // \param y - 0-based index of the row. No bounds checking is performed.
+  constexpr std::size_t rowBitOffset(unsigned int y) const noexcept;
+
+  // Access the specified pixel.
+  // \param y - Y coordinate of the pixel. Should be within [0; height()).
+  // \param x - X coordinate of the pixel. Should be within [0; width()).
+  // \return the color of the specified pixel.
+  constexpr reference operator()(unsigned int y, unsigned int x) const;
+
+ private:
+  static constexpr std::size_t getDataSize(unsigned int height, unsigned int width, unsigned int stride,
+                                           unsigned int bit_offset) noexcept;
+
+  constexpr void validate(std::size_t data_size) const;
+
+  detail::ImageViewStorage<PixelFormat, Mutable> storage_;
+  unsigned int height_ = 0;
+  unsigned int width_ = 0;
+  unsigned int stride_ = 0;
+  unsigned int bit_offset_ = 0;
+};
+
+template <class PixelFormat, bool Mutable>
+template <class Enable>
+constexpr BitImageView<PixelFormat, Mutable>::BitImageView(unsigned int height, unsigned int width,
+                                                           unsigned int stride, unsigned int bit_offset,
+                                                           std::span<byte_type> data)
+    : storage_(data.data()), height_(height), width_(width), stride_(stride), bit_offset_(bit_offset) {
+  validate(data.size());
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr BitImageView<PixelFormat, Mutable>::BitImageView(unsigned int height, unsigned int width,
+                                                           unsigned int stride, unsigned int bit_offset,
+                                                           std::span<byte_type> data, const PixelFormat& pixel_format)
+    : storage_(data.data(), pixel_format), height_(height), width_(width), stride_(stride), bit_offset_(bit_offset) {
+  validate(data.size());
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr BitImageView<PixelFormat, Mutable>::BitImageView(unsigned int height, unsigned int width,
+                                                           unsigned int stride, unsigned int bit_offset,
+                                                           std::span<byte_type> data, PixelFormat&& pixel_format)
+    : storage_(data.data(), std::move(pixel_format)),
+      height_(height),
+      width_(width),
+      stride_(stride),
+      bit_offset_(bit_offset) {
+  validate(data.size());
+}
+
+template <class PixelFormat, bool Mutable>
+template <class Enable>
+constexpr BitImageView<PixelFormat, Mutable>::BitImageView(BitImageView<PixelFormat, !Mutable> other)
+    : BitImageView(other.height(), other.width(), other.stride(), other.bitOffset(), other.data(),
+                   other.pixelFormat()) {}
+
+template <class PixelFormat, bool Mutable>
+constexpr std::size_t BitImageView<PixelFormat, Mutable>::getDataSize(unsigned int height, unsigned int width,
+                                                                      unsigned int stride,
+                                                                      unsigned int bit_offset) noexcept {
+  if (height == 0) {
+    return 0;
+  }
+  const std::size_t num_bits =
+      bit_offset + ((static_cast<std::size_t>(height) - 1) * stride + width) * PixelFormat::kBitsPerPixel;
+  return (num_bits + 7) / 8;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr void BitImageView<PixelFormat, Mutable>::validate(std::size_t data_size) const {
+  if (stride_ < width_)
+  {
+    throw std::invalid_argument("BitImageView(): stride cannot be less than width.");
+  }
+  if (bit_offset_ >= 8 || bit_offset_ % PixelFormat::kBitsPerPixel != 0)
+  {
+    throw std::invalid_argument("BitImageView(): bit_offset must be a multiple of kBitsPerPixel within [0; 8).");
+  }
+  if (data_size != getDataSize(height_, width_, stride_, bit_offset_))
+  {
+    throw std::invalid_argument("BitImageView(): wrong number of bytes in the input data.");
+  }
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr unsigned int BitImageView<PixelFormat, Mutable>::height() const noexcept {
+  return height_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr unsigned int BitImageView<PixelFormat, Mutable>::width() const noexcept {
+  return width_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr unsigned int BitImageView<PixelFormat, Mutable>::stride() const noexcept {
+  return stride_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr unsigned int BitImageView<PixelFormat, Mutable>::bitOffset() const noexcept {
+  return bit_offset_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr std::size_t BitImageView<PixelFormat, Mutable>::area() const noexcept {
+  return static_cast<std::size_t>(height_) * width_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr bool BitImageView<PixelFormat, Mutable>::empty() const noexcept {
+  return height_ == 0 || width_ == 0;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr const PixelFormat& BitImageView<PixelFormat, Mutable>::pixelFormat() const noexcept {
+  return storage_.pixelFormat();
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto BitImageView<PixelFormat, Mutable>::data() const noexcept -> std::span<byte_type> {
+  return std::span<byte_type>(storage_.data(), getDataSize(height_, width_, stride_, bit_offset_));
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr std::size_t BitImageView<PixelFormat, Mutable>::rowBitOffset(unsigned int y) const noexcept {
+  return bit_offset_ + static_cast<std::size_t>(y) * stride_ * PixelFormat::kBitsPerPixel;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto BitImageView<PixelFormat, Mutable>::operator()(unsigned int y, unsigned int x) const -> reference {
+  if (y >= height_)
+  {
+    throw std::out_of_range("BitImageView::operator(): y is out of range.");
+  }
+  if (x >= width_)
+  {
+    throw std::out_of_range("BitImageView::operator(): x is out of range.");
+  }
+  const std::size_t bit_position = rowBitOffset(y) + static_cast<std::size_t>(x) * PixelFormat::kBitsPerPixel;
+  byte_type* pixel_byte = storage_.data() + bit_position / 8;
+  // Pixels are packed starting from the most significant bit.
+  const unsigned int shift = 8 - PixelFormat::kBitsPerPixel - static_cast<unsigned int>(bit_position % 8);
+  if constexpr (Mutable) {
+    return detail::BitPixelRef<PixelFormat>(pixel_byte, shift, pixelFormat());
+  } else {
+    constexpr unsigned int kCodeMask = (1u << PixelFormat::kBitsPerPixel) - 1;
+    const unsigned int code = (static_cast<unsigned int>(*pixel_byte) >> shift) & kCodeMask;
+    return pixelFormat().read(static_cast<unsigned char>(code));
+  }
+}
+
+}  // namespace imageview
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <imageview/BitImageView.h>
+#include <imageview/ImageView.h>
+#include <imageview/internal/BitPacking.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace imageview {
+namespace detail {
+
+// Applies @op to the bits of @lhs and @rhs and writes the result into @dst.
+// @op is invoked either for 64-bit words or for single bytes; only the bits that belong
+// to the images are written into @dst.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable, class BinaryOperation>
+void transformBits(BitImageView<PixelFormat, LhsMutable> lhs, BitImageView<PixelFormat, RhsMutable> rhs,
+                   BitImageView<PixelFormat, true> dst, BinaryOperation op) {
+  if (lhs.height() != dst.height() || lhs.width() != dst.width() || rhs.height() != dst.height() ||
+      rhs.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::transformBits(): images must have the same dimensions.");
+  }
+  const std::size_t bits_per_row = static_cast<std::size_t>(dst.width()) * PixelFormat::kBitsPerPixel;
+  if (bits_per_row == 0) {
+    return;
+  }
+  const std::byte* lhs_data = lhs.data().data();
+  const std::byte* rhs_data = rhs.data().data();
+  std::byte* dst_data = dst.data().data();
+  for (unsigned int y = 0; y < dst.height(); ++y) {
+    const std::size_t lhs_position = lhs.rowBitOffset(y);
+    const std::size_t rhs_position = rhs.rowBitOffset(y);
+    const std::size_t dst_position = dst.rowBitOffset(y);
+    const unsigned int phase = static_cast<unsigned int>(dst_position % 8);
+    if (lhs_position % 8 != phase || rhs_position % 8 != phase) {
+      // Rows are not equally aligned: funnel-shift 64 bits at a time.
+      for (std::size_t offset = 0; offset < bits_per_row; offset += 64) {
+        const unsigned int num_bits = static_cast<unsigned int>(bits_per_row - offset < 64 ? bits_per_row - offset : 64);
+        const std::uint64_t bits =
+            op(loadBits(lhs_data, lhs_position + offset, num_bits), loadBits(rhs_data, rhs_position + offset, num_bits));
+        storeBits(dst_data, dst_position + offset, num_bits, bits);
+      }
+      continue;
+    }
+    // All rows have the same alignment within a byte: bitwise operations can be applied to raw bytes.
+    const std::byte* lhs_byte = lhs_data + lhs_position / 8;
+    const std::byte* rhs_byte = rhs_data + rhs_position / 8;
+    std::byte* dst_byte = dst_data + dst_position / 8;
+    std::size_t remaining = bits_per_row;
+    if (phase != 0) {
+      const unsigned int count = remaining < 8 - phase ? static_cast<unsigned int>(remaining) : 8 - phase;
+      const unsigned int mask = (0xFFu >> phase) & ~(0xFFu >> (phase + count));
+      const unsigned int value = static_cast<unsigned int>(
+          op(static_cast<std::uint64_t>(*lhs_byte++), static_cast<std::uint64_t>(*rhs_byte++)));
+      *dst_byte = static_cast<std::byte>((static_cast<unsigned int>(*dst_byte) & ~mask) | (value & mask));
+      ++dst_byte;
+      remaining -= count;
+    }
+    for (; remaining >= 64; remaining -= 64, lhs_byte += 8, rhs_byte += 8, dst_byte += 8) {
+      std::uint64_t lhs_word;
+      std::uint64_t rhs_word;
+      std::memcpy(&lhs_word, lhs_byte, 8);
+      std::memcpy(&rhs_word, rhs_byte, 8);
+      const std::uint64_t dst_word = op(lhs_word, rhs_word);
+      std::memcpy(dst_byte, &dst_word, 8);
+    }
+    for (; remaining >= 8; remaining -= 8) {
+      *dst_byte++ = static_cast<std::byte>(
+          op(static_cast<std::uint64_t>(*lhs_byte++), static_cast<std::uint64_t>(*rhs_byte++)));
+    }
+    if (remaining != 0) {
+      const unsigned int mask = ~(0xFFu >> remaining) & 0xFFu;
+      const unsigned int value =
+          static_cast<unsigned int>(op(static_cast<std::uint64_t>(*lhs_byte), static_cast<std::uint64_t>(*rhs_byte)));
+      *dst_byte = static_cast<std::byte>((static_cast<unsigned int>(*dst_byte) & ~mask) | (value & mask));
+    }
+  }
+}
+
+// Returns a lookup table that maps each byte of a bit-packed bitmap to 8 / kBitsPerPixel
+// Grayscale8 intensities. Codes are mapped linearly onto [0; 255].
+template <unsigned int kBitsPerPixel>
+constexpr std::array<std::array<unsigned char, 8 / kBitsPerPixel>, 256> makeUnpackTable() {
+  constexpr unsigned int kPixelsPerByte = 8 / kBitsPerPixel;
+  constexpr unsigned int kMaxCode = (1u << kBitsPerPixel) - 1;
+  std::array<std::array<unsigned char, kPixelsPerByte>, 256> table{};
+  for (unsigned int byte = 0; byte < 256; ++byte) {
+    for (unsigned int i = 0; i < kPixelsPerByte; ++i) {
+      const unsigned int code = (byte >> (8 - kBitsPerPixel * (i + 1))) & kMaxCode;
+      table[byte][i] = static_cast<unsigned char>(code * (255 / kMaxCode));
+    }
+  }
+  return table;
+}
+
+}  // namespace detail
+
+// Returns a view into the specified rectangular area of the image.
+// \param image - input image.
+// \param first_row - index of the first row of the area.
+// \param first_column - index of the first column of the area.
+// \param num_rows - height of the area.
+// \param num_columns - width of the area.
+// \throw std::invalid_argument if the area is not within the image.
+template <class PixelFormat, bool Mutable>
+constexpr BitImageView<PixelFormat, Mutable> crop(BitImageView<PixelFormat, Mutable> image, unsigned int first_row,
+                                                  unsigned int first_column, unsigned int num_rows,
+                                                  unsigned int num_columns) {
+  if (first_row + num_rows > image.height())
+  {
+    throw std::invalid_argument("imageview::crop(): first_row + num_rows "
+                                "must be less than or equal to image.height().");
+  }
+  if (first_column + num_columns > image.width())
+  {
+    throw std::invalid_argument("imageview::crop(): first_column + num_columns "
+                                "must be less than or equal to image.width().");
+  }
+  if (num_rows == 0) {
+    return BitImageView<PixelFormat, Mutable>(0, num_columns, image.stride(), 0, image.data().subspan(0, 0),
+                                              image.pixelFormat());
+  }
+  const std::size_t first_bit =
+      image.rowBitOffset(first_row) + static_cast<std::size_t>(first_column) * PixelFormat::kBitsPerPixel;
+  const unsigned int bit_offset = static_cast<unsigned int>(first_bit % 8);
+  const std::size_t num_bits =
+      bit_offset + ((static_cast<std::size_t>(num_rows) - 1) * image.stride() + num_columns) * PixelFormat::kBitsPerPixel;
+  const auto data_new = image.data().subspan(first_bit / 8, (num_bits + 7) / 8);
+  return BitImageView<PixelFormat, Mutable>(num_rows, num_columns, image.stride(), bit_offset, data_new,
+                                            image.pixelFormat());
+}
+
+// Computes the bitwise AND of two bit-packed images.
+// \param lhs, rhs - input images.
+// \param dst - output image. May be the same as @lhs or @rhs.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+void bitwiseAnd(BitImageView<PixelFormat, LhsMutable> lhs, BitImageView<PixelFormat, RhsMutable> rhs,
+                BitImageView<PixelFormat, true> dst) {
+  detail::transformBits(lhs, rhs, dst, [](std::uint64_t a, std::uint64_t b) { return a & b; });
+}
+
+// Computes the bitwise OR of two bit-packed images.
+// \param lhs, rhs - input images.
+// \param dst - output image. May be the same as @lhs or @rhs.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+void bitwiseOr(BitImageView<PixelFormat, LhsMutable> lhs, BitImageView<PixelFormat, RhsMutable> rhs,
+               BitImageView<PixelFormat, true> dst) {
+  detail::transformBits(lhs, rhs, dst, [](std::uint64_t a, std::uint64_t b) { return a | b; });
+}
+
+// Computes the bitwise XOR of two bit-packed images.
+// \param lhs, rhs - input images.
+// \param dst - output image. May be the same as @lhs or @rhs.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+void bitwiseXor(BitImageView<PixelFormat, LhsMutable> lhs, BitImageView<PixelFormat, RhsMutable> rhs,
+                BitImageView<PixelFormat, true> dst) {
+  detail::transformBits(lhs, rhs, dst, [](std::uint64_t a, std::uint64_t b) { return a ^ b; });
+}
+
+// Computes the bitwise NOT of a bit-packed image.
+// \param image - input image.
+// \param dst - output image. May be the same as @image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool Mutable>
+void bitwiseNot(BitImageView<PixelFormat, Mutable> image, BitImageView<PixelFormat, true> dst) {
+  detail::transformBits(image, image, dst, [](std::uint64_t a, std::uint64_t) { return ~a; });
+}
+
+// Counts pixels whose code is not 0 (for PixelFormatMask1 this is the area of the mask).
+// \param image - input image.
+// \return the number of pixels in @image whose bits are not all zeros.
+template <class PixelFormat, bool Mutable>
+std::size_t countNonZero(BitImageView<PixelFormat, Mutable> image) {
+  constexpr unsigned int kBitsPerPixel = PixelFormat::kBitsPerPixel;
+  const std::size_t bits_per_row = static_cast<std::size_t>(image.width()) * kBitsPerPixel;
+  if (bits_per_row == 0) {
+    return 0;
+  }
+  const std::byte* data = image.data().data();
+  std::size_t result = 0;
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    const std::size_t position = image.rowBitOffset(y);
+    const unsigned int phase = static_cast<unsigned int>(position % 8);
+    std::size_t remaining = bits_per_row;
+    const std::byte* byte = data + position / 8;
+    if (phase != 0) {
+      const unsigned int count = remaining < 8 - phase ? static_cast<unsigned int>(remaining) : 8 - phase;
+      const unsigned int mask = (0xFFu >> phase) & ~(0xFFu >> (phase + count));
+      result += detail::countNonZeroCodes<kBitsPerPixel>(static_cast<unsigned int>(*byte++) & mask);
+      remaining -= count;
+    }
+    for (; remaining >= 64; remaining -= 64, byte += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, byte, 8);
+      result += detail::countNonZeroCodes<kBitsPerPixel>(word);
+    }
+    for (; remaining >= 8; remaining -= 8) {
+      result += detail::countNonZeroCodes<kBitsPerPixel>(static_cast<unsigned int>(*byte++));
+    }
+    if (remaining != 0) {
+      const unsigned int mask = ~(0xFFu >> remaining) & 0xFFu;
+      result += detail::countNonZeroCodes<kBitsPerPixel>(static_cast<unsigned int>(*byte) & mask);
+    }
+  }
+  return result;
+}
+
+// Converts a bit-packed image into Grayscale8. Codes are mapped linearly onto [0; 255], e.g.
+// PixelFormatMask1 pixels become 0 or 255, PixelFormatGrayscale4 pixels are multiplied by 17.
+// \param image - input image.
+// \param dst - output image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool Mutable>
+void convert(BitImageView<PixelFormat, Mutable> image, ImageView<PixelFormatGrayscale8, true> dst) {
+  constexpr unsigned int kBitsPerPixel = PixelFormat::kBitsPerPixel;
+  constexpr unsigned int kPixelsPerByte = 8 / kBitsPerPixel;
+  static constexpr auto kTable = detail::makeUnpackTable<kBitsPerPixel>();
+  if (image.height() != dst.height() || image.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::convert(): images must have the same dimensions.");
+  }
+  const std::byte* src_data = image.data().data();
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    unsigned char* dst_pixel =
+        reinterpret_cast<unsigned char*>(dst.data().data()) + static_cast<std::size_t>(y) * dst.stride();
+    std::size_t position = image.rowBitOffset(y);
+    unsigned int x = 0;
+    // Leading pixels in a partially covered byte.
+    for (; x < image.width() && position % 8 != 0; ++x, position += kBitsPerPixel) {
+      const unsigned int byte = static_cast<unsigned int>(src_data[position / 8]);
+      *dst_pixel++ = kTable[byte][(position % 8) / kBitsPerPixel];
+    }
+    // Whole bytes.
+    for (; image.width() - x >= kPixelsPerByte; x += kPixelsPerByte, position += 8) {
+      const unsigned int byte = static_cast<unsigned int>(src_data[position / 8]);
+      std::memcpy(dst_pixel, kTable[byte].data(), kPixelsPerByte);
+      dst_pixel += kPixelsPerByte;
+    }
+    // Trailing pixels.
+    for (unsigned int i = 0; x < image.width(); ++x, ++i) {
+      const unsigned int byte = static_cast<unsigned int>(src_data[position / 8]);
+      *dst_pixel++ = kTable[byte][i];
+    }
+  }
+}
+
+// Converts a Grayscale8 image into a bit-packed pixel format. Intensities are mapped linearly
+// onto the codes of the format with rounding to the nearest code, e.g. PixelFormatMask1 pixels are
+// set for intensities >= 128.
+// \param image - input image.
+// \param dst - output image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat>
+void convert(ImageView<PixelFormatGrayscale8> image, BitImageView<PixelFormat, true> dst) {
+  constexpr unsigned int kBitsPerPixel = PixelFormat::kBitsPerPixel;
+  constexpr unsigned int kPixelsPerByte = 8 / kBitsPerPixel;
+  constexpr unsigned int kMaxCode = (1u << kBitsPerPixel) - 1;
+  if (image.height() != dst.height() || image.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::convert(): images must have the same dimensions.");
+  }
+  const auto to_code = [](unsigned char intensity) { return (intensity * kMaxCode + 127) / 255; };
+  std::byte* dst_data = dst.data().data();
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    const unsigned char* src_pixel =
+        reinterpret_cast<const unsigned char*>(image.data().data()) + static_cast<std::size_t>(y) * image.stride();
+    std::size_t position = dst.rowBitOffset(y);
+    unsigned int x = 0;
+    for (; x < image.width() && position % 8 != 0; ++x, position += kBitsPerPixel) {
+      detail::storeBits(dst_data, position, kBitsPerPixel, to_code(*src_pixel++));
+    }
+    for (; image.width() - x >= kPixelsPerByte; x += kPixelsPerByte, position += 8) {
+      unsigned int byte = 0;
+      for (unsigned int i = 0; i < kPixelsPerByte; ++i) {
+        byte = (byte << kBitsPerPixel) | to_code(src_pixel[i]);
+      }
+      src_pixel += kPixelsPerByte;
+      dst_data[position / 8] = static_cast<std::byte>(byte);
+    }
+    for (; x < image.width(); ++x, position += kBitsPerPixel) {
+      detail::storeBits(dst_data, position, kBitsPerPixel, to_code(*src_pixel++));
+    }
+  }
+}
+
+}  // namespace imageview
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <imageview/ImageRowView.h>
+#include <imageview/ImageView.h>
+#include <imageview/internal/ByteOrder.h>
+#include <imageview/internal/MappedFile.h>
+#include <imageview/pixel_formats/PixelFormatBGR24.h>
+#include <imageview/pixel_formats/PixelFormatBGRA32.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Reading and writing of uncompressed 24-bit and 32-bit BMP images.
+//
+// The pixel array of a BMP file stores rows bottom-up (unless the height in the header is negative), every row is
+// padded to a multiple of 4 bytes, and the channels are stored in BGR(A) order. BmpImage maps the file into memory
+// and exposes the pixel array in place, without copying or reordering anything:
+// * row(y) returns the row y (counting from the top of the image) as an ImageRowView<PixelFormatBGR24> (24-bit
+//   images) or ImageRowView<PixelFormatBGRA32> (32-bit images; the alpha channel is only meaningful if
+//   info().has_alpha is true);
+// * storageOrderView() returns the whole pixel array as an ImageView in the order the rows are stored. ImageView
+//   cannot represent reversed rows, so the view of a bottom-up image is upside down; this is fine for algorithms
+//   that don't depend on the order of rows (histograms, comparisons, per-pixel conversions, ...). ImageView also
+//   measures the stride in pixels, so the view is only available if the padded row size is a multiple of the pixel
+//   size (always the case for 32-bit images; for 24-bit images the width must be 0 or 3 modulo 4).
+//
+// writeBmp() streams any RGB24/BGR24/Grayscale8 (as 24-bit) or RGBA32/BGRA32 (as 32-bit) view into a bottom-up BMP
+// file, one padded row at a time.
+
+namespace imageview {
+
+struct BmpInfo {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  // 24 or 32.
+  unsigned int bits_per_pixel = 0;
+  // True if the first row in the pixel array is the bottom row of the image.
+  bool bottom_up = true;
+  // The offset of the pixel array from the beginning of the file.
+  std::size_t pixel_data_offset = 0;
+  // The number of bytes between the beginnings of 2 consecutive rows in the pixel array.
+  std::size_t row_pitch = 0;
+  // True if the 4th byte of every pixel of a 32-bit image is the alpha channel, i.e. the header declares the alpha
+  // mask 0xFF000000. Otherwise (e.g., in BI_RGB images) the byte is reserved, and is usually 0.
+  bool has_alpha = false;
+};
+
+// Parses the headers of a BMP image.
+// \param data - the contents of the file.
+// \throw std::runtime_error if @data is not a valid uncompressed 24-bit or 32-bit BMP image.
+BmpInfo parseBmpHeader(std::span<const std::byte> data);
+
+// Read-only BMP image whose pixel array is accessed in place.
+// BmpImage is movable, but not copyable.
+class BmpImage {
+ public:
+  // Maps the file @path into memory.
+  // \throw std::runtime_error if the file cannot be mapped, or is not a valid uncompressed 24-bit or 32-bit BMP image.
+  explicit BmpImage(const std::filesystem::path& path);
+
+  // Constructs an image over the contents of a BMP file that is already in memory. No data is copied, so @data must
+  // outlive the object.
+  // \throw std::runtime_error if @data is not a valid uncompressed 24-bit or 32-bit BMP image.
+  explicit BmpImage(std::span<const std::byte> data);
+
+  BmpImage(const BmpImage&) = delete;
+  BmpImage(BmpImage&&) noexcept = default;
+  BmpImage& operator=(const BmpImage&) = delete;
+  BmpImage& operator=(BmpImage&&) noexcept = default;
+
+  const BmpInfo& info() const noexcept;
+
+  unsigned int height() const noexcept;
+
+  unsigned int width() const noexcept;
+
+  // Returns the row @y, counting from the top of the image.
+  // \param PixelFormat - PixelFormatBGR24 for 24-bit images, PixelFormatBGRA32 for 32-bit images, or any other pixel
+  //        format with the same number of bytes per pixel. For 32-bit images the alpha channel of the returned pixels
+  //        is only meaningful if info().has_alpha is true; otherwise it is the reserved byte of the file (usually 0),
+  //        and the pixels should be treated as opaque.
+  // \param y - 0-based index of the row; must be within [0; height()).
+  // \throw std::invalid_argument if PixelFormat doesn't match the bit depth of the image.
+  // \throw std::out_of_range if @y is outside [0; height()).
+  template <class PixelFormat>
+  ImageRowView<PixelFormat> row(unsigned int y) const;
+
+  // Returns the pixel array as an image in storage order, i.e. upside down if info().bottom_up is true.
+  // \param PixelFormat - same as for row().
+  // \return the view, or std::nullopt if the row pitch is not a multiple of PixelFormat::kBytesPerPixel.
+  // \throw std::invalid_argument if PixelFormat doesn't match the bit depth of the image.
+  template <class PixelFormat>
+  std::optional<ImageView<PixelFormat>> storageOrderView() const;
+
+ private:
+  template <class PixelFormat>
+  void checkPixelFormat() const;
+
+  detail::MappedFile file_;
+  BmpInfo info_;
+  const std::byte* pixel_data_ = nullptr;
+};
+
+// Writes an image as an uncompressed bottom-up BMP file.
+// Images with color type RGB24 (e.g., PixelFormatRGB24, PixelFormatBGR24) and PixelFormatGrayscale8 images are
+// written as 24-bit images; images with color type RGBA32 (e.g., PixelFormatRGBA32, PixelFormatBGRA32) are written as
+// 32-bit images with BITMAPV4HEADER, storing the alpha channel in the 4th byte of every pixel and declaring it via
+// the alpha mask (so that readers don't treat it as the reserved byte of BI_RGB images).
+// \param image - image to write; must not be empty.
+// \param stream - output stream.
+// \throw std::invalid_argument if the image is empty or too large for the BMP format.
+// \throw std::runtime_error if writing into @stream fails.
+template <class PixelFormat, bool Mutable>
+void writeBmp(ImageView<PixelFormat, Mutable> image, std::ostream& stream);
+
+namespace detail {
+
+constexpr std::size_t kBmpFileHeaderSize = 14;
+constexpr std::size_t kBmpInfoHeaderSize = 40;
+constexpr std::size_t kBmpInfoHeaderV4Size = 108;
+constexpr std::uint32_t kBmpCompressionRgb = 0;
+constexpr std::uint32_t kBmpCompressionBitfields = 3;
+
+constexpr std::size_t getBmpRowPitch(unsigned int width, unsigned int bits_per_pixel) noexcept {
+  return (static_cast<std::size_t>(width) * bits_per_pixel + 31) / 32 * 4;
+}
+
+inline std::uint32_t loadBmpUint32(std::span<const std::byte> data, std::size_t offset) noexcept {
+  return loadUint32<std::endian::little>(std::span<const std::byte, 4>(data.data() + offset, 4));
+}
+
+inline std::uint16_t loadBmpUint16(std::span<const std::byte> data, std::size_t offset) noexcept {
+  return loadUint16<std::endian::little>(std::span<const std::byte, 2>(data.data() + offset, 2));
+}
+
+inline void storeBmpUint32(std::uint32_t value, std::byte* data) noexcept {
+  storeUint32<std::endian::little>(value, std::span<std::byte, 4>(data, 4));
+}
+
+inline void storeBmpUint16(std::uint16_t value, std::byte* data) noexcept {
+  storeUint16<std::endian::little>(value, std::span<std::byte, 2>(data, 2));
+}
+
+}  // namespace detail
+
+inline BmpInfo parseBmpHeader(std::span<const std::byte> data) {
+  constexpr std::size_t kHeadersSize = detail::kBmpFileHeaderSize + detail::kBmpInfoHeaderSize;
+  if (data.size() < kHeadersSize || data[0] != std::byte{'B'} || data[1] != std::byte{'M'} ||
+      detail::loadBmpUint32(data, 14) < detail::kBmpInfoHeaderSize)
+  {
+    throw std::runtime_error("imageview::parseBmpHeader(): not a BMP image with BITMAPINFOHEADER or later.");
+  }
+  const auto width = static_cast<std::int32_t>(detail::loadBmpUint32(data, 18));
+  const auto height = static_cast<std::int32_t>(detail::loadBmpUint32(data, 22));
+  const std::uint16_t bits_per_pixel = detail::loadBmpUint16(data, 28);
+  const std::uint32_t compression = detail::loadBmpUint32(data, 30);
+  if (width <= 0 || height == 0 || height == std::numeric_limits<std::int32_t>::min())
+  {
+    throw std::runtime_error("imageview::parseBmpHeader(): invalid dimensions.");
+  }
+  if (bits_per_pixel != 24 && bits_per_pixel != 32)
+  {
+    throw std::runtime_error("imageview::parseBmpHeader(): only 24-bit and 32-bit images are supported.");
+  }
+  // 32-bit images may use bit fields, as long as they describe the BGRA layout. The masks directly follow
+  // BITMAPINFOHEADER; in later versions of the header they are its fields at the same offsets.
+  const bool is_bgra_bitfields = bits_per_pixel == 32 && compression == detail::kBmpCompressionBitfields &&
+                                 data.size() >= kHeadersSize + 12 && detail::loadBmpUint32(data, 54) == 0x00FF0000 &&
+                                 detail::loadBmpUint32(data, 58) == 0x0000FF00 &&
+                                 detail::loadBmpUint32(data, 62) == 0x000000FF;
+  if (compression != detail::kBmpCompressionRgb && !is_bgra_bitfields)
+  {
+    throw std::runtime_error("imageview::parseBmpHeader(): compressed images are not supported.");
+  }
+  BmpInfo info;
+  info.width = static_cast<unsigned int>(width);
+  info.height = static_cast<unsigned int>(height < 0 ? -height : height);
+  info.bits_per_pixel = bits_per_pixel;
+  info.bottom_up = height > 0;
+  info.pixel_data_offset = detail::loadBmpUint32(data, 10);
+  info.row_pitch = detail::getBmpRowPitch(info.width, bits_per_pixel);
+  // The alpha mask follows the color masks in BITMAPV3INFOHEADER and later versions of the header.
+  info.has_alpha = is_bgra_bitfields && detail::loadBmpUint32(data, 14) >= detail::kBmpInfoHeaderSize + 16 &&
+                   data.size() >= kHeadersSize + 16 && detail::loadBmpUint32(data, 66) == 0xFF000000;
+  if (info.pixel_data_offset > data.size() || (data.size() - info.pixel_data_offset) / info.row_pitch < info.height)
+  {
+    throw std::runtime_error("imageview::parseBmpHeader(): the pixel array is truncated.");
+  }
+  return info;
+}
+
+inline BmpImage::BmpImage(const std::filesystem::path& path) : file_(path) {
+  info_ = parseBmpHeader(file_.data());
+  pixel_data_ = file_.data().data() + info_.pixel_data_offset;
+}
+
+inline BmpImage::BmpImage(std::span<const std::byte> data)
+    : info_(parseBmpHeader(data)), pixel_data_(data.data() + info_.pixel_data_offset) {}
+
+inline const BmpInfo& BmpImage::info() const noexcept { return info_; }
+
+inline unsigned int BmpImage::height() const noexcept { return info_.height; }
+
+inline unsigned int BmpImage::width() const noexcept { return info_.width; }
+
+template <class PixelFormat>
+void BmpImage::checkPixelFormat() const {
+  if (PixelFormat::kBytesPerPixel * 8 != info_.bits_per_pixel)
+  {
+    throw std::invalid_argument("BmpImage: the pixel format doesn't match the bit depth of the image.");
+  }
+}
+
+template <class PixelFormat>
+ImageRowView<PixelFormat> BmpImage::row(unsigned int y) const {
+  checkPixelFormat<PixelFormat>();
+  if (y >= info_.height)
+  {
+    throw std::out_of_range("BmpImage::row(): y is out of range.");
+  }
+  const unsigned int storage_row = info_.bottom_up ? (info_.height - 1 - y) : y;
+  const std::byte* data = pixel_data_ + storage_row * info_.row_pitch;
+  return ImageRowView<PixelFormat>(std::span(data, static_cast<std::size_t>(info_.width) * PixelFormat::kBytesPerPixel),
+                                   info_.width);
+}
+
+template <class PixelFormat>
+std::optional<ImageView<PixelFormat>> BmpImage::storageOrderView() const {
+  checkPixelFormat<PixelFormat>();
+  if (info_.row_pitch % PixelFormat::kBytesPerPixel != 0) {
+    return std::nullopt;
+  }
+  const auto stride = static_cast<unsigned int>(info_.row_pitch / PixelFormat::kBytesPerPixel);
+  const std::size_t size =
+      ((info_.height - 1) * static_cast<std::size_t>(stride) + info_.width) * PixelFormat::kBytesPerPixel;
+  return ImageView<PixelFormat>(info_.height, info_.width, stride, std::span(pixel_data_, size));
+}
+
+template <class PixelFormat, bool Mutable>
+void writeBmp(ImageView<PixelFormat, Mutable> image, std::ostream& stream) {
+  using color_type = typename PixelFormat::color_type;
+  static_assert(std::is_same_v<color_type, RGB24> || std::is_same_v<color_type, RGBA32> ||
+                    std::is_same_v<PixelFormat, PixelFormatGrayscale8>,
+                "Only pixel formats with color type RGB24 or RGBA32, and PixelFormatGrayscale8 are supported.");
+  constexpr unsigned int kBitsPerPixel = std::is_same_v<color_type, RGBA32> ? 32 : 24;
+  // 32-bit images need BITMAPV4HEADER to declare the alpha mask.
+  constexpr std::size_t kInfoHeaderSize = (kBitsPerPixel == 32) ? detail::kBmpInfoHeaderV4Size
+                                                                : detail::kBmpInfoHeaderSize;
+  constexpr std::size_t kHeadersSize = detail::kBmpFileHeaderSize + kInfoHeaderSize;
+  const std::size_t row_pitch = detail::getBmpRowPitch(image.width(), kBitsPerPixel);
+  if (image.empty() || image.width() > static_cast<unsigned int>(std::numeric_limits<std::int32_t>::max()) ||
+      image.height() > static_cast<unsigned int>(std::numeric_limits<std::int32_t>::max()) ||
+      image.height() > (std::numeric_limits<std::uint32_t>::max() - kHeadersSize) / row_pitch)
+  {
+    throw std::invalid_argument("imageview::writeBmp(): the image is empty or too large.");
+  }
+  const auto pixel_data_size = static_cast<std::uint32_t>(row_pitch * image.height());
+  std::array<std::byte, kHeadersSize> headers{};
+  headers[0] = std::byte{'B'};
+  headers[1] = std::byte{'M'};
+  detail::storeBmpUint32(static_cast<std::uint32_t>(kHeadersSize) + pixel_data_size, headers.data() + 2);
+  detail::storeBmpUint32(static_cast<std::uint32_t>(kHeadersSize), headers.data() + 10);
+  detail::storeBmpUint32(static_cast<std::uint32_t>(kInfoHeaderSize), headers.data() + 14);
+  detail::storeBmpUint32(image.width(), headers.data() + 18);
+  detail::storeBmpUint32(image.height(), headers.data() + 22);
+  detail::storeBmpUint16(1, headers.data() + 26);
+  detail::storeBmpUint16(kBitsPerPixel, headers.data() + 28);
+  detail::storeBmpUint32(kBitsPerPixel == 32 ? detail::kBmpCompressionBitfields : detail::kBmpCompressionRgb,
+                         headers.data() + 30);
+  detail::storeBmpUint32(pixel_data_size, headers.data() + 34);
+  // 72 DPI.
+  detail::storeBmpUint32(2835, headers.data() + 38);
+  detail::storeBmpUint32(2835, headers.data() + 42);
+  if constexpr (kBitsPerPixel == 32) {
+    // Red, green, blue and alpha masks of BGRA pixels, and the sRGB color space ('sRGB').
+    detail::storeBmpUint32(0x00FF0000, headers.data() + 54);
+    detail::storeBmpUint32(0x0000FF00, headers.data() + 58);
+    detail::storeBmpUint32(0x000000FF, headers.data() + 62);
+    detail::storeBmpUint32(0xFF000000, headers.data() + 66);
+    detail::storeBmpUint32(0x73524742, headers.data() + 70);
+  }
+  stream.write(reinterpret_cast<const char*>(headers.data()), static_cast<std::streamsize>(headers.size()));
+
+  // The padding bytes stay 0.
+  std::vector<std::byte> row_buffer(row_pitch);
+  for (unsigned int y = image.height(); y-- > 0;) {
+    const auto row = image.row(y);
+    if constexpr (std::is_same_v<PixelFormat, PixelFormatBGR24> || std::is_same_v<PixelFormat, PixelFormatBGRA32>) {
+      std::memcpy(row_buffer.data(), row.data().data(), row.size_bytes());
+    } else {
+      std::byte* dst = row_buffer.data();
+      for (const color_type color : row) {
+        if constexpr (std::is_same_v<PixelFormat, PixelFormatGrayscale8>) {
+          dst[0] = dst[1] = dst[2] = static_cast<std::byte>(color);
+          dst += 3;
+        } else {
+          dst[0] = static_cast<std::byte>(color.blue);
+          dst[1] = static_cast<std::byte>(color.green);
+          dst[2] = static_cast<std::byte>(color.red);
+          if constexpr (kBitsPerPixel == 32) {
+            dst[3] = static_cast<std::byte>(color.alpha);
+          }
+          dst += kBitsPerPixel / 8;
+        }
+      }
+    }
+    stream.write(reinterpret_cast<const char*>(row_buffer.data()), static_cast<std::streamsize>(row_pitch));
+  }
+  if (!stream)
+  {
+    throw std::runtime_error("imageview::writeBmp(): failed to write into the stream.");
+  }
+}
+
+}  // namespace imageview
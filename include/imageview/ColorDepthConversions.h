@@ -0,0 +1,156 @@
+#pragma once
+
+#include <imageview/CpuDispatch.h>
+#include <imageview/ImageView.h>
+#include <imageview/internal/ByteOrder.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale16.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatGrayscaleF32.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGB48.h>
+#include <imageview/pixel_formats/PixelFormatRGBF32.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Conversions between 8-bit pixel formats and the corresponding 16-bit / floating-point formats.
+//
+// All conversions operate on channels rather than pixels: e.g., RGB24 -> RGB48 is the same
+// kernel as Grayscale8 -> Grayscale16, applied to 3 times as many values. The kernels are simple
+// loops over contiguous arrays without branches or cross-iteration dependencies, so that the
+// compiler can vectorize them. If neither image has gaps between rows, the whole image is
+// converted with a single kernel invocation. The copy of each kernel is selected at runtime by
+// the instruction set of the host CPU (see CpuDispatch.h).
+//
+// Conventions:
+// * 8 -> 16 bits: v * 257, i.e. [0; 255] maps exactly onto [0; 65535].
+// * 16 -> 8 bits: round(v * 255 / 65535).
+// * 8 bits -> float: v / 255.
+// * float -> 8 bits: round(v * 255), saturated to [0; 255]; NaN maps to 0.
+
+namespace imageview {
+namespace detail {
+
+template <std::endian ByteOrder>
+IMAGEVIEW_DISPATCHED_KERNEL void widenChannels8To16(const std::byte* src, std::byte* dst,
+                                                    std::size_t num_channels) {
+  // v * 257 == (v << 8) | v, so both bytes of the result are equal to the input byte regardless of ByteOrder.
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    dst[2 * i] = src[i];
+    dst[2 * i + 1] = src[i];
+  }
+}
+
+template <std::endian ByteOrder>
+IMAGEVIEW_DISPATCHED_KERNEL void narrowChannels16To8(const std::byte* src, std::byte* dst,
+                                                     std::size_t num_channels) {
+  constexpr std::size_t kLow = (ByteOrder == std::endian::little) ? 0 : 1;
+  constexpr std::size_t kHigh = 1 - kLow;
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    const std::uint32_t value =
+        static_cast<std::uint32_t>(src[2 * i + kLow]) | (static_cast<std::uint32_t>(src[2 * i + kHigh]) << 8);
+    dst[i] = static_cast<std::byte>((value * 255 + 32767) / 65535);
+  }
+}
+
+template <std::endian ByteOrder>
+IMAGEVIEW_DISPATCHED_KERNEL void widenChannels8ToF32(const std::byte* src, std::byte* dst,
+                                                     std::size_t num_channels) {
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    storeFloat<ByteOrder>(static_cast<float>(static_cast<unsigned char>(src[i])) / 255.0f, dst + 4 * i);
+  }
+}
+
+template <std::endian ByteOrder>
+IMAGEVIEW_DISPATCHED_KERNEL void narrowChannelsF32To8(const std::byte* src, std::byte* dst,
+                                                      std::size_t num_channels) {
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    const float value = loadClampedUnitFloat<ByteOrder>(src + 4 * i);
+    dst[i] = static_cast<std::byte>(static_cast<int>(value * 255.0f + 0.5f));
+  }
+}
+
+// Invokes @kernel for each pair of corresponding rows in @src and @dst (or once for the whole image if both
+// images are continuous).
+// \param kernel - function with the signature equivalent to
+//          void kernel(const std::byte* src, std::byte* dst, std::size_t num_channels);
+// \param error_message - message of the exception thrown if the images have different dimensions.
+template <class SrcFormat, bool SrcMutable, class DstFormat, class Kernel>
+void convertChannels(ImageView<SrcFormat, SrcMutable> src, ImageView<DstFormat, true> dst,
+                     std::size_t channels_per_pixel, Kernel kernel,
+                     const char* error_message = "imageview::convert(): images must have the same dimensions.") {
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument(error_message);
+  }
+  if (src.empty()) {
+    return;
+  }
+  const std::byte* src_data = src.data().data();
+  std::byte* dst_data = dst.data().data();
+  if (src.stride() == src.width() && dst.stride() == dst.width()) {
+    kernel(src_data, dst_data, src.area() * channels_per_pixel);
+    return;
+  }
+  const std::size_t src_row_size = static_cast<std::size_t>(src.stride()) * SrcFormat::kBytesPerPixel;
+  const std::size_t dst_row_size = static_cast<std::size_t>(dst.stride()) * DstFormat::kBytesPerPixel;
+  for (unsigned int y = 0; y < src.height(); ++y) {
+    kernel(src_data + y * src_row_size, dst_data + y * dst_row_size, src.width() * channels_per_pixel);
+  }
+}
+
+}  // namespace detail
+
+// Converts a Grayscale8 image into Grayscale16.
+template <std::endian ByteOrder>
+void convert(ImageView<PixelFormatGrayscale8> src, ImageView<BasicPixelFormatGrayscale16<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::selectKernel<detail::widenChannels8To16<ByteOrder>>());
+}
+
+// Converts a Grayscale16 image into Grayscale8.
+template <std::endian ByteOrder, bool Mutable>
+void convert(ImageView<BasicPixelFormatGrayscale16<ByteOrder>, Mutable> src,
+             ImageView<PixelFormatGrayscale8, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::selectKernel<detail::narrowChannels16To8<ByteOrder>>());
+}
+
+// Converts an RGB24 image into RGB48.
+template <std::endian ByteOrder>
+void convert(ImageView<PixelFormatRGB24> src, ImageView<BasicPixelFormatRGB48<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::selectKernel<detail::widenChannels8To16<ByteOrder>>());
+}
+
+// Converts an RGB48 image into RGB24.
+template <std::endian ByteOrder, bool Mutable>
+void convert(ImageView<BasicPixelFormatRGB48<ByteOrder>, Mutable> src, ImageView<PixelFormatRGB24, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::selectKernel<detail::narrowChannels16To8<ByteOrder>>());
+}
+
+// Converts a Grayscale8 image into GrayscaleF32.
+template <std::endian ByteOrder>
+void convert(ImageView<PixelFormatGrayscale8> src, ImageView<BasicPixelFormatGrayscaleF32<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::selectKernel<detail::widenChannels8ToF32<ByteOrder>>());
+}
+
+// Converts a GrayscaleF32 image into Grayscale8.
+template <std::endian ByteOrder, bool Mutable>
+void convert(ImageView<BasicPixelFormatGrayscaleF32<ByteOrder>, Mutable> src,
+             ImageView<PixelFormatGrayscale8, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::selectKernel<detail::narrowChannelsF32To8<ByteOrder>>());
+}
+
+// Converts an RGB24 image into RGBF32.
+template <std::endian ByteOrder>
+void convert(ImageView<PixelFormatRGB24> src, ImageView<BasicPixelFormatRGBF32<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::selectKernel<detail::widenChannels8ToF32<ByteOrder>>());
+}
+
+// Converts an RGBF32 image into RGB24.
+template <std::endian ByteOrder, bool Mutable>
+void convert(ImageView<BasicPixelFormatRGBF32<ByteOrder>, Mutable> src, ImageView<PixelFormatRGB24, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::selectKernel<detail::narrowChannelsF32To8<ByteOrder>>());
+}
+
+}  // namespace imageview
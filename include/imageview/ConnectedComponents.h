@@ -0,0 +1,346 @@
+#pragma once
+
+#include <imageview/BitImageView.h>
+#include <imageview/ImageView.h>
+#include <imageview/internal/BitPacking.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/internal/ParallelFor.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatLabel32.h>
+#include <imageview/pixel_formats/PixelFormatMask1.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Connected-component labeling of binary masks.
+//
+// The labeling is run-based: each row of the mask is split into runs of foreground pixels, and runs of adjacent
+// rows are merged with union-find. Rows are split into bands, which are scanned in parallel; after that the runs on
+// the borders between bands are merged on the calling thread, and the labels are written in parallel again.
+// Statistics of the components are accumulated from the runs, so computing them does not require another pass over
+// the pixels.
+
+namespace imageview {
+
+enum class Connectivity {
+  // Pixels are connected if they share an edge.
+  k4,
+  // Pixels are connected if they share an edge or a corner.
+  k8,
+};
+
+// Statistics of a single connected component.
+struct ComponentStats {
+  // The number of pixels in the component.
+  std::size_t area = 0;
+  // Bounding box of the component.
+  unsigned int first_row = 0;
+  unsigned int first_column = 0;
+  unsigned int num_rows = 0;
+  unsigned int num_columns = 0;
+  // The mean coordinates of the pixels of the component.
+  double centroid_y = 0.0;
+  double centroid_x = 0.0;
+};
+
+namespace detail {
+
+// Horizontal run of foreground pixels [first; last) in the row y.
+struct LabelRun {
+  unsigned int y;
+  unsigned int first;
+  unsigned int last;
+};
+
+// Runs of a band of rows.
+struct LabelBand {
+  std::vector<LabelRun> runs;
+  // row_begin[i] is the index of the first run in the row first_row + i; row_begin.back() == runs.size().
+  std::vector<std::size_t> row_begin;
+  // Union-find forest over @runs (band-local indices).
+  std::vector<std::uint32_t> parent;
+};
+
+inline std::uint32_t findRoot(std::vector<std::uint32_t>& parent, std::uint32_t index) noexcept {
+  while (parent[index] != index) {
+    parent[index] = parent[parent[index]];
+    index = parent[index];
+  }
+  return index;
+}
+
+// Merges the sets containing @lhs and @rhs. The root of the result is the smallest index.
+inline void uniteRoots(std::vector<std::uint32_t>& parent, std::uint32_t lhs, std::uint32_t rhs) noexcept {
+  lhs = findRoot(parent, lhs);
+  rhs = findRoot(parent, rhs);
+  if (lhs < rhs) {
+    parent[rhs] = lhs;
+  } else if (rhs < lhs) {
+    parent[lhs] = rhs;
+  }
+}
+
+// Merges the overlapping runs [prev_first; prev_last) and [cur_first; cur_last) of 2 adjacent rows.
+// \param offset - offset of the indices of the runs in @parent.
+inline void connectRows(const std::vector<LabelRun>& runs, std::size_t prev_first, std::size_t prev_last,
+                        std::size_t cur_first, std::size_t cur_last, Connectivity connectivity,
+                        std::vector<std::uint32_t>& parent, std::uint32_t offset) noexcept {
+  const unsigned int extra = (connectivity == Connectivity::k8) ? 1 : 0;
+  std::size_t i = prev_first;
+  std::size_t j = cur_first;
+  while (i < prev_last && j < cur_last) {
+    const LabelRun& prev = runs[i];
+    const LabelRun& cur = runs[j];
+    if (prev.first < cur.last + extra && cur.first < prev.last + extra) {
+      uniteRoots(parent, static_cast<std::uint32_t>(offset + i), static_cast<std::uint32_t>(offset + j));
+    }
+    if (prev.last <= cur.last) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+}
+
+// Appends the runs of foreground pixels of the row @y to @runs.
+template <bool Mutable>
+void extractRuns(ImageView<PixelFormatGrayscale8, Mutable> mask, unsigned int y, std::vector<LabelRun>& runs) {
+  const unsigned char* row = getRowData(ImageView<PixelFormatGrayscale8>(mask), y);
+  const unsigned int width = mask.width();
+  unsigned int x = 0;
+  while (true) {
+    while (x < width && row[x] == 0) {
+      ++x;
+    }
+    if (x == width) {
+      return;
+    }
+    const unsigned int first = x;
+    while (x < width && row[x] != 0) {
+      ++x;
+    }
+    runs.push_back(LabelRun{y, first, x});
+  }
+}
+
+// Same as above, but for bit-packed masks: the row is scanned 64 pixels at a time, and the runs within each word are
+// found by counting its leading zeros and ones (pixels are packed starting from the most significant bit).
+template <bool Mutable>
+void extractRuns(BitImageView<PixelFormatMask1, Mutable> mask, unsigned int y, std::vector<LabelRun>& runs) {
+  const unsigned int width = mask.width();
+  const std::byte* data = mask.data().data();
+  const std::size_t position = mask.rowBitOffset(y);
+  bool in_run = false;
+  unsigned int first = 0;
+  for (unsigned int x = 0; x < width; x += 64) {
+    const unsigned int num_bits = std::min(width - x, 64u);
+    // The pixel x is the most significant bit of the word.
+    std::uint64_t word = loadBits(data, position + x, num_bits) << (64 - num_bits);
+    unsigned int offset = 0;
+    while (true) {
+      const unsigned int count =
+          std::min(static_cast<unsigned int>(in_run ? std::countl_one(word) : std::countl_zero(word)),
+                   num_bits - offset);
+      offset += count;
+      if (offset == num_bits) {
+        break;
+      }
+      if (in_run) {
+        runs.push_back(LabelRun{y, first, x + offset});
+      } else {
+        first = x + offset;
+      }
+      in_run = !in_run;
+      word <<= count;
+    }
+  }
+  if (in_run) {
+    runs.push_back(LabelRun{y, first, width});
+  }
+}
+
+// Extracts the runs of the rows [first_row; last_row) and merges them within the band.
+template <class MaskView>
+void scanBand(const MaskView& mask, unsigned int first_row, unsigned int last_row, Connectivity connectivity,
+              LabelBand& band) {
+  band.row_begin.reserve(last_row - first_row + 1);
+  for (unsigned int y = first_row; y < last_row; ++y) {
+    band.row_begin.push_back(band.runs.size());
+    extractRuns(mask, y, band.runs);
+  }
+  band.row_begin.push_back(band.runs.size());
+  band.parent.resize(band.runs.size());
+  for (std::size_t i = 0; i < band.parent.size(); ++i) {
+    band.parent[i] = static_cast<std::uint32_t>(i);
+  }
+  for (std::size_t row = 1; row + 1 < band.row_begin.size(); ++row) {
+    connectRows(band.runs, band.row_begin[row - 1], band.row_begin[row], band.row_begin[row],
+                band.row_begin[row + 1], connectivity, band.parent, 0);
+  }
+}
+
+template <class MaskView>
+unsigned int labelComponentsImpl(const MaskView& mask, ImageView<PixelFormatLabel32, true> labels,
+                                 Connectivity connectivity, unsigned int num_threads,
+                                 std::vector<ComponentStats>* stats) {
+  if (mask.height() != labels.height() || mask.width() != labels.width())
+  {
+    throw std::invalid_argument("imageview::labelComponents(): mask and labels must have the same dimensions.");
+  }
+  if (mask.height() == 0 || mask.width() == 0) {
+    return 0;
+  }
+  const std::size_t num_bands = getNumBands(mask.height(), num_threads);
+  const auto band_begin = [&mask, num_bands](std::size_t band) {
+    return static_cast<unsigned int>(mask.height() * band / num_bands);
+  };
+  std::vector<LabelBand> bands(num_bands);
+  parallelFor(num_bands, num_threads, [&](std::size_t, std::size_t first, std::size_t last) {
+    for (std::size_t band = first; band < last; ++band) {
+      scanBand(mask, band_begin(band), band_begin(band + 1), connectivity, bands[band]);
+    }
+  });
+
+  // Combine the band-local forests into a single one and merge the runs across band borders.
+  std::vector<std::size_t> band_offset(num_bands + 1, 0);
+  for (std::size_t band = 0; band < num_bands; ++band) {
+    band_offset[band + 1] = band_offset[band] + bands[band].runs.size();
+  }
+  std::vector<std::uint32_t> parent(band_offset.back());
+  std::vector<LabelRun> runs(band_offset.back());
+  for (std::size_t band = 0; band < num_bands; ++band) {
+    const std::uint32_t offset = static_cast<std::uint32_t>(band_offset[band]);
+    std::transform(bands[band].parent.begin(), bands[band].parent.end(), parent.begin() + offset,
+                   [offset](std::uint32_t index) { return index + offset; });
+    std::copy(bands[band].runs.begin(), bands[band].runs.end(), runs.begin() + offset);
+  }
+  for (std::size_t band = 1; band < num_bands; ++band) {
+    const std::vector<std::size_t>& prev_rows = bands[band - 1].row_begin;
+    const std::vector<std::size_t>& cur_rows = bands[band].row_begin;
+    const std::size_t prev_offset = band_offset[band - 1];
+    const std::size_t cur_offset = band_offset[band];
+    connectRows(runs, prev_offset + prev_rows[prev_rows.size() - 2], prev_offset + prev_rows.back(),
+                cur_offset + cur_rows[0], cur_offset + cur_rows[1], connectivity, parent, 0);
+  }
+
+  // Roots are the first runs of their components in raster order, so labels are assigned in raster order too.
+  std::vector<std::uint32_t> run_labels(runs.size());
+  std::uint32_t num_labels = 0;
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    const std::uint32_t root = findRoot(parent, static_cast<std::uint32_t>(i));
+    run_labels[i] = (root == i) ? ++num_labels : run_labels[root];
+  }
+
+  parallelFor(num_bands, num_threads, [&](std::size_t, std::size_t first, std::size_t last) {
+    for (std::size_t band = first; band < last; ++band) {
+      const std::vector<std::size_t>& row_begin = bands[band].row_begin;
+      for (unsigned int y = band_begin(band); y < band_begin(band + 1); ++y) {
+        const ImageRowView<PixelFormatLabel32, true> row = labels.row(y);
+        std::fill(row.begin(), row.end(), 0u);
+        const std::size_t row_index = y - band_begin(band);
+        for (std::size_t i = band_offset[band] + row_begin[row_index];
+             i < band_offset[band] + row_begin[row_index + 1]; ++i) {
+          std::fill(row.begin() + runs[i].first, row.begin() + runs[i].last, run_labels[i]);
+        }
+      }
+    }
+  });
+
+  if (stats != nullptr) {
+    struct Accumulator {
+      std::size_t area = 0;
+      unsigned int min_y = 0;
+      unsigned int max_y = 0;
+      unsigned int min_x = 0;
+      unsigned int max_x = 0;
+      double sum_y = 0.0;
+      double sum_x = 0.0;
+    };
+    std::vector<Accumulator> accumulators(num_labels);
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+      const LabelRun& run = runs[i];
+      Accumulator& accumulator = accumulators[run_labels[i] - 1];
+      const std::size_t length = run.last - run.first;
+      if (accumulator.area == 0) {
+        accumulator.min_y = run.y;
+        accumulator.min_x = run.first;
+        accumulator.max_x = run.last;
+      }
+      accumulator.area += length;
+      accumulator.max_y = run.y + 1;
+      accumulator.min_x = std::min(accumulator.min_x, run.first);
+      accumulator.max_x = std::max(accumulator.max_x, run.last);
+      accumulator.sum_y += static_cast<double>(run.y) * length;
+      // The sum of first, first + 1, ..., last - 1.
+      accumulator.sum_x += (static_cast<double>(run.first) + run.last - 1) * length / 2;
+    }
+    stats->resize(num_labels);
+    for (std::size_t label = 0; label < num_labels; ++label) {
+      const Accumulator& accumulator = accumulators[label];
+      ComponentStats& result = (*stats)[label];
+      result.area = accumulator.area;
+      result.first_row = accumulator.min_y;
+      result.first_column = accumulator.min_x;
+      result.num_rows = accumulator.max_y - accumulator.min_y;
+      result.num_columns = accumulator.max_x - accumulator.min_x;
+      result.centroid_y = accumulator.sum_y / accumulator.area;
+      result.centroid_x = accumulator.sum_x / accumulator.area;
+    }
+  }
+  return num_labels;
+}
+
+}  // namespace detail
+
+// Labels the connected components of a binary mask.
+// \param mask - input mask. Nonzero pixels are foreground.
+// \param labels - output image. Background pixels are set to 0, and the pixels of the i-th component (in the order
+//        of their first pixels in raster order) - to i, starting from 1. Must have the same dimensions as @mask.
+// \param connectivity - which pixels are considered adjacent.
+// \param num_threads - the maximum number of threads to use (including the calling thread).
+//        0 and 1 mean that everything is done on the calling thread.
+// \return the number of connected components.
+// \throw std::invalid_argument if @mask and @labels have different dimensions.
+template <bool Mutable>
+unsigned int labelComponents(ImageView<PixelFormatGrayscale8, Mutable> mask, ImageView<PixelFormatLabel32, true> labels,
+                             Connectivity connectivity = Connectivity::k8, unsigned int num_threads = 1) {
+  return detail::labelComponentsImpl(mask, labels, connectivity, num_threads, nullptr);
+}
+
+// Same as above, but for a bit-packed mask.
+template <bool Mutable>
+unsigned int labelComponents(BitImageView<PixelFormatMask1, Mutable> mask, ImageView<PixelFormatLabel32, true> labels,
+                             Connectivity connectivity = Connectivity::k8, unsigned int num_threads = 1) {
+  return detail::labelComponentsImpl(mask, labels, connectivity, num_threads, nullptr);
+}
+
+// Labels the connected components of a binary mask and computes their statistics.
+// The parameters are the same as for labelComponents().
+// \return statistics of the components; the i-th element describes the component with the label i + 1.
+// \throw std::invalid_argument if @mask and @labels have different dimensions.
+template <bool Mutable>
+std::vector<ComponentStats> labelComponentsWithStats(ImageView<PixelFormatGrayscale8, Mutable> mask,
+                                                     ImageView<PixelFormatLabel32, true> labels,
+                                                     Connectivity connectivity = Connectivity::k8,
+                                                     unsigned int num_threads = 1) {
+  std::vector<ComponentStats> stats;
+  detail::labelComponentsImpl(mask, labels, connectivity, num_threads, &stats);
+  return stats;
+}
+
+// Same as above, but for a bit-packed mask.
+template <bool Mutable>
+std::vector<ComponentStats> labelComponentsWithStats(BitImageView<PixelFormatMask1, Mutable> mask,
+                                                     ImageView<PixelFormatLabel32, true> labels,
+                                                     Connectivity connectivity = Connectivity::k8,
+                                                     unsigned int num_threads = 1) {
+  std::vector<ComponentStats> stats;
+  detail::labelComponentsImpl(mask, labels, connectivity, num_threads, &stats);
+  return stats;
+}
+
+}  // namespace imageview
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <imageview/ImageRowView.h>
+#include <imageview/Instrumentation.h>
 #include <imageview/IsPixelFormat.h>
 #include <imageview/internal/ImageViewIterator.h>
 #include <imageview/internal/ImageViewStorage.h>
@@ -281,6 +282,7 @@ constexpr auto ContinuousImageView<PixelFormat, Mutable>::operator()(unsigned in
   if constexpr (Mutable) {
     return detail::PixelRef<PixelFormat>(pixel_data, storage_.pixelFormat());
   } else {
+    detail::instrumentPixelRead<PixelFormat>(pixel_data.data());
     return storage_.pixelFormat().read(pixel_data);
   }
 }
@@ -291,6 +293,7 @@ constexpr ImageRowView<PixelFormat, Mutable> ContinuousImageView<PixelFormat, Mu
   {
     throw std::out_of_range("ContinuousImageView::row(): y is out of range.");
   }
+  detail::instrumentRowAccess<PixelFormat>();
   const std::size_t bytes_per_row = static_cast<std::size_t>(width_) * PixelFormat::kBytesPerPixel;
   const std::span<byte_type> row_data(storage_.data() + y * bytes_per_row, bytes_per_row);
   return ImageRowView<PixelFormat, Mutable>(row_data, width_, pixelFormat());
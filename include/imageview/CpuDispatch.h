@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
+// Runtime dispatch of the bulk kernels by the instruction set of the host CPU.
+//
+// The library is header-only and is usually compiled for the lowest common denominator of the hosts it runs on.
+// To still use wider vector units where they exist, the kernels that dominate bulk operations (color depth
+// conversions, SAD/MSE) are compiled several times: once for the baseline target and, on x86 with GCC or Clang,
+// once per instruction set below via function-level target attributes. The kernels are plain loops, so every copy
+// is vectorized by the compiler for its own target. The CPU is queried once, on first use, and every call of a
+// dispatched algorithm picks the copy for the best instruction set that is both supported and allowed.
+//
+// On other platforms and compilers only the baseline copy exists, and all instruction sets map to it.
+//
+// setInstructionSetOverride() restricts the dispatch to a lower instruction set, e.g. to test every code path on a
+// single machine or to compare their performance.
+
+namespace imageview {
+
+// Instruction sets with a dedicated copy of the kernels, in increasing order.
+enum class InstructionSet {
+  // Whatever the translation unit is compiled for.
+  kBaseline,
+  // SSE4.2 (x86).
+  kSse42,
+  // AVX2 (x86).
+  kAvx2,
+  // AVX-512 F/BW/VL (x86).
+  kAvx512,
+};
+
+// Returns the best instruction set supported by the CPU. The result is computed once and cached.
+InstructionSet detectInstructionSet() noexcept;
+
+// Returns the instruction set the dispatched kernels currently use:
+// min(detectInstructionSet(), override) if an override is set, or detectInstructionSet() otherwise.
+InstructionSet getInstructionSet() noexcept;
+
+// Restricts the dispatched kernels to the specified instruction set, or removes the restriction if @instruction_set
+// is std::nullopt. An instruction set that the CPU doesn't support is clamped to detectInstructionSet().
+// Affects all threads; intended for tests and benchmarks.
+void setInstructionSetOverride(std::optional<InstructionSet> instruction_set) noexcept;
+
+// Returns the name of the instruction set.
+constexpr const char* getInstructionSetName(InstructionSet instruction_set) noexcept {
+  switch (instruction_set) {
+    case InstructionSet::kBaseline:
+      return "baseline";
+    case InstructionSet::kSse42:
+      return "sse4.2";
+    case InstructionSet::kAvx2:
+      return "avx2";
+    case InstructionSet::kAvx512:
+      return "avx512";
+  }
+  return "unknown";
+}
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define IMAGEVIEW_HAS_CPU_DISPATCH 1
+#define IMAGEVIEW_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define IMAGEVIEW_TARGET_AVX2 __attribute__((target("avx2")))
+#define IMAGEVIEW_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw,avx512vl")))
+// Dispatched kernels must be inlined into every target-specific copy, otherwise all copies would call the same
+// baseline code.
+#define IMAGEVIEW_DISPATCHED_KERNEL __attribute__((always_inline)) inline
+#else
+#define IMAGEVIEW_HAS_CPU_DISPATCH 0
+#define IMAGEVIEW_DISPATCHED_KERNEL inline
+#endif
+
+namespace detail {
+
+// The override set by setInstructionSetOverride(), or -1.
+inline std::atomic<int> instruction_set_override{-1};
+
+// Target-specific copies of the function Kernel.
+template <auto Kernel>
+struct KernelClones;
+
+template <class R, class... Args, R (*Kernel)(Args...)>
+struct KernelClones<Kernel> {
+  using function_type = R (*)(Args...);
+
+#if IMAGEVIEW_HAS_CPU_DISPATCH
+  IMAGEVIEW_TARGET_SSE42 static R sse42(Args... args) { return Kernel(args...); }
+  IMAGEVIEW_TARGET_AVX2 static R avx2(Args... args) { return Kernel(args...); }
+  IMAGEVIEW_TARGET_AVX512 static R avx512(Args... args) { return Kernel(args...); }
+#endif
+};
+
+// Returns the copy of the function Kernel for getInstructionSet().
+// \param Kernel - function declared with IMAGEVIEW_DISPATCHED_KERNEL.
+template <auto Kernel>
+auto selectKernel() noexcept -> typename KernelClones<Kernel>::function_type {
+#if IMAGEVIEW_HAS_CPU_DISPATCH
+  switch (getInstructionSet()) {
+    case InstructionSet::kBaseline:
+      return Kernel;
+    case InstructionSet::kSse42:
+      return &KernelClones<Kernel>::sse42;
+    case InstructionSet::kAvx2:
+      return &KernelClones<Kernel>::avx2;
+    case InstructionSet::kAvx512:
+      return &KernelClones<Kernel>::avx512;
+  }
+#endif
+  return Kernel;
+}
+
+inline InstructionSet queryInstructionSet() noexcept {
+#if IMAGEVIEW_HAS_CPU_DISPATCH
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl") &&
+      __builtin_cpu_supports("avx2")) {
+    return InstructionSet::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return InstructionSet::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return InstructionSet::kSse42;
+  }
+#endif
+  return InstructionSet::kBaseline;
+}
+
+}  // namespace detail
+
+inline InstructionSet detectInstructionSet() noexcept {
+  static const InstructionSet instruction_set = detail::queryInstructionSet();
+  return instruction_set;
+}
+
+inline InstructionSet getInstructionSet() noexcept {
+  const InstructionSet detected = detectInstructionSet();
+  const int forced = detail::instruction_set_override.load(std::memory_order_relaxed);
+  return (forced < 0) ? detected : std::min(detected, static_cast<InstructionSet>(forced));
+}
+
+inline void setInstructionSetOverride(std::optional<InstructionSet> instruction_set) noexcept {
+  detail::instruction_set_override.store(instruction_set ? static_cast<int>(*instruction_set) : -1,
+                                         std::memory_order_relaxed);
+}
+
+}  // namespace imageview
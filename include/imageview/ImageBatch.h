@@ -0,0 +1,358 @@
+#pragma once
+
+#include <imageview/ContinuousImageView.h>
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageView.h>
+#include <imageview/ImageViewUtils.h>
+#include <imageview/IsPixelFormat.h>
+#include <imageview/internal/ParallelFor.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace imageview {
+
+// Non-owning collection of many images with the same pixel format.
+//
+// ImageBatch is meant for workloads that process lots of small images (e.g., thumbnails), where constructing
+// an ImageView per image and dispatching each image to a thread pool costs as much as processing its pixels.
+// The dimensions of the images are stored as structure-of-arrays and validated when the images are added, so
+// accessing an image doesn't validate anything again. The batch functions below split the batch into bands of images
+// with (almost) equal total area, parallelizing across images rather than within them.
+//
+// Batch operations: forEachImage(), copy(), fill(), convert(), hash(), sad() and mse(). Resizing and histograms are
+// not provided.
+//
+// \param PixelFormat - specifies how colors are stored in the bitmaps. All images share the same instance.
+// \param Mutable - if true, ImageBatch provides write access to the bitmaps.
+template <class PixelFormat, bool Mutable = false>
+class ImageBatch {
+ public:
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+
+  using byte_type = std::conditional_t<Mutable, std::byte, const std::byte>;
+
+  // Constructs an empty batch.
+  // \param pixel_format - instance of PixelFormat to use.
+  explicit ImageBatch(const PixelFormat& pixel_format = PixelFormat());
+
+  // Constructs a batch of @count images of the same size stored one after another in a single buffer.
+  // The dimensions are validated once for the whole batch.
+  // \param count - the number of images.
+  // \param height - height of each image.
+  // \param width - width of each image.
+  // \param stride - the number of pixels between the beginnings of 2 consecutive rows of an image.
+  //        The last row of each image is padded as well, i.e. image i starts at pixel i * height * stride.
+  // \param data - bitmap data. Its size should be exactly
+  //          count * height * stride * PixelFormat::kBytesPerPixel.
+  // \param pixel_format - instance of PixelFormat to use.
+  // \throw std::invalid_argument if stride < width or @data has the wrong size.
+  ImageBatch(std::size_t count, unsigned int height, unsigned int width, unsigned int stride,
+             std::span<byte_type> data, const PixelFormat& pixel_format = PixelFormat());
+
+  // Construct a read-only batch from a mutable batch.
+  template <bool OtherMutable, class Enable = std::enable_if_t<!Mutable && OtherMutable>>
+  ImageBatch(const ImageBatch<PixelFormat, OtherMutable>& other);
+
+  // Reserves memory for @capacity images.
+  void reserve(std::size_t capacity);
+
+  // Adds an image to the batch.
+  // The image must use a pixel format equivalent to pixelFormat().
+  void add(ImageView<PixelFormat, Mutable> image);
+
+  // Removes all images from the batch.
+  void clear() noexcept;
+
+  // Returns the number of images in the batch.
+  std::size_t size() const noexcept;
+
+  // Returns true if the batch contains no images, false otherwise.
+  bool empty() const noexcept;
+
+  // Returns the pixel format used by all images.
+  const PixelFormat& pixelFormat() const noexcept;
+
+  // Returns the heights of all images.
+  std::span<const unsigned int> heights() const noexcept;
+
+  // Returns the widths of all images.
+  std::span<const unsigned int> widths() const noexcept;
+
+  // Returns the strides of all images.
+  std::span<const unsigned int> strides() const noexcept;
+
+  // Returns the pointers to the first pixels of all images.
+  std::span<byte_type* const> data() const noexcept;
+
+  // Returns the total number of pixels in all images.
+  std::size_t area() const noexcept;
+
+  // Returns a view into the specified image.
+  // \param index - 0-based index of the image. No bounds checking is performed.
+  ImageView<PixelFormat, Mutable> operator[](std::size_t index) const noexcept;
+
+  // Returns a view into the specified image.
+  // \param index - 0-based index of the image.
+  // \throw std::out_of_range if @index is outside [0; size()).
+  ImageView<PixelFormat, Mutable> at(std::size_t index) const;
+
+ private:
+  template <class OtherPixelFormat, bool OtherMutable>
+  friend class ImageBatch;
+
+  std::vector<unsigned int> heights_;
+  std::vector<unsigned int> widths_;
+  std::vector<unsigned int> strides_;
+  std::vector<byte_type*> data_;
+  std::size_t area_ = 0;
+  PixelFormat pixel_format_;
+};
+
+template <class PixelFormat, bool Mutable>
+ImageBatch<PixelFormat, Mutable>::ImageBatch(const PixelFormat& pixel_format) : pixel_format_(pixel_format) {}
+
+template <class PixelFormat, bool Mutable>
+ImageBatch<PixelFormat, Mutable>::ImageBatch(std::size_t count, unsigned int height, unsigned int width,
+                                             unsigned int stride, std::span<byte_type> data,
+                                             const PixelFormat& pixel_format)
+    : pixel_format_(pixel_format) {
+  if (stride < width)
+  {
+    throw std::invalid_argument("ImageBatch(): stride cannot be less than width.");
+  }
+  const std::size_t image_size = static_cast<std::size_t>(height) * stride * PixelFormat::kBytesPerPixel;
+  if (data.size() != count * image_size)
+  {
+    throw std::invalid_argument("ImageBatch(): wrong number of bytes in the input data.");
+  }
+  heights_.assign(count, height);
+  widths_.assign(count, width);
+  strides_.assign(count, stride);
+  data_.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    data_[i] = data.data() + i * image_size;
+  }
+  area_ = count * height * width;
+}
+
+template <class PixelFormat, bool Mutable>
+template <bool OtherMutable, class Enable>
+ImageBatch<PixelFormat, Mutable>::ImageBatch(const ImageBatch<PixelFormat, OtherMutable>& other)
+    : heights_(other.heights_),
+      widths_(other.widths_),
+      strides_(other.strides_),
+      data_(other.data_.begin(), other.data_.end()),
+      area_(other.area_),
+      pixel_format_(other.pixel_format_) {}
+
+template <class PixelFormat, bool Mutable>
+void ImageBatch<PixelFormat, Mutable>::reserve(std::size_t capacity) {
+  heights_.reserve(capacity);
+  widths_.reserve(capacity);
+  strides_.reserve(capacity);
+  data_.reserve(capacity);
+}
+
+template <class PixelFormat, bool Mutable>
+void ImageBatch<PixelFormat, Mutable>::add(ImageView<PixelFormat, Mutable> image) {
+  heights_.push_back(image.height());
+  widths_.push_back(image.width());
+  strides_.push_back(image.stride());
+  data_.push_back(image.data().data());
+  area_ += image.area();
+}
+
+template <class PixelFormat, bool Mutable>
+void ImageBatch<PixelFormat, Mutable>::clear() noexcept {
+  heights_.clear();
+  widths_.clear();
+  strides_.clear();
+  data_.clear();
+  area_ = 0;
+}
+
+template <class PixelFormat, bool Mutable>
+std::size_t ImageBatch<PixelFormat, Mutable>::size() const noexcept {
+  return data_.size();
+}
+
+template <class PixelFormat, bool Mutable>
+bool ImageBatch<PixelFormat, Mutable>::empty() const noexcept {
+  return data_.empty();
+}
+
+template <class PixelFormat, bool Mutable>
+const PixelFormat& ImageBatch<PixelFormat, Mutable>::pixelFormat() const noexcept {
+  return pixel_format_;
+}
+
+template <class PixelFormat, bool Mutable>
+std::span<const unsigned int> ImageBatch<PixelFormat, Mutable>::heights() const noexcept {
+  return heights_;
+}
+
+template <class PixelFormat, bool Mutable>
+std::span<const unsigned int> ImageBatch<PixelFormat, Mutable>::widths() const noexcept {
+  return widths_;
+}
+
+template <class PixelFormat, bool Mutable>
+std::span<const unsigned int> ImageBatch<PixelFormat, Mutable>::strides() const noexcept {
+  return strides_;
+}
+
+template <class PixelFormat, bool Mutable>
+auto ImageBatch<PixelFormat, Mutable>::data() const noexcept -> std::span<byte_type* const> {
+  return data_;
+}
+
+template <class PixelFormat, bool Mutable>
+std::size_t ImageBatch<PixelFormat, Mutable>::area() const noexcept {
+  return area_;
+}
+
+template <class PixelFormat, bool Mutable>
+ImageView<PixelFormat, Mutable> ImageBatch<PixelFormat, Mutable>::operator[](std::size_t index) const noexcept {
+  // The dimensions have been validated by the constructor or add().
+  return ImageView<PixelFormat, Mutable>(typename ImageView<PixelFormat, Mutable>::UncheckedTag(), heights_[index],
+                                         widths_[index], strides_[index], data_[index], pixel_format_);
+}
+
+template <class PixelFormat, bool Mutable>
+ImageView<PixelFormat, Mutable> ImageBatch<PixelFormat, Mutable>::at(std::size_t index) const {
+  if (index >= size())
+  {
+    throw std::out_of_range("ImageBatch::at(): index is out of range.");
+  }
+  return (*this)[index];
+}
+
+namespace detail {
+
+// Throws std::invalid_argument if the images in the batches have different dimensions.
+template <class LhsFormat, bool LhsMutable, class RhsFormat, bool RhsMutable>
+void checkSameDimensions(const ImageBatch<LhsFormat, LhsMutable>& lhs, const ImageBatch<RhsFormat, RhsMutable>& rhs,
+                         const char* message) {
+  if (lhs.size() != rhs.size() || !std::ranges::equal(lhs.heights(), rhs.heights()) ||
+      !std::ranges::equal(lhs.widths(), rhs.widths()))
+  {
+    throw std::invalid_argument(message);
+  }
+}
+
+}  // namespace detail
+
+// Invokes @function for each image in the batch.
+// The batch is split into min(batch.size(), num_threads) bands of consecutive images with (almost) equal total
+// area; bands are processed in parallel, and images within a band - sequentially.
+// \param batch - input batch.
+// \param num_threads - the maximum number of threads to use (including the calling thread).
+//        0 and 1 mean that everything is done on the calling thread.
+// \param function - function with the signature equivalent to
+//          void function(std::size_t index, ImageView<PixelFormat, Mutable> image);
+//        It must not throw exceptions if num_threads > 1.
+template <class PixelFormat, bool Mutable, class Function>
+void forEachImage(const ImageBatch<PixelFormat, Mutable>& batch, unsigned int num_threads, Function function) {
+  const std::size_t num_bands = detail::getNumBands(batch.size(), num_threads);
+  if (num_bands == 1) {
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      function(i, batch[i]);
+    }
+    return;
+  }
+  // The first image of the band b is the first one that ends after total_area * b / num_bands pixels.
+  std::vector<std::size_t> area_end(batch.size());
+  std::size_t area = 0;
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    area += static_cast<std::size_t>(batch.heights()[i]) * batch.widths()[i];
+    area_end[i] = area;
+  }
+  const auto band_begin = [&area_end, area, num_bands](std::size_t band) -> std::size_t {
+    if (band == 0) {
+      return 0;
+    }
+    if (band == num_bands) {
+      return area_end.size();
+    }
+    const std::size_t threshold = area * band / num_bands;
+    return std::upper_bound(area_end.begin(), area_end.end(), threshold) - area_end.begin();
+  };
+  detail::parallelFor(num_bands, num_bands, [&](std::size_t, std::size_t first_band, std::size_t last_band) {
+    for (std::size_t i = band_begin(first_band); i < band_begin(last_band); ++i) {
+      function(i, batch[i]);
+    }
+  });
+}
+
+// Copies pixels from each image of @src into the corresponding image of @dst.
+// \throw std::invalid_argument if the batches have different sizes or the images have different dimensions.
+template <class PixelFormat, bool Mutable>
+void copy(const ImageBatch<PixelFormat, Mutable>& src, const ImageBatch<PixelFormat, true>& dst,
+          unsigned int num_threads = 1) {
+  detail::checkSameDimensions(src, dst, "imageview::copy(): batches must have the same dimensions.");
+  forEachImage(src, num_threads, [&dst](std::size_t i, ImageView<PixelFormat, Mutable> image) { copy(image, dst[i]); });
+}
+
+// Assigns the given color to all pixels of all images in the batch.
+template <class PixelFormat>
+void fill(const ImageBatch<PixelFormat, true>& batch, const typename PixelFormat::color_type& color,
+          unsigned int num_threads = 1) {
+  forEachImage(batch, num_threads, [&color](std::size_t, ImageView<PixelFormat, true> image) { fill(image, color); });
+}
+
+// Converts each image of @src into the pixel format of @dst.
+// Any pair of pixel formats for which `convert(ImageView<SrcFormat>, ImageView<DstFormat, true>)` is available
+// (e.g., from ColorDepthConversions.h or BitImageViewUtils.h) is supported.
+// \throw std::invalid_argument if the batches have different sizes or the images have different dimensions.
+template <class SrcFormat, bool SrcMutable, class DstFormat>
+void convert(const ImageBatch<SrcFormat, SrcMutable>& src, const ImageBatch<DstFormat, true>& dst,
+             unsigned int num_threads = 1) {
+  detail::checkSameDimensions(src, dst, "imageview::convert(): batches must have the same dimensions.");
+  forEachImage(src, num_threads, [&dst](std::size_t i, ImageView<SrcFormat, SrcMutable> image) {
+    convert(ImageView<SrcFormat>(image), dst[i]);
+  });
+}
+
+// Computes hash(image) for each image in the batch.
+template <class PixelFormat, bool Mutable>
+std::vector<std::uint64_t> hash(const ImageBatch<PixelFormat, Mutable>& batch, unsigned int num_threads = 1) {
+  std::vector<std::uint64_t> result(batch.size());
+  forEachImage(batch, num_threads,
+               [&result](std::size_t i, ImageView<PixelFormat, Mutable> image) { result[i] = hash(image); });
+  return result;
+}
+
+// Computes sad() for each pair of corresponding images.
+// \throw std::invalid_argument if the batches have different sizes or the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+std::vector<std::uint64_t> sad(const ImageBatch<PixelFormat, LhsMutable>& lhs,
+                               const ImageBatch<PixelFormat, RhsMutable>& rhs, unsigned int num_threads = 1) {
+  detail::checkSameDimensions(lhs, rhs, "imageview::sad(): batches must have the same dimensions.");
+  std::vector<std::uint64_t> result(lhs.size());
+  forEachImage(lhs, num_threads, [&result, &rhs](std::size_t i, ImageView<PixelFormat, LhsMutable> image) {
+    result[i] = sad(image, rhs[i]);
+  });
+  return result;
+}
+
+// Computes mse() for each pair of corresponding images.
+// \throw std::invalid_argument if the batches have different sizes or the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+std::vector<double> mse(const ImageBatch<PixelFormat, LhsMutable>& lhs, const ImageBatch<PixelFormat, RhsMutable>& rhs,
+                        unsigned int num_threads = 1) {
+  detail::checkSameDimensions(lhs, rhs, "imageview::mse(): batches must have the same dimensions.");
+  std::vector<double> result(lhs.size());
+  forEachImage(lhs, num_threads, [&result, &rhs](std::size_t i, ImageView<PixelFormat, LhsMutable> image) {
+    result[i] = mse(image, rhs[i]);
+  });
+  return result;
+}
+
+}  // namespace imageview
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <imageview/CpuDispatch.h>
+#include <imageview/ImageView.h>
+#include <imageview/IsTriviallyEncoded.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/internal/ParallelFor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Functions for comparing images: exact equality, hashing and quality metrics (SAD, MSE, PSNR, SSIM).
+//
+// The metrics are defined for pixel formats where each byte of a pixel is an 8-bit channel
+// (PixelFormatGrayscale8, PixelFormatRGB24, PixelFormatRGBA32); the channels are treated
+// independently. The kernels operate on raw channel arrays, so that the compiler can vectorize
+// them; SAD and MSE pick the copy of their kernel for the host CPU at runtime (see CpuDispatch.h).
+// All metrics accept an optional number of threads; rows are split into bands, which are
+// processed in parallel, and the partial results are combined on the calling thread.
+
+namespace imageview {
+namespace detail {
+
+template <class PixelFormat>
+void checkSameDimensions(ImageView<PixelFormat> lhs, ImageView<PixelFormat> rhs, const char* message) {
+  if (lhs.height() != rhs.height() || lhs.width() != rhs.width())
+  {
+    throw std::invalid_argument(message);
+  }
+}
+
+// Combines 2 64-bit values into a hash.
+constexpr std::uint64_t mixHash(std::uint64_t seed, std::uint64_t value) noexcept {
+  std::uint64_t h = (seed ^ value) * 0x9E3779B97F4A7C15ull;
+  return h ^ (h >> 32);
+}
+
+// Hashes an array of bytes, 8 bytes at a time.
+inline std::uint64_t hashBytes(const std::byte* data, std::size_t size) noexcept {
+  std::uint64_t result = size;
+  std::size_t offset = 0;
+  for (; offset + 8 <= size; offset += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, data + offset, 8);
+    result = mixHash(result, word);
+  }
+  if (offset != size) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data + offset, size - offset);
+    result = mixHash(result, word);
+  }
+  return result;
+}
+
+// Returns the sum of absolute differences of 2 arrays of bytes.
+IMAGEVIEW_DISPATCHED_KERNEL std::uint64_t sumAbsoluteDifferences(const unsigned char* lhs, const unsigned char* rhs,
+                                                                 std::size_t size) {
+  std::uint64_t result = 0;
+  // 32-bit partial sums vectorize better; 2^16 differences of at most 255 never overflow them.
+  constexpr std::size_t kChunkSize = 1 << 16;
+  for (std::size_t first = 0; first < size; first += kChunkSize) {
+    const std::size_t last = std::min(size, first + kChunkSize);
+    std::uint32_t partial = 0;
+    for (std::size_t i = first; i < last; ++i) {
+      partial += static_cast<std::uint32_t>(lhs[i] > rhs[i] ? lhs[i] - rhs[i] : rhs[i] - lhs[i]);
+    }
+    result += partial;
+  }
+  return result;
+}
+
+// Returns the sum of squared differences of 2 arrays of bytes.
+IMAGEVIEW_DISPATCHED_KERNEL std::uint64_t sumSquaredDifferences(const unsigned char* lhs, const unsigned char* rhs,
+                                                                std::size_t size) {
+  std::uint64_t result = 0;
+  // 2^16 squared differences of at most 255^2 never overflow 32-bit partial sums.
+  constexpr std::size_t kChunkSize = 1 << 16;
+  for (std::size_t first = 0; first < size; first += kChunkSize) {
+    const std::size_t last = std::min(size, first + kChunkSize);
+    std::uint32_t partial = 0;
+    for (std::size_t i = first; i < last; ++i) {
+      const int difference = static_cast<int>(lhs[i]) - static_cast<int>(rhs[i]);
+      partial += static_cast<std::uint32_t>(difference * difference);
+    }
+    result += partial;
+  }
+  return result;
+}
+
+// Computes the sum of @kernel(lhs_row, rhs_row, row_size) over all rows.
+template <class PixelFormat, class Kernel>
+std::uint64_t reduceRows(ImageView<PixelFormat> lhs, ImageView<PixelFormat> rhs, unsigned int num_threads,
+                         Kernel kernel) {
+  const std::size_t row_size = static_cast<std::size_t>(lhs.width()) * PixelFormat::kBytesPerPixel;
+  if (lhs.empty()) {
+    return 0;
+  }
+  if (num_threads <= 1 && lhs.stride() == lhs.width() && rhs.stride() == rhs.width()) {
+    return kernel(getRowData(lhs, 0), getRowData(rhs, 0), lhs.area() * PixelFormat::kBytesPerPixel);
+  }
+  std::vector<std::uint64_t> partial_sums(getNumBands(lhs.height(), num_threads));
+  parallelFor(lhs.height(), num_threads, [&](std::size_t band, std::size_t first, std::size_t last) {
+    std::uint64_t sum = 0;
+    for (std::size_t y = first; y < last; ++y) {
+      sum += kernel(getRowData(lhs, static_cast<unsigned int>(y)), getRowData(rhs, static_cast<unsigned int>(y)),
+                    row_size);
+    }
+    partial_sums[band] = sum;
+  });
+  std::uint64_t result = 0;
+  for (std::uint64_t sum : partial_sums) {
+    result += sum;
+  }
+  return result;
+}
+
+// Computes the sum of SSIM values of all windows whose top rows are within [first_row; last_row),
+// for the channel @channel.
+template <class PixelFormat>
+double sumSsimWindows(ImageView<PixelFormat> lhs, ImageView<PixelFormat> rhs, unsigned int window,
+                      unsigned int channel, std::size_t first_row, std::size_t last_row) {
+  constexpr unsigned int kChannels = PixelFormat::kBytesPerPixel;
+  constexpr double kC1 = (0.01 * 255) * (0.01 * 255);
+  constexpr double kC2 = (0.03 * 255) * (0.03 * 255);
+  const unsigned int width = lhs.width();
+  const double num_samples = static_cast<double>(window) * window;
+  // Sums over `window` consecutive rows for each column.
+  std::vector<std::int64_t> sum_l(width), sum_r(width), sum_ll(width), sum_rr(width), sum_lr(width);
+  // Adds (sign == 1) or subtracts (sign == -1) the row @y to/from the column sums.
+  const auto accumulate_row = [&](std::size_t y, std::int64_t sign) {
+    const unsigned char* l = getRowData(lhs, static_cast<unsigned int>(y)) + channel;
+    const unsigned char* r = getRowData(rhs, static_cast<unsigned int>(y)) + channel;
+    for (unsigned int x = 0; x < width; ++x) {
+      const std::int64_t a = l[x * kChannels];
+      const std::int64_t b = r[x * kChannels];
+      sum_l[x] += sign * a;
+      sum_r[x] += sign * b;
+      sum_ll[x] += sign * a * a;
+      sum_rr[x] += sign * b * b;
+      sum_lr[x] += sign * a * b;
+    }
+  };
+  for (std::size_t y = first_row; y < first_row + window; ++y) {
+    accumulate_row(y, 1);
+  }
+  double result = 0.0;
+  for (std::size_t y = first_row; y < last_row; ++y) {
+    std::int64_t l = 0, r = 0, ll = 0, rr = 0, lr = 0;
+    for (unsigned int x = 0; x < width; ++x) {
+      l += sum_l[x];
+      r += sum_r[x];
+      ll += sum_ll[x];
+      rr += sum_rr[x];
+      lr += sum_lr[x];
+      if (x + 1 < window) {
+        continue;
+      }
+      const double mean_l = l / num_samples;
+      const double mean_r = r / num_samples;
+      const double variance_l = ll / num_samples - mean_l * mean_l;
+      const double variance_r = rr / num_samples - mean_r * mean_r;
+      const double covariance = lr / num_samples - mean_l * mean_r;
+      result += ((2 * mean_l * mean_r + kC1) * (2 * covariance + kC2)) /
+                ((mean_l * mean_l + mean_r * mean_r + kC1) * (variance_l + variance_r + kC2));
+      const unsigned int x_out = x + 1 - window;
+      l -= sum_l[x_out];
+      r -= sum_r[x_out];
+      ll -= sum_ll[x_out];
+      rr -= sum_rr[x_out];
+      lr -= sum_lr[x_out];
+    }
+    if (y + 1 < last_row) {
+      accumulate_row(y, -1);
+      accumulate_row(y + window, 1);
+    }
+  }
+  return result;
+}
+
+// Re-encodes @row_size bytes of pixels from @src into @dst via PixelFormat::write(PixelFormat::read()).
+template <class PixelFormat>
+void reencodeRow(const PixelFormat& pixel_format, const std::byte* src, std::byte* dst, std::size_t row_size) {
+  constexpr std::size_t kBytesPerPixel = PixelFormat::kBytesPerPixel;
+  for (std::size_t offset = 0; offset < row_size; offset += kBytesPerPixel) {
+    pixel_format.write(pixel_format.read(std::span<const std::byte, kBytesPerPixel>(src + offset, kBytesPerPixel)),
+                       std::span<std::byte, kBytesPerPixel>(dst + offset, kBytesPerPixel));
+  }
+}
+
+}  // namespace detail
+
+// Checks if 2 images are equal, i.e. have the same dimensions and the same encoded pixels: 2 pixels are equal if
+// PixelFormat::write() produces the same bytes for their colors. For most formats this is the same as comparing
+// colors via color_type::operator==; for floating-point formats it means that 0.0f and -0.0f are different, while
+// NaNs with identical bits are equal, regardless of the byte order.
+// If PixelFormat is trivially encoded, rows are compared via std::memcmp() (the whole bitmaps at once if neither
+// image has gaps between rows). Otherwise, each row is re-encoded via PixelFormat::write(PixelFormat::read()) first.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+bool equal(ImageView<PixelFormat, LhsMutable> lhs, ImageView<PixelFormat, RhsMutable> rhs) {
+  if (lhs.height() != rhs.height() || lhs.width() != rhs.width()) {
+    return false;
+  }
+  if (lhs.empty()) {
+    return true;
+  }
+  if constexpr (IsTriviallyEncoded<PixelFormat>::value) {
+    const auto lhs_data = lhs.data();
+    const auto rhs_data = rhs.data();
+    const bool lhs_continuous = lhs.stride() == lhs.width() || lhs.height() == 1;
+    const bool rhs_continuous = rhs.stride() == rhs.width() || rhs.height() == 1;
+    if (lhs_continuous && rhs_continuous) {
+      return std::memcmp(lhs_data.data(), rhs_data.data(), lhs_data.size()) == 0;
+    }
+    const std::size_t row_size = static_cast<std::size_t>(lhs.width()) * PixelFormat::kBytesPerPixel;
+    const std::size_t lhs_row_step = static_cast<std::size_t>(lhs.stride()) * PixelFormat::kBytesPerPixel;
+    const std::size_t rhs_row_step = static_cast<std::size_t>(rhs.stride()) * PixelFormat::kBytesPerPixel;
+    for (unsigned int y = 0; y < lhs.height(); ++y) {
+      if (std::memcmp(lhs_data.data() + y * lhs_row_step, rhs_data.data() + y * rhs_row_step, row_size) != 0) {
+        return false;
+      }
+    }
+    return true;
+  } else {
+    const std::size_t row_size = static_cast<std::size_t>(lhs.width()) * PixelFormat::kBytesPerPixel;
+    std::vector<std::byte> lhs_buffer(row_size);
+    std::vector<std::byte> rhs_buffer(row_size);
+    for (unsigned int y = 0; y < lhs.height(); ++y) {
+      detail::reencodeRow(lhs.pixelFormat(), lhs.row(y).data().data(), lhs_buffer.data(), row_size);
+      detail::reencodeRow(rhs.pixelFormat(), rhs.row(y).data().data(), rhs_buffer.data(), row_size);
+      if (lhs_buffer != rhs_buffer) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+// Computes a hash of the image, which is consistent with equal(): equal images have equal hashes.
+// The hash depends on the dimensions of the image and the colors of its pixels, but not on the stride.
+// If PixelFormat is trivially encoded, rows are hashed 8 bytes at a time straight from the bitmap.
+// Otherwise, each pixel is re-encoded via PixelFormat::write(PixelFormat::read()) first.
+// Note that the result depends on the byte order of the platform.
+template <class PixelFormat, bool Mutable>
+std::uint64_t hash(ImageView<PixelFormat, Mutable> image) {
+  std::uint64_t result = detail::mixHash(image.height(), image.width());
+  if (image.empty()) {
+    return result;
+  }
+  const std::size_t row_size = static_cast<std::size_t>(image.width()) * PixelFormat::kBytesPerPixel;
+  if constexpr (IsTriviallyEncoded<PixelFormat>::value) {
+    for (unsigned int y = 0; y < image.height(); ++y) {
+      result = detail::mixHash(result, detail::hashBytes(image.row(y).data().data(), row_size));
+    }
+  } else {
+    std::vector<std::byte> row_buffer(row_size);
+    for (unsigned int y = 0; y < image.height(); ++y) {
+      detail::reencodeRow(image.pixelFormat(), image.row(y).data().data(), row_buffer.data(), row_size);
+      result = detail::mixHash(result, detail::hashBytes(row_buffer.data(), row_size));
+    }
+  }
+  return result;
+}
+
+// Computes the sum of absolute differences between the channels of 2 images.
+// \param lhs, rhs - input images. Must have the same dimensions.
+// \param num_threads - the maximum number of threads to use.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+std::uint64_t sad(ImageView<PixelFormat, LhsMutable> lhs, ImageView<PixelFormat, RhsMutable> rhs,
+                  unsigned int num_threads = 1) {
+  static_assert(detail::HasByteChannels<PixelFormat>::value, "Only pixel formats with 8-bit channels are supported.");
+  detail::checkSameDimensions<PixelFormat>(lhs, rhs, "imageview::sad(): images must have the same dimensions.");
+  return detail::reduceRows<PixelFormat>(lhs, rhs, num_threads,
+                                         detail::selectKernel<detail::sumAbsoluteDifferences>());
+}
+
+// Computes the mean squared error between the channels of 2 images.
+// \param lhs, rhs - input images. Must have the same dimensions.
+// \param num_threads - the maximum number of threads to use.
+// \return the mean squared error, or 0 if the images are empty.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+double mse(ImageView<PixelFormat, LhsMutable> lhs, ImageView<PixelFormat, RhsMutable> rhs,
+           unsigned int num_threads = 1) {
+  static_assert(detail::HasByteChannels<PixelFormat>::value, "Only pixel formats with 8-bit channels are supported.");
+  detail::checkSameDimensions<PixelFormat>(lhs, rhs, "imageview::mse(): images must have the same dimensions.");
+  if (lhs.empty()) {
+    return 0.0;
+  }
+  const std::uint64_t sum = detail::reduceRows<PixelFormat>(lhs, rhs, num_threads,
+                                                            detail::selectKernel<detail::sumSquaredDifferences>());
+  return static_cast<double>(sum) / (static_cast<double>(lhs.area()) * PixelFormat::kBytesPerPixel);
+}
+
+// Computes the peak signal-to-noise ratio (in dB) between 2 images.
+// \param lhs, rhs - input images. Must have the same dimensions.
+// \param num_threads - the maximum number of threads to use.
+// \return PSNR, or +infinity if the images are equal.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+double psnr(ImageView<PixelFormat, LhsMutable> lhs, ImageView<PixelFormat, RhsMutable> rhs,
+            unsigned int num_threads = 1) {
+  const double mean_squared_error = mse(lhs, rhs, num_threads);
+  if (mean_squared_error == 0.0) {
+    return std::numeric_limits<double>::infinity();
+  }
+  return 10.0 * std::log10(255.0 * 255.0 / mean_squared_error);
+}
+
+// Computes the mean structural similarity index between 2 images.
+// SSIM is computed for every window x window square (with a uniform weighting function) and every channel;
+// the result is the mean over all windows and channels. Window sums are updated incrementally, so the cost
+// doesn't depend on the size of the window.
+// \param lhs, rhs - input images. Must have the same dimensions.
+// \param window - the size of the window. Must not exceed the dimensions of the images.
+// \param num_threads - the maximum number of threads to use.
+// \return SSIM within [-1; 1]; 1 means that the images are equal.
+// \throw std::invalid_argument if the images have different dimensions or are smaller than the window.
+template <class PixelFormat, bool LhsMutable, bool RhsMutable>
+double ssim(ImageView<PixelFormat, LhsMutable> lhs, ImageView<PixelFormat, RhsMutable> rhs, unsigned int window = 8,
+            unsigned int num_threads = 1) {
+  static_assert(detail::HasByteChannels<PixelFormat>::value, "Only pixel formats with 8-bit channels are supported.");
+  detail::checkSameDimensions<PixelFormat>(lhs, rhs, "imageview::ssim(): images must have the same dimensions.");
+  if (window == 0 || window > lhs.height() || window > lhs.width())
+  {
+    throw std::invalid_argument("imageview::ssim(): window must be within [1; min(height, width)].");
+  }
+  const std::size_t num_window_rows = lhs.height() - window + 1;
+  const std::size_t num_window_columns = lhs.width() - window + 1;
+  std::vector<double> partial_sums(detail::getNumBands(num_window_rows, num_threads));
+  detail::parallelFor(num_window_rows, num_threads, [&](std::size_t band, std::size_t first, std::size_t last) {
+    double sum = 0.0;
+    for (unsigned int channel = 0; channel < PixelFormat::kBytesPerPixel; ++channel) {
+      sum += detail::sumSsimWindows<PixelFormat>(lhs, rhs, window, channel, first, last);
+    }
+    partial_sums[band] = sum;
+  });
+  double result = 0.0;
+  for (double sum : partial_sums) {
+    result += sum;
+  }
+  return result / (static_cast<double>(num_window_rows) * num_window_columns * PixelFormat::kBytesPerPixel);
+}
+
+}  // namespace imageview
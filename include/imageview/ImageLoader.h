@@ -0,0 +1,317 @@
+#pragma once
+
+#include <imageview/BmpCodec.h>
+#include <imageview/ImagePool.h>
+#include <imageview/ImageView.h>
+#include <imageview/QoiCodec.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/pixel_formats/PixelFormatBGR24.h>
+#include <imageview/pixel_formats/PixelFormatBGRA32.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Asynchronous loading of image files.
+//
+// AsyncImageLoader reads and decodes the files of a list on a few I/O threads while the caller processes the
+// previous ones. The files are delivered in the order of the list; at most read_ahead files are loaded but not
+// yet delivered, so a slow consumer blocks the I/O threads instead of accumulating decoded images. Decoded images
+// are stored in buffers borrowed from an ImagePool, and the encoded bytes are read into a buffer that every
+// I/O thread reuses for all of its files, so a steady-state loop doesn't allocate memory.
+//
+// Supported file formats are QOI and uncompressed 24/32-bit BMP; the format is detected by the signature.
+
+namespace imageview {
+
+struct AsyncImageLoaderOptions {
+  // The number of I/O threads.
+  unsigned int num_threads = 2;
+  // The maximum number of files that are loaded ahead of the consumer.
+  std::size_t read_ahead = 4;
+};
+
+// Image delivered by AsyncImageLoader.
+template <class PixelFormat>
+struct LoadedImage {
+  // 0-based index of the file in the list passed to AsyncImageLoader.
+  std::size_t index = 0;
+  PooledImage<PixelFormat> image;
+};
+
+// Loads a list of image files in the background.
+// \param PixelFormat - pixel format of the decoded images: a format with 8-bit channels and color type RGB24 or
+//        RGBA32 (e.g., PixelFormatRGB24 or PixelFormatRGBA32).
+template <class PixelFormat>
+class AsyncImageLoader {
+ public:
+  static_assert(detail::HasByteChannels<PixelFormat>::value && PixelFormat::kBytesPerPixel >= 3,
+                "Only PixelFormatRGB24 and PixelFormatRGBA32 are supported.");
+
+  // Starts loading the files.
+  // \param paths - the files to load.
+  // \param pool - pool to allocate the decoded images from. Must outlive the loader and all delivered images.
+  // \param options - parameters of the loader.
+  // \param pixel_format - instance of PixelFormat to use.
+  // \throw std::invalid_argument if options.num_threads or options.read_ahead is 0.
+  AsyncImageLoader(std::vector<std::filesystem::path> paths, ImagePool& pool,
+                   const AsyncImageLoaderOptions& options = AsyncImageLoaderOptions(),
+                   const PixelFormat& pixel_format = PixelFormat());
+
+  AsyncImageLoader(const AsyncImageLoader&) = delete;
+  AsyncImageLoader& operator=(const AsyncImageLoader&) = delete;
+
+  // Stops the I/O threads. Files that are being loaded are finished, but not delivered.
+  ~AsyncImageLoader();
+
+  // Returns the number of files in the list.
+  std::size_t size() const noexcept;
+
+  // Waits for the next file of the list to be loaded and returns it, or std::nullopt if all files have been
+  // delivered.
+  // \throw the exception thrown while reading or decoding the file (e.g., std::runtime_error if the file is
+  //        missing or corrupted). The file is skipped; the next call returns the next file.
+  std::optional<LoadedImage<PixelFormat>> next();
+
+ private:
+  struct Slot {
+    bool ready = false;
+    PooledImage<PixelFormat> image;
+    std::exception_ptr error;
+  };
+
+  void run();
+
+  std::vector<std::filesystem::path> paths_;
+  ImagePool* pool_;
+  PixelFormat pixel_format_;
+  std::mutex mutex_;
+  // Notified when a file has been loaded.
+  std::condition_variable loaded_;
+  // Notified when a file has been delivered or the loader is being destroyed.
+  std::condition_variable delivered_;
+  // slots_[i % slots_.size()] holds the result for the file i in [next_to_deliver_; next_to_load_).
+  std::vector<Slot> slots_;
+  std::size_t next_to_load_ = 0;
+  std::size_t next_to_deliver_ = 0;
+  bool stop_ = false;
+  std::vector<std::thread> threads_;
+};
+
+namespace detail {
+
+// Reads the whole file into @buffer, reusing its memory.
+// \throw std::runtime_error if the file cannot be read.
+inline void readFile(const std::filesystem::path& path, std::vector<std::byte>& buffer) {
+  const std::string error_message = "imageview::readFile(): failed to read the file " + path.string();
+#if defined(_WIN32)
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  if (!stream)
+  {
+    throw std::runtime_error(error_message);
+  }
+  buffer.resize(static_cast<std::size_t>(stream.tellg()));
+  stream.seekg(0);
+  stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+  if (!stream)
+  {
+    throw std::runtime_error(error_message);
+  }
+#else
+  const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file < 0)
+  {
+    throw std::runtime_error(error_message);
+  }
+  struct stat file_info;
+  if (::fstat(file, &file_info) != 0)
+  {
+    ::close(file);
+    throw std::runtime_error(error_message);
+  }
+  buffer.resize(static_cast<std::size_t>(file_info.st_size));
+  std::size_t offset = 0;
+  while (offset < buffer.size()) {
+    const ssize_t result =
+        ::pread(file, buffer.data() + offset, buffer.size() - offset, static_cast<off_t>(offset));
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0)
+    {
+      ::close(file);
+      throw std::runtime_error(error_message);
+    }
+    offset += static_cast<std::size_t>(result);
+  }
+  ::close(file);
+#endif
+}
+
+// Decodes a QOI or BMP file into an image allocated from @pool.
+// \throw std::runtime_error if the data is not a valid QOI or BMP file.
+template <class PixelFormat>
+PooledImage<PixelFormat> decodeImage(std::span<const std::byte> data, ImagePool& pool,
+                                     const PixelFormat& pixel_format) {
+  using color_type = typename PixelFormat::color_type;
+  const auto has_signature = [data](std::string_view signature) {
+    return data.size() >= signature.size() &&
+           std::equal(signature.begin(), signature.end(), data.begin(),
+                      [](char lhs, std::byte rhs) { return static_cast<std::byte>(lhs) == rhs; });
+  };
+  if (has_signature("qoif")) {
+    const QoiHeader header = parseQoiHeader(data);
+    PooledImage<PixelFormat> image = pool.acquire(header.height, header.width, pixel_format);
+    decodeQoi(data, image.view());
+    return image;
+  }
+  if (has_signature("BM")) {
+    const BmpImage bmp(data);
+    PooledImage<PixelFormat> image = pool.acquire(bmp.height(), bmp.width(), pixel_format);
+    const ImageView<PixelFormat, true> view = image.view();
+    // The 4th byte of a 32-bit pixel is only alpha if the header says so; otherwise the image is opaque.
+    const bool has_alpha = bmp.info().has_alpha;
+    const auto convert_rows = [&bmp, view, has_alpha](auto bmp_format) {
+      using BmpPixelFormat = decltype(bmp_format);
+      for (unsigned int y = 0; y < bmp.height(); ++y) {
+        const ImageRowView<BmpPixelFormat> src = bmp.row<BmpPixelFormat>(y);
+        const ImageRowView<PixelFormat, true> dst = view.row(y);
+        for (unsigned int x = 0; x < bmp.width(); ++x) {
+          auto color = src[x];
+          if constexpr (std::is_same_v<decltype(color), RGBA32>) {
+            if (!has_alpha) {
+              color.alpha = 255;
+            }
+          }
+          if constexpr (std::is_same_v<decltype(color), color_type>) {
+            dst[x] = color;
+          } else if constexpr (std::is_same_v<color_type, RGB24>) {
+            dst[x] = RGB24(color.red, color.green, color.blue);
+          } else {
+            dst[x] = RGBA32(color.red, color.green, color.blue, 255);
+          }
+        }
+      }
+    };
+    if (bmp.info().bits_per_pixel == 24) {
+      convert_rows(PixelFormatBGR24());
+    } else {
+      convert_rows(PixelFormatBGRA32());
+    }
+    return image;
+  }
+  throw std::runtime_error("imageview::decodeImage(): unsupported file format.");
+}
+
+}  // namespace detail
+
+template <class PixelFormat>
+AsyncImageLoader<PixelFormat>::AsyncImageLoader(std::vector<std::filesystem::path> paths, ImagePool& pool,
+                                                const AsyncImageLoaderOptions& options,
+                                                const PixelFormat& pixel_format)
+    : paths_(std::move(paths)), pool_(&pool), pixel_format_(pixel_format) {
+  if (options.num_threads == 0)
+  {
+    throw std::invalid_argument("AsyncImageLoader(): num_threads cannot be 0.");
+  }
+  if (options.read_ahead == 0)
+  {
+    throw std::invalid_argument("AsyncImageLoader(): read_ahead cannot be 0.");
+  }
+  slots_.resize(options.read_ahead);
+  threads_.reserve(options.num_threads);
+  for (unsigned int i = 0; i < options.num_threads; ++i) {
+    threads_.emplace_back([this] { run(); });
+  }
+}
+
+template <class PixelFormat>
+AsyncImageLoader<PixelFormat>::~AsyncImageLoader() {
+  {
+    const std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  delivered_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+template <class PixelFormat>
+std::size_t AsyncImageLoader<PixelFormat>::size() const noexcept {
+  return paths_.size();
+}
+
+template <class PixelFormat>
+std::optional<LoadedImage<PixelFormat>> AsyncImageLoader<PixelFormat>::next() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (next_to_deliver_ == paths_.size()) {
+    return std::nullopt;
+  }
+  const std::size_t index = next_to_deliver_;
+  Slot& slot = slots_[index % slots_.size()];
+  loaded_.wait(lock, [&slot] { return slot.ready; });
+  PooledImage<PixelFormat> image = std::move(slot.image);
+  const std::exception_ptr error = std::exchange(slot.error, nullptr);
+  slot.ready = false;
+  ++next_to_deliver_;
+  lock.unlock();
+  delivered_.notify_all();
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  return LoadedImage<PixelFormat>{index, std::move(image)};
+}
+
+template <class PixelFormat>
+void AsyncImageLoader<PixelFormat>::run() {
+  std::vector<std::byte> buffer;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    // Backpressure: don't get more than slots_.size() files ahead of the consumer.
+    delivered_.wait(lock, [this] {
+      return stop_ || next_to_load_ == paths_.size() || next_to_load_ < next_to_deliver_ + slots_.size();
+    });
+    if (stop_ || next_to_load_ == paths_.size()) {
+      return;
+    }
+    const std::size_t index = next_to_load_++;
+    lock.unlock();
+    PooledImage<PixelFormat> image;
+    std::exception_ptr error;
+    try {
+      detail::readFile(paths_[index], buffer);
+      image = detail::decodeImage(std::span<const std::byte>(buffer), *pool_, pixel_format_);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    Slot& slot = slots_[index % slots_.size()];
+    slot.image = std::move(image);
+    slot.error = error;
+    slot.ready = true;
+    loaded_.notify_all();
+  }
+}
+
+}  // namespace imageview
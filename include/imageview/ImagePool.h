@@ -0,0 +1,434 @@
+#pragma once
+
+#include <imageview/ContinuousImageView.h>
+#include <imageview/ImageView.h>
+#include <imageview/IsPixelFormat.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+// Recycling of image buffers.
+//
+// Allocating a multi-megabyte frame for every image and freeing it afterwards costs a round trip to the system
+// allocator and, usually, a page fault for every page of the frame. ImagePool keeps released buffers and hands
+// them out again for images of the same size, so a steady-state video pipeline allocates no memory at all.
+//
+// Buffers are grouped into size classes by their size in bytes (height * stride * kBytesPerPixel), so images of
+// different pixel formats with the same byte size share buffers. Each size class is a fixed array of slots that
+// are taken and filled with atomic exchanges; every thread starts scanning the slots at its own position, so
+// threads that acquire and release buffers of the same size rarely touch the same slot. Neither acquire() nor the
+// destruction of a PooledImage takes a lock, unless a new buffer has to be allocated or an excess one freed.
+
+namespace imageview {
+
+class ImagePool;
+
+// Statistics of an ImagePool.
+struct ImagePoolStats {
+  // The number of buffers handed out.
+  std::size_t acquisitions = 0;
+  // The number of buffers handed out without allocating memory.
+  std::size_t hits = 0;
+  // The total size of the buffers allocated by the pool and not freed yet (both in use and cached).
+  std::size_t bytes_resident = 0;
+  // The maximum value of bytes_resident.
+  std::size_t peak_bytes_resident = 0;
+  // The total size of the cached buffers.
+  std::size_t bytes_cached = 0;
+
+  // Returns hits / acquisitions, or 0 if nothing has been acquired.
+  double hitRate() const noexcept;
+};
+
+// Image whose buffer is borrowed from an ImagePool and returned to it on destruction.
+// PooledImage is movable, but not copyable. The contents of a newly acquired image are unspecified.
+template <class PixelFormat>
+class PooledImage {
+ public:
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+
+  // Constructs an empty image that doesn't own a buffer.
+  PooledImage() = default;
+
+  PooledImage(const PooledImage&) = delete;
+  PooledImage(PooledImage&& other) noexcept;
+  PooledImage& operator=(const PooledImage&) = delete;
+  PooledImage& operator=(PooledImage&& other) noexcept;
+  ~PooledImage();
+
+  unsigned int height() const noexcept;
+
+  unsigned int width() const noexcept;
+
+  unsigned int stride() const noexcept;
+
+  // Returns true if the image has zero area, false otherwise.
+  bool empty() const noexcept;
+
+  // Returns a mutable view into the image.
+  ImageView<PixelFormat, true> view() const;
+
+  // Implicit conversion to ImageView.
+  operator ImageView<PixelFormat, true>() const;
+
+  // Implicit conversion to a read-only ImageView.
+  operator ImageView<PixelFormat, false>() const;
+
+  // Returns a mutable view into the image.
+  // \throw std::logic_error if stride() != width() and height() > 1.
+  ContinuousImageView<PixelFormat, true> continuousView() const;
+
+  // Returns the buffer to the pool, leaving this object empty.
+  void reset() noexcept;
+
+ private:
+  friend class ImagePool;
+
+  PooledImage(ImagePool* pool, std::byte* data, std::size_t size, unsigned int height, unsigned int width,
+              unsigned int stride, const PixelFormat& pixel_format) noexcept;
+
+  ImagePool* pool_ = nullptr;
+  std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+  unsigned int height_ = 0;
+  unsigned int width_ = 0;
+  unsigned int stride_ = 0;
+  PixelFormat pixel_format_;
+};
+
+// Pool of image buffers.
+// The pool must outlive all images acquired from it. All member functions are thread-safe.
+class ImagePool {
+ public:
+  // Alignment of every buffer in bytes.
+  static constexpr std::size_t kAlignment = 64;
+  // The maximum number of distinct buffer sizes that are cached. Buffers of other sizes are freed on release.
+  static constexpr std::size_t kMaxSizeClasses = 64;
+  // The maximum number of cached buffers of each size.
+  static constexpr std::size_t kSlotsPerSizeClass = 16;
+
+  // Constructs an empty pool.
+  // \param prefault - if true, every page of a newly allocated buffer is written to before the buffer is handed
+  //        out, so that the page faults happen in acquire() rather than in the code processing the image.
+  explicit ImagePool(bool prefault = true) noexcept;
+
+  ImagePool(const ImagePool&) = delete;
+  ImagePool& operator=(const ImagePool&) = delete;
+
+  // Frees the cached buffers.
+  ~ImagePool();
+
+  // Returns an image of the specified size, reusing a cached buffer if there is one.
+  // \param height - height of the image.
+  // \param width - width of the image.
+  // \param stride - the number of pixels between the beginnings of 2 consecutive rows.
+  // \param pixel_format - instance of PixelFormat to use.
+  // \throw std::invalid_argument if stride < width.
+  // \throw std::bad_alloc if memory cannot be allocated.
+  template <class PixelFormat>
+  PooledImage<PixelFormat> acquire(unsigned int height, unsigned int width, unsigned int stride,
+                                   const PixelFormat& pixel_format = PixelFormat());
+
+  // Same as acquire(height, width, width, pixel_format).
+  template <class PixelFormat>
+  PooledImage<PixelFormat> acquire(unsigned int height, unsigned int width,
+                                   const PixelFormat& pixel_format = PixelFormat());
+
+  // Frees all cached buffers. Buffers in use are not affected.
+  void trim() noexcept;
+
+  // Returns the statistics of the pool. The counters are read independently of each other, so they may be
+  // slightly inconsistent if other threads use the pool concurrently.
+  ImagePoolStats stats() const noexcept;
+
+ private:
+  template <class PixelFormat>
+  friend class PooledImage;
+
+  struct SizeClass {
+    // Size of the buffers in bytes, or 0 if the size class is not used yet.
+    std::atomic<std::size_t> size = 0;
+    // Cached buffers; nullptr means an empty slot.
+    std::array<std::atomic<std::byte*>, kSlotsPerSizeClass> slots{};
+  };
+
+  // Returns a buffer of @size bytes (@size > 0).
+  std::byte* acquireBuffer(std::size_t size);
+
+  // Returns a buffer obtained from acquireBuffer() to the pool.
+  void releaseBuffer(std::byte* data, std::size_t size) noexcept;
+
+  // Returns the size class for buffers of @size bytes, or nullptr if there is no such class and either @create is
+  // false or all classes are used.
+  SizeClass* findSizeClass(std::size_t size, bool create) noexcept;
+
+  std::byte* allocate(std::size_t size);
+
+  void deallocate(std::byte* data, std::size_t size) noexcept;
+
+  // Returns the index of the slot at which the calling thread starts scanning.
+  static std::size_t getFirstSlot() noexcept;
+
+  std::array<SizeClass, kMaxSizeClasses> size_classes_;
+  bool prefault_;
+  std::atomic<std::size_t> acquisitions_ = 0;
+  std::atomic<std::size_t> hits_ = 0;
+  std::atomic<std::size_t> bytes_resident_ = 0;
+  std::atomic<std::size_t> peak_bytes_resident_ = 0;
+  std::atomic<std::size_t> bytes_cached_ = 0;
+};
+
+inline double ImagePoolStats::hitRate() const noexcept {
+  return (acquisitions == 0) ? 0.0 : static_cast<double>(hits) / static_cast<double>(acquisitions);
+}
+
+template <class PixelFormat>
+PooledImage<PixelFormat>::PooledImage(ImagePool* pool, std::byte* data, std::size_t size, unsigned int height,
+                                      unsigned int width, unsigned int stride,
+                                      const PixelFormat& pixel_format) noexcept
+    : pool_(pool),
+      data_(data),
+      size_(size),
+      height_(height),
+      width_(width),
+      stride_(stride),
+      pixel_format_(pixel_format) {}
+
+template <class PixelFormat>
+PooledImage<PixelFormat>::PooledImage(PooledImage&& other) noexcept
+    : pool_(std::exchange(other.pool_, nullptr)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      height_(std::exchange(other.height_, 0)),
+      width_(std::exchange(other.width_, 0)),
+      stride_(std::exchange(other.stride_, 0)),
+      pixel_format_(std::move(other.pixel_format_)) {}
+
+template <class PixelFormat>
+PooledImage<PixelFormat>& PooledImage<PixelFormat>::operator=(PooledImage&& other) noexcept {
+  if (this != &other) {
+    reset();
+    pool_ = std::exchange(other.pool_, nullptr);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    height_ = std::exchange(other.height_, 0);
+    width_ = std::exchange(other.width_, 0);
+    stride_ = std::exchange(other.stride_, 0);
+    pixel_format_ = std::move(other.pixel_format_);
+  }
+  return *this;
+}
+
+template <class PixelFormat>
+PooledImage<PixelFormat>::~PooledImage() {
+  reset();
+}
+
+template <class PixelFormat>
+unsigned int PooledImage<PixelFormat>::height() const noexcept {
+  return height_;
+}
+
+template <class PixelFormat>
+unsigned int PooledImage<PixelFormat>::width() const noexcept {
+  return width_;
+}
+
+template <class PixelFormat>
+unsigned int PooledImage<PixelFormat>::stride() const noexcept {
+  return stride_;
+}
+
+template <class PixelFormat>
+bool PooledImage<PixelFormat>::empty() const noexcept {
+  return height_ == 0 || width_ == 0;
+}
+
+template <class PixelFormat>
+ImageView<PixelFormat, true> PooledImage<PixelFormat>::view() const {
+  const std::size_t data_size =
+      (height_ == 0) ? 0 : ((height_ - 1) * static_cast<std::size_t>(stride_) + width_) * PixelFormat::kBytesPerPixel;
+  return ImageView<PixelFormat, true>(height_, width_, stride_, std::span<std::byte>(data_, data_size),
+                                      pixel_format_);
+}
+
+template <class PixelFormat>
+PooledImage<PixelFormat>::operator ImageView<PixelFormat, true>() const {
+  return view();
+}
+
+template <class PixelFormat>
+PooledImage<PixelFormat>::operator ImageView<PixelFormat, false>() const {
+  return view();
+}
+
+template <class PixelFormat>
+ContinuousImageView<PixelFormat, true> PooledImage<PixelFormat>::continuousView() const {
+  if (stride_ != width_ && height_ > 1)
+  {
+    throw std::logic_error("PooledImage::continuousView(): the image has gaps between rows.");
+  }
+  return ContinuousImageView<PixelFormat, true>(
+      height_, width_,
+      std::span<std::byte>(data_, static_cast<std::size_t>(height_) * width_ * PixelFormat::kBytesPerPixel),
+      pixel_format_);
+}
+
+template <class PixelFormat>
+void PooledImage<PixelFormat>::reset() noexcept {
+  if (data_ != nullptr) {
+    pool_->releaseBuffer(data_, size_);
+  }
+  pool_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+  height_ = 0;
+  width_ = 0;
+  stride_ = 0;
+}
+
+inline ImagePool::ImagePool(bool prefault) noexcept : prefault_(prefault) {}
+
+inline ImagePool::~ImagePool() { trim(); }
+
+template <class PixelFormat>
+PooledImage<PixelFormat> ImagePool::acquire(unsigned int height, unsigned int width, unsigned int stride,
+                                            const PixelFormat& pixel_format) {
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+  if (stride < width)
+  {
+    throw std::invalid_argument("ImagePool::acquire(): stride cannot be less than width.");
+  }
+  const std::size_t size = static_cast<std::size_t>(height) * stride * PixelFormat::kBytesPerPixel;
+  std::byte* data = (size == 0) ? nullptr : acquireBuffer(size);
+  return PooledImage<PixelFormat>(this, data, size, height, width, stride, pixel_format);
+}
+
+template <class PixelFormat>
+PooledImage<PixelFormat> ImagePool::acquire(unsigned int height, unsigned int width,
+                                            const PixelFormat& pixel_format) {
+  return acquire(height, width, width, pixel_format);
+}
+
+inline void ImagePool::trim() noexcept {
+  for (SizeClass& size_class : size_classes_) {
+    const std::size_t size = size_class.size.load(std::memory_order_acquire);
+    if (size == 0) {
+      continue;
+    }
+    for (std::atomic<std::byte*>& slot : size_class.slots) {
+      if (std::byte* data = slot.exchange(nullptr, std::memory_order_acquire)) {
+        bytes_cached_.fetch_sub(size, std::memory_order_relaxed);
+        deallocate(data, size);
+      }
+    }
+  }
+}
+
+inline ImagePoolStats ImagePool::stats() const noexcept {
+  ImagePoolStats result;
+  result.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+  result.hits = hits_.load(std::memory_order_relaxed);
+  result.bytes_resident = bytes_resident_.load(std::memory_order_relaxed);
+  result.peak_bytes_resident = peak_bytes_resident_.load(std::memory_order_relaxed);
+  result.bytes_cached = bytes_cached_.load(std::memory_order_relaxed);
+  return result;
+}
+
+inline std::byte* ImagePool::acquireBuffer(std::size_t size) {
+  acquisitions_.fetch_add(1, std::memory_order_relaxed);
+  if (SizeClass* size_class = findSizeClass(size, false)) {
+    const std::size_t first_slot = getFirstSlot();
+    for (std::size_t i = 0; i < kSlotsPerSizeClass; ++i) {
+      std::atomic<std::byte*>& slot = size_class->slots[(first_slot + i) % kSlotsPerSizeClass];
+      if (slot.load(std::memory_order_relaxed) == nullptr) {
+        continue;
+      }
+      if (std::byte* data = slot.exchange(nullptr, std::memory_order_acquire)) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        bytes_cached_.fetch_sub(size, std::memory_order_relaxed);
+        return data;
+      }
+    }
+  }
+  return allocate(size);
+}
+
+inline void ImagePool::releaseBuffer(std::byte* data, std::size_t size) noexcept {
+  if (SizeClass* size_class = findSizeClass(size, true)) {
+    // Account for the buffer before publishing it: once the CAS succeeds, another thread may take the buffer and
+    // subtract its size from bytes_cached_, and the counter must never go below 0. The release CAS makes this
+    // addition happen before the subtraction by whoever acquires the buffer.
+    bytes_cached_.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t first_slot = getFirstSlot();
+    for (std::size_t i = 0; i < kSlotsPerSizeClass; ++i) {
+      std::atomic<std::byte*>& slot = size_class->slots[(first_slot + i) % kSlotsPerSizeClass];
+      std::byte* expected = nullptr;
+      if (slot.compare_exchange_strong(expected, data, std::memory_order_release, std::memory_order_relaxed)) {
+        return;
+      }
+    }
+    // Every slot is full.
+    bytes_cached_.fetch_sub(size, std::memory_order_relaxed);
+  }
+  deallocate(data, size);
+}
+
+inline ImagePool::SizeClass* ImagePool::findSizeClass(std::size_t size, bool create) noexcept {
+  // Open addressing with linear probing; size classes are never removed.
+  const std::size_t first_index = std::hash<std::size_t>()(size) % kMaxSizeClasses;
+  for (std::size_t i = 0; i < kMaxSizeClasses; ++i) {
+    SizeClass& size_class = size_classes_[(first_index + i) % kMaxSizeClasses];
+    std::size_t class_size = size_class.size.load(std::memory_order_acquire);
+    if (class_size == 0) {
+      if (!create) {
+        return nullptr;
+      }
+      if (size_class.size.compare_exchange_strong(class_size, size, std::memory_order_acq_rel)) {
+        return &size_class;
+      }
+      // Another thread has just claimed this class; class_size now holds its size.
+    }
+    if (class_size == size) {
+      return &size_class;
+    }
+  }
+  return nullptr;
+}
+
+inline std::byte* ImagePool::allocate(std::size_t size) {
+  std::byte* data = static_cast<std::byte*>(::operator new(size, std::align_val_t(kAlignment)));
+  if (prefault_) {
+    constexpr std::size_t kPageSize = 4096;
+    volatile std::byte* const pages = data;
+    for (std::size_t offset = 0; offset < size; offset += kPageSize) {
+      pages[offset] = std::byte{0};
+    }
+  }
+  const std::size_t resident = bytes_resident_.fetch_add(size, std::memory_order_relaxed) + size;
+  std::size_t peak = peak_bytes_resident_.load(std::memory_order_relaxed);
+  while (peak < resident &&
+         !peak_bytes_resident_.compare_exchange_weak(peak, resident, std::memory_order_relaxed)) {
+  }
+  return data;
+}
+
+inline void ImagePool::deallocate(std::byte* data, std::size_t size) noexcept {
+  bytes_resident_.fetch_sub(size, std::memory_order_relaxed);
+  ::operator delete(data, size, std::align_val_t(kAlignment));
+}
+
+inline std::size_t ImagePool::getFirstSlot() noexcept {
+  thread_local const std::size_t first_slot =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) % kSlotsPerSizeClass;
+  return first_slot;
+}
+
+}  // namespace imageview
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <imageview/Instrumentation.h>
 #include <imageview/IsPixelFormat.h>
 #include <imageview/internal/ImageViewIterator.h>
 #include <imageview/internal/ImageViewStorage.h>
@@ -213,6 +214,7 @@ constexpr auto ImageRowView<PixelFormat, Mutable>::operator[](std::size_t index)
   if constexpr (Mutable) {
     return detail::PixelRef<PixelFormat>(pixel_data, pixelFormat());
   } else {
+    detail::instrumentPixelRead<PixelFormat>(pixel_data.data());
     return pixelFormat().read(pixel_data);
   }
 }
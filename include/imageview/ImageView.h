@@ -1,6 +1,8 @@
 #pragma once
 
 #include <imageview/ContinuousImageView.h>
+#include <imageview/Instrumentation.h>
+#include <imageview/internal/ImageViewFlatIterator.h>
 #include <imageview/internal/ImageViewStorage.h>
 #include <imageview/internal/PixelRef.h>
 
@@ -10,6 +12,9 @@
 
 namespace imageview {
 
+template <class PixelFormat, bool Mutable>
+class ImageBatch;
+
 template <class PixelFormat, bool Mutable = false>
 class ImageView {
  public:
@@ -19,6 +24,14 @@ class ImageView {
   using value_type = typename PixelFormat::color_type;
   // TODO: consider using 'const value_type' instead of 'value_type' for immutable views.
   using reference = std::conditional_t<Mutable, detail::PixelRef<PixelFormat>, value_type>;
+  // Constant iterator over all pixels of the image in row-major order; gaps between rows are skipped.
+  // It is a segmented iterator: rowIndex(), local() and localEnd() give access to the iterators within
+  // the current row, which allows algorithms to use a tight inner loop for each row (see forEachSegment()).
+  // Like ContinuousImageView::const_iterator, it is a LegacyInputIterator that supports all arithmetic
+  // operations of LegacyRandomAccessIterator.
+  using const_iterator = detail::ImageViewFlatIterator<PixelFormat, false>;
+  // Same as const_iterator, but also models LegacyOutputIterator if Mutable == true.
+  using iterator = detail::ImageViewFlatIterator<PixelFormat, Mutable>;
 
   // Construct an empty view.
   template <class Enable = std::enable_if_t<std::is_default_constructible_v<PixelFormat>>>
@@ -68,11 +81,33 @@ class ImageView {
 
   constexpr std::span<byte_type> data() const noexcept;
 
+  // Returns an iterator to the first pixel.
+  constexpr iterator begin() const;
+
+  // Returns a const iterator to the first pixel.
+  constexpr const_iterator cbegin() const;
+
+  // Returns an iterator past the last pixel.
+  constexpr iterator end() const;
+
+  // Returns a const iterator past the last pixel.
+  constexpr const_iterator cend() const;
+
   constexpr reference operator()(unsigned int y, unsigned int x) const;
 
   constexpr ImageRowView<PixelFormat, Mutable> row(unsigned int y) const;
 
  private:
+  template <class OtherPixelFormat, bool OtherMutable>
+  friend class ImageBatch;
+
+  struct UncheckedTag {};
+
+  // Construct a view without validating the arguments; for containers that have validated them already.
+  constexpr ImageView(UncheckedTag, unsigned int height, unsigned int width, unsigned int stride, byte_type* data,
+                      const PixelFormat& pixel_format)
+      : storage_(data, pixel_format), height_(height), width_(width), stride_(stride) {}
+
   detail::ImageViewStorage<PixelFormat, Mutable> storage_;
   unsigned int height_ = 0;
   unsigned int width_ = 0;
@@ -174,6 +209,27 @@ constexpr auto ImageView<PixelFormat, Mutable>::data() const noexcept -> std::sp
   return std::span<byte_type>(storage_.data(), data_size);
 }
 
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageView<PixelFormat, Mutable>::begin() const -> iterator {
+  return iterator(storage_.data(), width_, stride_, 0, 0, pixelFormat());
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageView<PixelFormat, Mutable>::cbegin() const -> const_iterator {
+  return const_iterator(storage_.data(), width_, stride_, 0, 0, pixelFormat());
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageView<PixelFormat, Mutable>::end() const -> iterator {
+  // For an image with zero width end() must be equal to begin().
+  return iterator(storage_.data(), width_, stride_, (width_ == 0) ? 0 : height_, 0, pixelFormat());
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageView<PixelFormat, Mutable>::cend() const -> const_iterator {
+  return const_iterator(storage_.data(), width_, stride_, (width_ == 0) ? 0 : height_, 0, pixelFormat());
+}
+
 template <class PixelFormat, bool Mutable>
 constexpr auto ImageView<PixelFormat, Mutable>::operator()(unsigned int y, unsigned int x) const -> reference {
   if (y >= height_)
@@ -189,6 +245,7 @@ constexpr auto ImageView<PixelFormat, Mutable>::operator()(unsigned int y, unsig
   if constexpr (Mutable) {
     return detail::PixelRef<PixelFormat>(pixel_data, pixelFormat());
   } else {
+    detail::instrumentPixelRead<PixelFormat>(pixel_data.data());
     return pixelFormat().read(pixel_data);
   }
 }
@@ -199,9 +256,10 @@ constexpr ImageRowView<PixelFormat, Mutable> ImageView<PixelFormat, Mutable>::ro
   {
     throw std::out_of_range("ImageView::row(): y is out of range.");
   }
+  detail::instrumentRowAccess<PixelFormat>();
   const std::span<byte_type> row_data(storage_.data() + y * stride_ * PixelFormat::kBytesPerPixel,
                                       width_ * PixelFormat::kBytesPerPixel);
-  return ImageRowView<PixelFormat>(row_data, width_, pixelFormat());
+  return ImageRowView<PixelFormat, Mutable>(row_data, width_, pixelFormat());
 }
 
 }  // namespace imageview
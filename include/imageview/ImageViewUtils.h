@@ -2,7 +2,13 @@
 
 #include <imageview/ContinuousImageView.h>
 #include <imageview/ImageView.h>
+#include <imageview/IsTriviallyEncoded.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
 
 namespace imageview {
@@ -33,14 +39,90 @@ constexpr ImageView<PixelFormat, Mutable> crop(ImageView<PixelFormat, Mutable> i
   const std::size_t new_data_size =
       (num_rows == 0) ? 0 : ((num_rows - 1) * image.stride() + num_columns) * PixelFormat::kBytesPerPixel;
   const auto data_new = image.data().subspan(data_offset, new_data_size);
-  return ImageView<PixelFormat>(num_rows, num_columns, image.stride(), data_new, image.pixelFormat());
+  return ImageView<PixelFormat, Mutable>(num_rows, num_columns, image.stride(), data_new, image.pixelFormat());
 }
 
 template <class PixelFormat, bool Mutable>
 constexpr ImageView<PixelFormat, Mutable> crop(ContinuousImageView<PixelFormat, Mutable> image, unsigned int first_row,
                                                unsigned int first_column, unsigned int num_rows,
                                                unsigned int num_columns) {
-  return crop(ImageView<PixelFormat, Mutable>(image), first_column, first_column, num_rows, num_columns);
+  return crop(ImageView<PixelFormat, Mutable>(image), first_row, first_column, num_rows, num_columns);
+}
+
+// Copies pixels from one image to another.
+// If PixelFormat is trivially encoded, rows are copied via std::memcpy() (the whole bitmap at once if neither
+// image has gaps between rows). Otherwise, each pixel is copied via PixelFormat::read() and PixelFormat::write().
+// \param src - input image.
+// \param dst - output image. Must not overlap with @src.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool Mutable>
+void copy(ImageView<PixelFormat, Mutable> src, ImageView<PixelFormat, true> dst) {
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::copy(): images must have the same dimensions.");
+  }
+  if (src.empty()) {
+    return;
+  }
+  if constexpr (IsTriviallyEncoded<PixelFormat>::value) {
+    const bool src_continuous = src.stride() == src.width() || src.height() == 1;
+    const bool dst_continuous = dst.stride() == dst.width() || dst.height() == 1;
+    if (src_continuous && dst_continuous) {
+      std::memcpy(dst.data().data(), src.data().data(), src.data().size());
+      return;
+    }
+    for (unsigned int y = 0; y < src.height(); ++y) {
+      const ImageRowView<PixelFormat, Mutable> src_row = src.row(y);
+      std::memcpy(dst.row(y).data().data(), src_row.data().data(), src_row.size_bytes());
+    }
+  } else {
+    for (unsigned int y = 0; y < src.height(); ++y) {
+      const ImageRowView<PixelFormat, Mutable> src_row = src.row(y);
+      std::copy(src_row.cbegin(), src_row.cend(), dst.row(y).begin());
+    }
+  }
+}
+
+// Assigns the given color to all pixels of the image.
+// If PixelFormat is trivially encoded, the color is replicated within the first row via std::memcpy() (or
+// std::memset() for 1-byte pixels), and then the first row is copied into the remaining rows. Otherwise, each
+// pixel is written via PixelFormat::write().
+// \param image - image to fill.
+// \param color - color to assign.
+template <class PixelFormat>
+void fill(ImageView<PixelFormat, true> image, const typename PixelFormat::color_type& color) {
+  if (image.empty()) {
+    return;
+  }
+  if constexpr (IsTriviallyEncoded<PixelFormat>::value) {
+    constexpr std::size_t kBytesPerPixel = PixelFormat::kBytesPerPixel;
+    const bool continuous = image.stride() == image.width() || image.height() == 1;
+    const std::size_t row_size =
+        (continuous ? image.area() : static_cast<std::size_t>(image.width())) * kBytesPerPixel;
+    std::byte* first_row = image.data().data();
+    if constexpr (kBytesPerPixel == 1) {
+      std::memset(first_row, static_cast<int>(std::bit_cast<unsigned char>(color)), row_size);
+    } else {
+      std::memcpy(first_row, &color, kBytesPerPixel);
+      // Double the filled prefix until the whole row is filled.
+      for (std::size_t filled = kBytesPerPixel; filled < row_size;) {
+        const std::size_t count = std::min(filled, row_size - filled);
+        std::memcpy(first_row + filled, first_row, count);
+        filled += count;
+      }
+    }
+    if (continuous) {
+      return;
+    }
+    const std::size_t row_step = static_cast<std::size_t>(image.stride()) * kBytesPerPixel;
+    for (unsigned int y = 1; y < image.height(); ++y) {
+      std::memcpy(first_row + y * row_step, first_row, row_size);
+    }
+  } else {
+    for (unsigned int y = 0; y < image.height(); ++y) {
+      std::fill(image.row(y).begin(), image.row(y).end(), color);
+    }
+  }
 }
 
 }  // namespace imageview
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#ifdef IMAGEVIEW_ENABLE_INSTRUMENTATION
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <tuple>
+#include <vector>
+#endif
+
+// Opt-in instrumentation of pixel accesses.
+//
+// If the macro IMAGEVIEW_ENABLE_INSTRUMENTATION is defined before including any imageview header, then
+//   * reads of pixels via ImageView::operator(), ContinuousImageView::operator(), ImageRowView::operator[] and
+//     ImageViewIterator (including the conversion of PixelRef to color_type),
+//   * writes of pixels via PixelRef assignments,
+//   * calls to ImageView::row() and ContinuousImageView::row()
+// are recorded and attributed to the innermost active instrumentation::Scope on the current thread. Accesses
+// outside of any scope are not recorded. Scopes are created with the macro IMAGEVIEW_INSTRUMENTATION_SCOPE(),
+// which captures the call site, and are merged into per-call-site reports when they end.
+//
+// If IMAGEVIEW_ENABLE_INSTRUMENTATION is not defined, IMAGEVIEW_INSTRUMENTATION_SCOPE() expands to nothing, and
+// the hooks in the views are empty constexpr functions, so the instrumentation has no cost.
+//
+// The hooks are templates parameterized by the pixel format, so the macro must be defined consistently in every
+// translation unit that instantiates a view with the same pixel format.
+
+namespace imageview {
+
+#ifdef IMAGEVIEW_ENABLE_INSTRUMENTATION
+namespace instrumentation {
+
+// Access counters of a single call site.
+struct AccessStats {
+  // The number of pixel reads.
+  std::uint64_t reads = 0;
+  // The number of pixel writes.
+  std::uint64_t writes = 0;
+  // The number of calls to row().
+  std::uint64_t row_calls = 0;
+  // The number of bytes read.
+  std::uint64_t bytes_read = 0;
+  // The number of bytes written.
+  std::uint64_t bytes_written = 0;
+  // The number of pixel accesses that start at least kJumpThreshold bytes before or after the end of the
+  // previous access in the same scope, i.e. accesses that most likely touch a new cache line out of order.
+  std::uint64_t stride_jumps = 0;
+
+  static constexpr std::size_t kJumpThreshold = 64;
+};
+
+// Accumulated counters of a call site.
+struct CallSiteReport {
+  std::string file;
+  unsigned int line = 0;
+  std::string function;
+  AccessStats stats;
+};
+
+// RAII object attributing the accesses made on the current thread during its lifetime to its call site.
+// Use IMAGEVIEW_INSTRUMENTATION_SCOPE() rather than creating it directly.
+class Scope {
+ public:
+  explicit Scope(std::source_location location = std::source_location::current()) noexcept;
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+  ~Scope();
+
+ private:
+  std::source_location location_;
+  AccessStats stats_;
+  AccessStats* parent_;
+  // End of the previous pixel access in the parent scope, restored when this scope ends.
+  const std::byte* parent_access_end_;
+};
+
+// Returns the reports for all call sites whose scopes have ended, sorted by the number of bytes touched
+// (in descending order).
+std::vector<CallSiteReport> getReports();
+
+// Removes all reports.
+void resetReports();
+
+// Writes the reports into @stream, one call site per line.
+void printReports(std::ostream& stream);
+
+namespace detail {
+
+// Innermost active scope of the current thread, or nullptr.
+inline thread_local AccessStats* current_stats = nullptr;
+// End of the previous pixel access made in the innermost active scope of the current thread.
+inline thread_local const std::byte* previous_access_end = nullptr;
+
+struct ReportRegistry {
+  std::mutex mutex;
+  // Key: (file, line, function).
+  std::map<std::tuple<std::string, unsigned int, std::string>, AccessStats> reports;
+};
+
+inline ReportRegistry& getReportRegistry() {
+  static ReportRegistry registry;
+  return registry;
+}
+
+inline void recordPixelAccess(const std::byte* data, std::size_t num_bytes, bool is_write) noexcept {
+  AccessStats* stats = current_stats;
+  if (stats == nullptr) {
+    return;
+  }
+  if (is_write) {
+    ++stats->writes;
+    stats->bytes_written += num_bytes;
+  } else {
+    ++stats->reads;
+    stats->bytes_read += num_bytes;
+  }
+  if (previous_access_end != nullptr) {
+    const std::byte* low = std::min(data, previous_access_end);
+    const std::byte* high = std::max(data, previous_access_end);
+    if (static_cast<std::size_t>(high - low) >= AccessStats::kJumpThreshold) {
+      ++stats->stride_jumps;
+    }
+  }
+  previous_access_end = data + num_bytes;
+}
+
+inline void recordRowAccess() noexcept {
+  if (current_stats != nullptr) {
+    ++current_stats->row_calls;
+  }
+}
+
+}  // namespace detail
+
+inline Scope::Scope(std::source_location location) noexcept
+    : location_(location), parent_(detail::current_stats), parent_access_end_(detail::previous_access_end) {
+  detail::current_stats = &stats_;
+  detail::previous_access_end = nullptr;
+}
+
+inline Scope::~Scope() {
+  detail::current_stats = parent_;
+  detail::previous_access_end = parent_access_end_;
+  detail::ReportRegistry& registry = detail::getReportRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  AccessStats& total =
+      registry.reports[std::make_tuple(std::string(location_.file_name()), static_cast<unsigned int>(location_.line()),
+                                       std::string(location_.function_name()))];
+  total.reads += stats_.reads;
+  total.writes += stats_.writes;
+  total.row_calls += stats_.row_calls;
+  total.bytes_read += stats_.bytes_read;
+  total.bytes_written += stats_.bytes_written;
+  total.stride_jumps += stats_.stride_jumps;
+}
+
+inline std::vector<CallSiteReport> getReports() {
+  std::vector<CallSiteReport> result;
+  {
+    detail::ReportRegistry& registry = detail::getReportRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& [key, stats] : registry.reports) {
+      result.push_back(CallSiteReport{std::get<0>(key), std::get<1>(key), std::get<2>(key), stats});
+    }
+  }
+  std::stable_sort(result.begin(), result.end(), [](const CallSiteReport& lhs, const CallSiteReport& rhs) {
+    return lhs.stats.bytes_read + lhs.stats.bytes_written > rhs.stats.bytes_read + rhs.stats.bytes_written;
+  });
+  return result;
+}
+
+inline void resetReports() {
+  detail::ReportRegistry& registry = detail::getReportRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.reports.clear();
+}
+
+inline void printReports(std::ostream& stream) {
+  for (const CallSiteReport& report : getReports()) {
+    stream << report.file << ':' << report.line << " (" << report.function << "): reads=" << report.stats.reads
+           << " writes=" << report.stats.writes << " row_calls=" << report.stats.row_calls
+           << " bytes_read=" << report.stats.bytes_read << " bytes_written=" << report.stats.bytes_written
+           << " stride_jumps=" << report.stats.stride_jumps << '\n';
+  }
+}
+
+}  // namespace instrumentation
+
+#define IMAGEVIEW_INSTRUMENTATION_CONCAT_IMPL(a, b) a##b
+#define IMAGEVIEW_INSTRUMENTATION_CONCAT(a, b) IMAGEVIEW_INSTRUMENTATION_CONCAT_IMPL(a, b)
+// Attributes the pixel accesses made on the current thread until the end of the enclosing block to this line.
+#define IMAGEVIEW_INSTRUMENTATION_SCOPE() \
+  const ::imageview::instrumentation::Scope IMAGEVIEW_INSTRUMENTATION_CONCAT(imageview_instrumentation_scope_, \
+                                                                             __LINE__)
+#else
+#define IMAGEVIEW_INSTRUMENTATION_SCOPE()
+#endif
+
+namespace detail {
+
+// Records a read of a single pixel.
+template <class PixelFormat>
+constexpr void instrumentPixelRead([[maybe_unused]] const std::byte* pixel_data) noexcept {
+#ifdef IMAGEVIEW_ENABLE_INSTRUMENTATION
+  if (!std::is_constant_evaluated()) {
+    instrumentation::detail::recordPixelAccess(pixel_data, PixelFormat::kBytesPerPixel, false);
+  }
+#endif
+}
+
+// Records a write of a single pixel.
+template <class PixelFormat>
+constexpr void instrumentPixelWrite([[maybe_unused]] const std::byte* pixel_data) noexcept {
+#ifdef IMAGEVIEW_ENABLE_INSTRUMENTATION
+  if (!std::is_constant_evaluated()) {
+    instrumentation::detail::recordPixelAccess(pixel_data, PixelFormat::kBytesPerPixel, true);
+  }
+#endif
+}
+
+// Records a call to row().
+template <class PixelFormat>
+constexpr void instrumentRowAccess() noexcept {
+#ifdef IMAGEVIEW_ENABLE_INSTRUMENTATION
+  if (!std::is_constant_evaluated()) {
+    instrumentation::detail::recordRowAccess();
+  }
+#endif
+}
+
+}  // namespace detail
+}  // namespace imageview
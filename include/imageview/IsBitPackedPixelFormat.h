@@ -0,0 +1,56 @@
+#pragma once
+
+#include <imageview/IsPixelFormat.h>
+
+#include <type_traits>
+
+namespace imageview {
+namespace detail {
+
+template <class T, typename Enable = void>
+class HasKBitsPerPixelConstant : public std::false_type {};
+
+template <class T>
+class HasKBitsPerPixelConstant<T, std::enable_if_t<std::is_integral_v<decltype(T::kBitsPerPixel)> &&
+                                                   std::is_const_v<decltype(T::kBitsPerPixel)>>>
+    : public std::bool_constant<T::kBitsPerPixel == 1 || T::kBitsPerPixel == 2 || T::kBitsPerPixel == 4> {};
+
+template <class T, class Enable = void>
+class HasReadCode : public std::false_type {};
+
+template <class T>
+class HasReadCode<T, std::enable_if_t<std::is_same_v<typename T::color_type,
+                                                     decltype(std::declval<const T&>().read(
+                                                         std::declval<unsigned char>()))>>>
+    : public std::true_type {};
+
+template <class T, class Enable = void>
+class HasWriteCode : public std::false_type {};
+
+template <class T>
+class HasWriteCode<T, std::enable_if_t<std::is_same_v<unsigned char, decltype(std::declval<const T&>().write(
+                                                                         std::declval<const typename T::color_type&>()))>>>
+    : public std::true_type {};
+
+}  // namespace detail
+
+// Trait for pixel formats that occupy less than a byte per pixel.
+// Pixels of such formats are packed into bytes starting from the most significant bit,
+// i.e. the first pixel in a byte is stored in its highest kBitsPerPixel bits. A pixel never
+// straddles a byte boundary, hence kBitsPerPixel must divide 8.
+template <class T>
+class IsBitPackedPixelFormat : public std::conjunction<
+                                   // Has a member typedef 'color_type'.
+                                   detail::HasColorTypeTypedef<T>,
+                                   // Has an integral static member constant 'kBitsPerPixel' equal to 1, 2 or 4.
+                                   detail::HasKBitsPerPixelConstant<T>,
+                                   // Has a member function read() with the signature equivalent to
+                                   //   color_type read(unsigned char code) const;
+                                   // where the lowest kBitsPerPixel bits of @code hold the stored bits.
+                                   detail::HasReadCode<T>,
+                                   // Has a member function write() with the signature equivalent to
+                                   //   unsigned char write(const color_type&) const;
+                                   // which returns the bits to store (only the lowest kBitsPerPixel may be set).
+                                   detail::HasWriteCode<T>> {};
+
+}  // namespace imageview
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <imageview/IsPixelFormat.h>
+
+#include <type_traits>
+
+namespace imageview {
+namespace detail {
+
+template <class T, class Enable = void>
+class HasKIsTriviallyEncodedConstant : public std::false_type {};
+
+template <class T>
+class HasKIsTriviallyEncodedConstant<T, std::enable_if_t<std::is_same_v<decltype(T::kIsTriviallyEncoded), const bool>>>
+    : public std::bool_constant<T::kIsTriviallyEncoded &&
+                                std::is_trivially_copyable_v<typename T::color_type> &&
+                                sizeof(typename T::color_type) == T::kBytesPerPixel> {};
+
+}  // namespace detail
+
+// Trait for pixel formats whose read() and write() are plain byte copies of color_type, i.e.
+//   read(data) is equivalent to std::memcpy(&color, data.data(), kBytesPerPixel)
+//   write(color, data) is equivalent to std::memcpy(data.data(), &color, kBytesPerPixel)
+// Library algorithms (copy, fill, equality, hashing) use memcpy()/memcmp() on whole rows for such formats,
+// and fall back to per-pixel read()/write() otherwise.
+//
+// A PixelFormat opts in by declaring
+//   static constexpr bool kIsTriviallyEncoded = true;
+// The trait additionally requires that color_type is trivially copyable and that sizeof(color_type) equals
+// kBytesPerPixel (so that color_type has no padding bytes).
+template <class T>
+class IsTriviallyEncoded : public std::conjunction<IsPixelFormat<T>, detail::HasKIsTriviallyEncodedConstant<T>> {};
+
+}  // namespace imageview
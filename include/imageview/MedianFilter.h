@@ -0,0 +1,197 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/internal/ParallelFor.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Median filter with a square window whose cost per pixel does not depend on the radius.
+//
+// The implementation follows Perreault and Hebert, "Median Filtering in Constant Time": for every column of a tile
+// it maintains a histogram of the 2 * radius + 1 pixels in the current window rows. Moving the window one row down
+// updates each column histogram with 1 addition and 1 subtraction. Histograms are two-level (16 coarse bins of 16 fine
+// bins): moving the window one pixel to the right updates the coarse bins of the kernel histogram by adding one column
+// histogram and subtracting another, while the fine bins are updated lazily - only for the coarse bin that contains
+// the median, and only when it is needed. Finding the median takes at most 32 steps.
+//
+// The image is split into bands of rows, which are processed in parallel, and each band - into tiles of columns, so
+// that the column histograms of a tile stay in the cache. The width of a tile grows with the radius, so that the
+// columns of the context around the tile and the initialization of the kernel histogram at the start of each row
+// cost O(1) per pixel.
+
+namespace imageview {
+namespace detail {
+
+// Counters of 16 consecutive bins of a histogram.
+using MedianBins = std::array<std::uint16_t, 16>;
+
+// Histogram of 8-bit values with 16 coarse bins (the 4 high bits) and 256 fine bins (16 for each coarse bin).
+struct MedianHistogram {
+  MedianBins coarse;
+  std::array<MedianBins, 16> fine;
+};
+
+// Kernel histogram whose fine bins are updated lazily.
+struct MedianKernelHistogram {
+  MedianBins coarse;
+  std::array<MedianBins, 16> fine;
+  // For each coarse bin, the column of the window at which its fine bins were last brought up to date.
+  std::array<int, 16> updated_at;
+};
+
+inline void addToHistogram(MedianHistogram& histogram, unsigned char value) noexcept {
+  ++histogram.coarse[value >> 4];
+  ++histogram.fine[value >> 4][value & 15];
+}
+
+inline void removeFromHistogram(MedianHistogram& histogram, unsigned char value) noexcept {
+  --histogram.coarse[value >> 4];
+  --histogram.fine[value >> 4][value & 15];
+}
+
+// Returns bins + added - removed.
+// The arguments are passed by value, so that the compiler knows that they don't alias and vectorizes the loop.
+inline MedianBins updateBins(MedianBins bins, const MedianBins& added, const MedianBins& removed) noexcept {
+  for (std::size_t i = 0; i < 16; ++i) {
+    bins[i] += added[i] - removed[i];
+  }
+  return bins;
+}
+
+// Returns bins + other.
+inline MedianBins addBins(MedianBins bins, const MedianBins& other) noexcept {
+  for (std::size_t i = 0; i < 16; ++i) {
+    bins[i] += other[i];
+  }
+  return bins;
+}
+
+// Returns the index of the bin that contains the element of rank @rank (0-based), and subtracts the number of
+// elements in the preceding bins from @rank.
+inline unsigned int findBin(const MedianBins& bins, unsigned int& rank) noexcept {
+  unsigned int index = 0;
+  while (bins[index] <= rank) {
+    rank -= bins[index];
+    ++index;
+  }
+  return index;
+}
+
+// Applies the median filter to the rows [first_row; last_row) of @src.
+template <class PixelFormat, bool Mutable>
+void medianFilterBand(ImageView<PixelFormat, Mutable> src, ImageView<PixelFormat, true> dst, unsigned int radius,
+                      unsigned int first_row, unsigned int last_row) {
+  constexpr std::size_t kChannels = PixelFormat::kBytesPerPixel;
+  // The minimum number of columns in a tile.
+  constexpr unsigned int kMinTileWidth = 64;
+  const int tile_width = static_cast<int>(std::max(kMinTileWidth, 8 * radius));
+  const int height = static_cast<int>(src.height());
+  const int width = static_cast<int>(src.width());
+  const int r = static_cast<int>(radius);
+  const unsigned int rank = (2 * radius + 1) * (2 * radius + 1) / 2;
+  const auto clamp_row = [height](int y) { return static_cast<unsigned int>(std::clamp(y, 0, height - 1)); };
+  const ImageView<PixelFormat> input(src);
+  std::vector<MedianHistogram> columns;
+  for (int tile_first = 0; tile_first < width; tile_first += tile_width) {
+    const int tile_last = std::min(width, tile_first + tile_width);
+    // Column histograms are kept for the columns [first_column; last_column), which cover the tile and its context.
+    const int first_column = std::max(0, tile_first - r);
+    const int last_column = std::min(width, tile_last + r);
+    columns.assign(static_cast<std::size_t>(last_column - first_column) * kChannels, MedianHistogram{});
+    const auto for_each_sample = [&](unsigned int y, auto function) {
+      const unsigned char* row = getRowData(input, y) + first_column * kChannels;
+      for (std::size_t i = 0; i < columns.size(); ++i) {
+        function(columns[i], row[i]);
+      }
+    };
+    for (int dy = -r; dy <= r; ++dy) {
+      for_each_sample(clamp_row(static_cast<int>(first_row) + dy), addToHistogram);
+    }
+    for (unsigned int y = first_row; y < last_row; ++y) {
+      if (y != first_row) {
+        for_each_sample(clamp_row(static_cast<int>(y) - r - 1), removeFromHistogram);
+        for_each_sample(clamp_row(static_cast<int>(y) + r), addToHistogram);
+      }
+      unsigned char* dst_row = getRowData(dst, y);
+      for (std::size_t channel = 0; channel < kChannels; ++channel) {
+        // Returns the histogram of the channel @channel of the column clamp(x).
+        const auto column = [&](int x) -> const MedianHistogram& {
+          const int clamped_x = std::clamp(x, 0, width - 1);
+          return columns[(clamped_x - first_column) * kChannels + channel];
+        };
+        // Kernel histogram for the window centered at (y, tile_first). The fine bins are not computed yet: marking
+        // them as updated more than 2 * radius + 1 columns ago forces the first lookup to recompute them.
+        MedianKernelHistogram kernel{};
+        kernel.updated_at.fill(tile_first - 2 * r - 2);
+        for (int x = tile_first - r; x <= tile_first + r; ++x) {
+          kernel.coarse = addBins(kernel.coarse, column(x).coarse);
+        }
+        for (int x = tile_first; x < tile_last; ++x) {
+          if (x != tile_first) {
+            kernel.coarse = updateBins(kernel.coarse, column(x + r).coarse, column(x - r - 1).coarse);
+          }
+          unsigned int remaining = rank;
+          const unsigned int bin = findBin(kernel.coarse, remaining);
+          // Bring the fine bins of the coarse bin @bin up to date, either by replaying the columns that entered and
+          // left the window since the last update, or by summing the 2 * radius + 1 columns, whichever is cheaper.
+          const int last_update = kernel.updated_at[bin];
+          MedianBins fine{};
+          if (2 * (x - last_update) > 2 * r + 1) {
+            for (int xx = x - r; xx <= x + r; ++xx) {
+              fine = addBins(fine, column(xx).fine[bin]);
+            }
+          } else {
+            fine = kernel.fine[bin];
+            for (int xx = last_update + 1; xx <= x; ++xx) {
+              fine = updateBins(fine, column(xx + r).fine[bin], column(xx - r - 1).fine[bin]);
+            }
+          }
+          kernel.fine[bin] = fine;
+          kernel.updated_at[bin] = x;
+          const unsigned int value = findBin(fine, remaining);
+          dst_row[x * kChannels + channel] = static_cast<unsigned char>(bin * 16 + value);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+// Applies the median filter with a square window of size (2 * radius + 1) x (2 * radius + 1) to the image.
+// Pixels outside of the image are replaced with the nearest border pixels.
+// Each channel is filtered independently.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src and must not overlap with it.
+// \param radius - radius of the window. Must not exceed 127.
+// \param num_threads - the maximum number of threads to use (including the calling thread).
+//        0 and 1 mean that everything is done on the calling thread.
+// \throw std::invalid_argument if the images have different dimensions or @radius > 127.
+template <class PixelFormat, bool Mutable>
+void medianFilter(ImageView<PixelFormat, Mutable> src, ImageView<PixelFormat, true> dst, unsigned int radius,
+                  unsigned int num_threads = 1) {
+  static_assert(detail::HasByteChannels<PixelFormat>::value, "Only pixel formats with 8-bit channels are supported.");
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::medianFilter(): images must have the same dimensions.");
+  }
+  // Histogram bins are 16-bit.
+  if (radius > 127)
+  {
+    throw std::invalid_argument("imageview::medianFilter(): radius must not exceed 127.");
+  }
+  if (src.empty()) {
+    return;
+  }
+  detail::parallelFor(src.height(), num_threads, [&](std::size_t, std::size_t first, std::size_t last) {
+    detail::medianFilterBand(src, dst, radius, static_cast<unsigned int>(first), static_cast<unsigned int>(last));
+  });
+}
+
+}  // namespace imageview
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Grayscale morphology with rectangular structuring elements.
+//
+// All functions use the van Herk/Gil-Werman algorithm, so the cost per pixel does not depend on the size of the
+// structuring element: each 1-dimensional pass splits the (padded) line into blocks of the kernel's size, computes
+// prefix and suffix minima (maxima) within each block, and combines 2 values per output pixel.
+// The vertical pass processes whole rows at a time (in blocks of columns to stay in cache), so its inner loops run
+// over contiguous memory and are vectorized by the compiler. The image is processed in bands of rows, so the scratch
+// memory is proportional to the band height plus the kernel height rather than to the image height.
+//
+// Binary masks stored as PixelFormatGrayscale8 (e.g., 0 and 255) are supported as well: erosion/dilation of such
+// masks is equivalent to binary erosion/dilation.
+//
+// The structuring element of size kernel_height x kernel_width is anchored at (kernel_height / 2, kernel_width / 2).
+// open() and close() use the reflected structuring element (anchored at ((kernel_height - 1) / 2,
+// (kernel_width - 1) / 2)) for the second pass, so that opening never brightens and closing never darkens a pixel
+// even for even kernel sizes.
+// Pixels outside of the image do not affect the result.
+
+namespace imageview {
+namespace detail {
+
+struct MorphologyMin {
+  static constexpr unsigned char kIdentity = 255;
+  static constexpr unsigned char apply(unsigned char lhs, unsigned char rhs) noexcept { return std::min(lhs, rhs); }
+};
+
+struct MorphologyMax {
+  static constexpr unsigned char kIdentity = 0;
+  static constexpr unsigned char apply(unsigned char lhs, unsigned char rhs) noexcept { return std::max(lhs, rhs); }
+};
+
+// Returns the length of the padded line for the van Herk/Gil-Werman algorithm: the line is extended by
+// kernel_size - 1 elements, and then rounded up to a multiple of kernel_size.
+constexpr std::size_t getPaddedLength(std::size_t length, std::size_t kernel_size) noexcept {
+  return (length + 2 * kernel_size - 2) / kernel_size * kernel_size;
+}
+
+// Returns the anchor of the structuring element of the given size: kernel_size / 2, or (kernel_size - 1) / 2 for the
+// reflected element.
+constexpr std::size_t getAnchor(std::size_t kernel_size, bool reflected) noexcept {
+  return reflected ? (kernel_size - 1) / 2 : kernel_size / 2;
+}
+
+// 1-dimensional pass over a single line.
+// \param src - input line of length @length.
+// \param dst - output line of length @length. May be the same as @src.
+// \param anchor - position of the output element within the structuring element; must be less than @kernel_size.
+// \param buffer - scratch buffer of at least 3 * getPaddedLength(length, kernel_size) elements.
+template <class Op>
+void morphologyLine(const unsigned char* src, unsigned char* dst, std::size_t length, std::size_t kernel_size,
+                    std::size_t anchor, unsigned char* buffer) {
+  const std::size_t padded_length = getPaddedLength(length, kernel_size);
+  unsigned char* extended = buffer;
+  unsigned char* prefix = buffer + padded_length;
+  unsigned char* suffix = buffer + 2 * padded_length;
+  std::fill_n(extended, anchor, Op::kIdentity);
+  std::copy_n(src, length, extended + anchor);
+  std::fill(extended + anchor + length, extended + padded_length, Op::kIdentity);
+  for (std::size_t block = 0; block < padded_length; block += kernel_size) {
+    prefix[block] = extended[block];
+    for (std::size_t i = block + 1; i < block + kernel_size; ++i) {
+      prefix[i] = Op::apply(prefix[i - 1], extended[i]);
+    }
+    suffix[block + kernel_size - 1] = extended[block + kernel_size - 1];
+    for (std::size_t i = block + kernel_size - 1; i > block; --i) {
+      suffix[i - 1] = Op::apply(suffix[i], extended[i - 1]);
+    }
+  }
+  for (std::size_t i = 0; i < length; ++i) {
+    dst[i] = Op::apply(suffix[i], prefix[i + kernel_size - 1]);
+  }
+}
+
+// Vertical pass over the rows [first_row; first_row + num_rows) and the columns
+// [first_column; first_column + num_columns) of the image.
+// \param rows - rows [rows_begin; rows_end) of the input image, stored contiguously with @width elements per row.
+//        Must contain every row of the image that is covered by the structuring element of an output row.
+// \param dst - output buffer of @num_rows rows with @width elements per row.
+// \param anchor - position of the output element within the structuring element; must be less than @kernel_size.
+// \param buffer - scratch buffer of at least 2 * getPaddedLength(num_rows, kernel_size) * num_columns elements.
+template <class Op>
+void morphologyColumns(const unsigned char* rows, std::size_t rows_begin, std::size_t rows_end, std::size_t width,
+                       std::size_t first_row, std::size_t num_rows, std::size_t first_column,
+                       std::size_t num_columns, std::size_t kernel_size, std::size_t anchor, unsigned char* buffer,
+                       unsigned char* dst) {
+  const std::size_t padded_height = getPaddedLength(num_rows, kernel_size);
+  unsigned char* prefix = buffer;
+  unsigned char* suffix = buffer + padded_height * num_columns;
+  // Returns the row @r of the extended band (restricted to the block of columns), or nullptr if the row is outside
+  // of the image.
+  const auto extended_row = [&](std::size_t r) -> const unsigned char* {
+    if (first_row + r < rows_begin + anchor || first_row + r - anchor >= rows_end)
+    {
+      return nullptr;
+    }
+    return rows + (first_row + r - anchor - rows_begin) * width + first_column;
+  };
+  const auto assign_row = [num_columns](unsigned char* out, const unsigned char* in) {
+    if (in == nullptr)
+    {
+      std::fill_n(out, num_columns, Op::kIdentity);
+    } else {
+      std::copy_n(in, num_columns, out);
+    }
+  };
+  const auto combine_row = [num_columns](unsigned char* out, const unsigned char* prev, const unsigned char* in) {
+    if (in == nullptr)
+    {
+      std::copy_n(prev, num_columns, out);
+      return;
+    }
+    for (std::size_t x = 0; x < num_columns; ++x) {
+      out[x] = Op::apply(prev[x], in[x]);
+    }
+  };
+  for (std::size_t block = 0; block < padded_height; block += kernel_size) {
+    assign_row(prefix + block * num_columns, extended_row(block));
+    for (std::size_t r = block + 1; r < block + kernel_size; ++r) {
+      combine_row(prefix + r * num_columns, prefix + (r - 1) * num_columns, extended_row(r));
+    }
+    const std::size_t last = block + kernel_size - 1;
+    assign_row(suffix + last * num_columns, extended_row(last));
+    for (std::size_t r = last; r > block; --r) {
+      combine_row(suffix + (r - 1) * num_columns, suffix + r * num_columns, extended_row(r - 1));
+    }
+  }
+  for (std::size_t y = 0; y < num_rows; ++y) {
+    const unsigned char* lhs = suffix + y * num_columns;
+    const unsigned char* rhs = prefix + (y + kernel_size - 1) * num_columns;
+    unsigned char* out = dst + y * width + first_column;
+    for (std::size_t x = 0; x < num_columns; ++x) {
+      out[x] = Op::apply(lhs[x], rhs[x]);
+    }
+  }
+}
+
+// Applies the separable rectangular filter Op to @src and stores the result in @dst.
+// \param reflected - if true, the reflected structuring element is used.
+template <class Op, bool Mutable>
+void morphology(ImageView<PixelFormatGrayscale8, Mutable> src, ImageView<PixelFormatGrayscale8, true> dst,
+                unsigned int kernel_height, unsigned int kernel_width, bool reflected, const char* function_name) {
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument(std::string("imageview::") + function_name +
+                                "(): images must have the same dimensions.");
+  }
+  if (kernel_height == 0 || kernel_width == 0)
+  {
+    throw std::invalid_argument(std::string("imageview::") + function_name + "(): kernel size must be positive.");
+  }
+  if (src.empty()) {
+    return;
+  }
+  // The number of columns processed at once by the vertical pass.
+  constexpr std::size_t kColumnBlockSize = 256;
+  // The minimum number of output rows computed at once; the bands are made taller for tall kernels, so that the rows
+  // shared by adjacent bands are a small fraction of the work.
+  constexpr std::size_t kMinBandHeight = 64;
+  const std::size_t height = src.height();
+  const std::size_t width = src.width();
+  const std::size_t anchor = getAnchor(kernel_height, reflected);
+  const std::size_t rows_below = kernel_height - 1 - anchor;
+  const std::size_t column_block_size = std::min(width, kColumnBlockSize);
+  const std::size_t band_height = std::min(height, std::max(kMinBandHeight, 4 * std::size_t{kernel_height}));
+  std::vector<unsigned char> buffer(std::max(2 * getPaddedLength(band_height, kernel_height) * column_block_size,
+                                             3 * getPaddedLength(width, kernel_width)));
+  // Input rows of the current band (including the rows above and below it covered by the structuring element).
+  // @dst may be the same image as @src, so the rows shared with the next band are kept here rather than re-read.
+  std::vector<unsigned char> rows(std::min(height, band_height + kernel_height - 1) * width);
+  // Output of the vertical pass for the current band.
+  std::vector<unsigned char> columns(band_height * width);
+  std::size_t rows_begin = 0;
+  std::size_t rows_end = 0;
+  for (std::size_t first_row = 0; first_row < height; first_row += band_height) {
+    const std::size_t num_rows = std::min(band_height, height - first_row);
+    const std::size_t new_rows_begin = first_row - std::min(first_row, anchor);
+    const std::size_t new_rows_end = std::min(height, first_row + num_rows + rows_below);
+    // Rows [new_rows_begin; rows_end) were read before @dst was written, and are still needed.
+    const std::size_t kept_rows_end = std::max(new_rows_begin, rows_end);
+    std::copy(rows.begin() + (new_rows_begin - rows_begin) * width, rows.begin() + (kept_rows_end - rows_begin) * width,
+              rows.begin());
+    for (std::size_t y = kept_rows_end; y < new_rows_end; ++y) {
+      const std::byte* src_row = src.row(static_cast<unsigned int>(y)).data().data();
+      std::copy_n(reinterpret_cast<const unsigned char*>(src_row), width,
+                  rows.begin() + (y - new_rows_begin) * width);
+    }
+    rows_begin = new_rows_begin;
+    rows_end = new_rows_end;
+    for (std::size_t x = 0; x < width; x += column_block_size) {
+      morphologyColumns<Op>(rows.data(), rows_begin, rows_end, width, first_row, num_rows, x,
+                            std::min(column_block_size, width - x), kernel_height, anchor, buffer.data(),
+                            columns.data());
+    }
+    for (std::size_t y = 0; y < num_rows; ++y) {
+      unsigned char* dst_row =
+          reinterpret_cast<unsigned char*>(dst.row(static_cast<unsigned int>(first_row + y)).data().data());
+      morphologyLine<Op>(columns.data() + y * width, dst_row, width, kernel_width,
+                         getAnchor(kernel_width, reflected), buffer.data());
+    }
+  }
+}
+
+}  // namespace detail
+
+// Computes the grayscale erosion (the minimum over the structuring element) of the image.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src. May be the same image as @src.
+// \param kernel_height - height of the structuring element.
+// \param kernel_width - width of the structuring element.
+// \throw std::invalid_argument if the images have different dimensions or the kernel size is 0.
+template <bool Mutable>
+void erode(ImageView<PixelFormatGrayscale8, Mutable> src, ImageView<PixelFormatGrayscale8, true> dst,
+           unsigned int kernel_height, unsigned int kernel_width) {
+  detail::morphology<detail::MorphologyMin>(src, dst, kernel_height, kernel_width, false, "erode");
+}
+
+// Computes the grayscale dilation (the maximum over the structuring element) of the image.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src. May be the same image as @src.
+// \param kernel_height - height of the structuring element.
+// \param kernel_width - width of the structuring element.
+// \throw std::invalid_argument if the images have different dimensions or the kernel size is 0.
+template <bool Mutable>
+void dilate(ImageView<PixelFormatGrayscale8, Mutable> src, ImageView<PixelFormatGrayscale8, true> dst,
+            unsigned int kernel_height, unsigned int kernel_width) {
+  detail::morphology<detail::MorphologyMax>(src, dst, kernel_height, kernel_width, false, "dilate");
+}
+
+// Computes the morphological opening (erosion followed by dilation) of the image.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src. May be the same image as @src.
+// \param kernel_height - height of the structuring element.
+// \param kernel_width - width of the structuring element.
+// \throw std::invalid_argument if the images have different dimensions or the kernel size is 0.
+template <bool Mutable>
+void open(ImageView<PixelFormatGrayscale8, Mutable> src, ImageView<PixelFormatGrayscale8, true> dst,
+          unsigned int kernel_height, unsigned int kernel_width) {
+  detail::morphology<detail::MorphologyMin>(src, dst, kernel_height, kernel_width, false, "open");
+  detail::morphology<detail::MorphologyMax>(dst, dst, kernel_height, kernel_width, true, "open");
+}
+
+// Computes the morphological closing (dilation followed by erosion) of the image.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src. May be the same image as @src.
+// \param kernel_height - height of the structuring element.
+// \param kernel_width - width of the structuring element.
+// \throw std::invalid_argument if the images have different dimensions or the kernel size is 0.
+template <bool Mutable>
+void close(ImageView<PixelFormatGrayscale8, Mutable> src, ImageView<PixelFormatGrayscale8, true> dst,
+           unsigned int kernel_height, unsigned int kernel_width) {
+  detail::morphology<detail::MorphologyMax>(src, dst, kernel_height, kernel_width, false, "close");
+  detail::morphology<detail::MorphologyMin>(dst, dst, kernel_height, kernel_width, true, "close");
+}
+
+}  // namespace imageview
@@ -0,0 +1,378 @@
+#pragma once
+
+#include <imageview/ImageRowView.h>
+#include <imageview/ImageView.h>
+#include <imageview/IsPixelFormat.h>
+#include <imageview/internal/ParallelFor.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Streaming execution of row-based image processing pipelines.
+//
+// A pipeline is a chain of stages (e.g., convert -> blur -> threshold). Each stage computes one row of its output
+// from a few neighbouring rows of its input. Instead of materializing a full-frame intermediate image after every
+// stage, Pipeline::run() pushes rows through small ring buffers: stage K only keeps as many rows of its output as
+// stage K + 1 needs to compute a single row. Stages without vertical context (point-wise stages) get one-row buffers,
+// so chains of such stages are effectively fused row by row and their intermediate data never leaves the cache.
+//
+// Example:
+//   const Pipeline pipeline(
+//     makePipelineStage<PixelFormatRGB24, PixelFormatGrayscale8>(0, 0, toGrayscale),
+//     makePipelineStage<PixelFormatGrayscale8, PixelFormatGrayscale8>(1, 1, blur3x3),
+//     makePipelineStage<PixelFormatGrayscale8, PixelFormatGrayscale8>(0, 0, threshold));
+//   pipeline.run(src, dst, std::thread::hardware_concurrency());
+
+namespace imageview {
+
+// Read-only window into the input of a pipeline stage, centered at the row being computed.
+template <class PixelFormat>
+class RowWindow {
+ public:
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+
+  // Constructs a window.
+  // \param rows - the rows stored in memory. Row y of the image is stored at rows.row(y % rows.height()).
+  // \param image_height - the height of the whole image.
+  // \param y - the index of the central row; must be less than @image_height.
+  // \param rows_above - the number of rows above @y that are accessible.
+  // \param rows_below - the number of rows below @y that are accessible.
+  constexpr RowWindow(ImageView<PixelFormat> rows, unsigned int image_height, unsigned int y, unsigned int rows_above,
+                      unsigned int rows_below) noexcept;
+
+  // Returns the index of the central row.
+  constexpr unsigned int rowIndex() const noexcept;
+
+  // Returns the height of the whole image.
+  constexpr unsigned int imageHeight() const noexcept;
+
+  // Returns the width of the image.
+  constexpr unsigned int width() const noexcept;
+
+  // Returns the row rowIndex() + dy.
+  // Rows outside of the image are clamped to the nearest border row, i.e. the border is replicated.
+  // \param dy - offset of the row; must be within [-rows_above; rows_below].
+  // \throw std::out_of_range if @dy is outside [-rows_above; rows_below].
+  constexpr ImageRowView<PixelFormat> row(int dy) const;
+
+ private:
+  ImageView<PixelFormat> rows_;
+  unsigned int image_height_;
+  unsigned int y_;
+  unsigned int rows_above_;
+  unsigned int rows_below_;
+};
+
+// A single stage of a Pipeline.
+// \param InputFormat - pixel format of the input of this stage.
+// \param OutputFormat - pixel format of the output of this stage.
+// \param Function - function object with the signature equivalent to
+//          void function(const RowWindow<InputFormat>& input, ImageRowView<OutputFormat, true> output);
+//        It should compute the row input.rowIndex() of the output. It may be invoked concurrently from
+//        several threads, and must not throw exceptions if the pipeline is run on more than 1 thread.
+template <class InputFormat, class OutputFormat, class Function>
+class PipelineStage {
+ public:
+  static_assert(IsPixelFormat<InputFormat>::value, "InputFormat is not a PixelFormat.");
+  static_assert(IsPixelFormat<OutputFormat>::value, "OutputFormat is not a PixelFormat.");
+
+  using input_format = InputFormat;
+  using output_format = OutputFormat;
+
+  // Constructs a stage.
+  // \param rows_above - the number of input rows above the current row needed to compute a row of the output.
+  // \param rows_below - the number of input rows below the current row needed to compute a row of the output.
+  // \param function - function that computes a single row of the output.
+  // \param output_format - instance of OutputFormat to use for the output.
+  constexpr PipelineStage(unsigned int rows_above, unsigned int rows_below, Function function,
+                          const OutputFormat& output_format = OutputFormat());
+
+  // Returns the number of input rows above the current row needed to compute a row of the output.
+  constexpr unsigned int rowsAbove() const noexcept;
+
+  // Returns the number of input rows below the current row needed to compute a row of the output.
+  constexpr unsigned int rowsBelow() const noexcept;
+
+  // Returns the pixel format of the output.
+  constexpr const OutputFormat& outputFormat() const noexcept;
+
+  // Computes the row input.rowIndex() of the output.
+  constexpr void operator()(const RowWindow<InputFormat>& input, ImageRowView<OutputFormat, true> output) const;
+
+ private:
+  unsigned int rows_above_;
+  unsigned int rows_below_;
+  Function function_;
+  OutputFormat output_format_;
+};
+
+// Convenience function for constructing a PipelineStage with explicitly specified pixel formats.
+template <class InputFormat, class OutputFormat, class Function>
+constexpr PipelineStage<InputFormat, OutputFormat, Function> makePipelineStage(unsigned int rows_above,
+                                                                               unsigned int rows_below,
+                                                                               Function function) {
+  return PipelineStage<InputFormat, OutputFormat, Function>(rows_above, rows_below, std::move(function));
+}
+
+// Chain of PipelineStages.
+// The output format of each stage must be the same as the input format of the next one.
+template <class... Stages>
+class Pipeline {
+ public:
+  static_assert(sizeof...(Stages) > 0, "Pipeline must have at least 1 stage.");
+
+  static constexpr std::size_t kNumStages = sizeof...(Stages);
+
+  using input_format = typename std::tuple_element_t<0, std::tuple<Stages...>>::input_format;
+  using output_format = typename std::tuple_element_t<kNumStages - 1, std::tuple<Stages...>>::output_format;
+
+  constexpr explicit Pipeline(Stages... stages);
+
+  // Returns the number of extra rows above a band of the output that have to be computed by the stage @stage.
+  // For the last stage it is 0.
+  constexpr unsigned int contextAbove(std::size_t stage) const noexcept;
+
+  // Returns the number of extra rows below a band of the output that have to be computed by the stage @stage.
+  // For the last stage it is 0.
+  constexpr unsigned int contextBelow(std::size_t stage) const noexcept;
+
+  // Runs the pipeline.
+  // The rows of @dst are split into min(dst.height(), num_threads) bands, which are processed independently.
+  // Each band is streamed through its own set of ring buffers, holding
+  //   stage[k + 1].rowsAbove() + stage[k + 1].rowsBelow() + 1
+  // rows of the output of the stage k. Rows within contextAbove(k)/contextBelow(k) of the band's borders are
+  // computed by both neighbouring bands.
+  // \param src - input image.
+  // \param dst - output image. Must have the same dimensions as @src.
+  // \param num_threads - the maximum number of threads to use (including the calling thread).
+  //        0 and 1 mean that everything is done on the calling thread.
+  // \throw std::invalid_argument if @src and @dst have different dimensions.
+  void run(ImageView<input_format> src, ImageView<output_format, true> dst, unsigned int num_threads = 1) const;
+
+ private:
+  // Rows of the output of a single stage that are kept in memory while a band is processed.
+  template <class PixelFormat>
+  struct RingBuffer {
+    RingBuffer(unsigned int capacity, unsigned int width, unsigned int first_row, const PixelFormat& pixel_format);
+
+    // Returns a view into the stored rows; the row y is stored at index y % capacity.
+    // The view is built on each call, so that it stays valid when the buffer is moved.
+    ImageView<PixelFormat, true> rows();
+
+    std::vector<std::byte> data;
+    unsigned int capacity;
+    unsigned int width;
+    PixelFormat pixel_format;
+    // Index of the next row to compute.
+    unsigned int next_row;
+  };
+
+  using BandState = std::tuple<RingBuffer<typename Stages::output_format>...>;
+
+  template <std::size_t... K>
+  BandState makeBandState(unsigned int width, unsigned int first_row, unsigned int height,
+                          std::index_sequence<K...>) const;
+
+  // Computes the row @y of the output of the stage @K.
+  template <std::size_t K>
+  void computeRow(BandState& state, ImageView<input_format> src, ImageView<output_format, true> dst,
+                  unsigned int y) const;
+
+  void runBand(ImageView<input_format> src, ImageView<output_format, true> dst, unsigned int first_row,
+               unsigned int last_row) const;
+
+  std::tuple<Stages...> stages_;
+  std::array<unsigned int, kNumStages> rows_above_;
+  std::array<unsigned int, kNumStages> rows_below_;
+};
+
+template <class PixelFormat>
+constexpr RowWindow<PixelFormat>::RowWindow(ImageView<PixelFormat> rows, unsigned int image_height, unsigned int y,
+                                            unsigned int rows_above, unsigned int rows_below) noexcept
+    : rows_(rows), image_height_(image_height), y_(y), rows_above_(rows_above), rows_below_(rows_below) {}
+
+template <class PixelFormat>
+constexpr unsigned int RowWindow<PixelFormat>::rowIndex() const noexcept {
+  return y_;
+}
+
+template <class PixelFormat>
+constexpr unsigned int RowWindow<PixelFormat>::imageHeight() const noexcept {
+  return image_height_;
+}
+
+template <class PixelFormat>
+constexpr unsigned int RowWindow<PixelFormat>::width() const noexcept {
+  return rows_.width();
+}
+
+template <class PixelFormat>
+constexpr ImageRowView<PixelFormat> RowWindow<PixelFormat>::row(int dy) const {
+  if (dy < -static_cast<int>(rows_above_) || dy > static_cast<int>(rows_below_))
+  {
+    throw std::out_of_range("RowWindow::row(): dy is out of range.");
+  }
+  const int y = std::clamp(static_cast<int>(y_) + dy, 0, static_cast<int>(image_height_) - 1);
+  return rows_.row(static_cast<unsigned int>(y) % rows_.height());
+}
+
+template <class InputFormat, class OutputFormat, class Function>
+constexpr PipelineStage<InputFormat, OutputFormat, Function>::PipelineStage(unsigned int rows_above,
+                                                                            unsigned int rows_below,
+                                                                            Function function,
+                                                                            const OutputFormat& output_format)
+    : rows_above_(rows_above), rows_below_(rows_below), function_(std::move(function)), output_format_(output_format) {}
+
+template <class InputFormat, class OutputFormat, class Function>
+constexpr unsigned int PipelineStage<InputFormat, OutputFormat, Function>::rowsAbove() const noexcept {
+  return rows_above_;
+}
+
+template <class InputFormat, class OutputFormat, class Function>
+constexpr unsigned int PipelineStage<InputFormat, OutputFormat, Function>::rowsBelow() const noexcept {
+  return rows_below_;
+}
+
+template <class InputFormat, class OutputFormat, class Function>
+constexpr const OutputFormat& PipelineStage<InputFormat, OutputFormat, Function>::outputFormat() const noexcept {
+  return output_format_;
+}
+
+template <class InputFormat, class OutputFormat, class Function>
+constexpr void PipelineStage<InputFormat, OutputFormat, Function>::operator()(
+    const RowWindow<InputFormat>& input, ImageRowView<OutputFormat, true> output) const {
+  function_(input, output);
+}
+
+template <class... Stages>
+constexpr Pipeline<Stages...>::Pipeline(Stages... stages)
+    : stages_(std::move(stages)...), rows_above_{}, rows_below_{} {
+  static_assert(
+      []<std::size_t... K>(std::index_sequence<K...>) {
+        return (std::is_same_v<typename std::tuple_element_t<K, std::tuple<Stages...>>::output_format,
+                               typename std::tuple_element_t<K + 1, std::tuple<Stages...>>::input_format> &&
+                ...);
+      }(std::make_index_sequence<kNumStages - 1>()),
+      "The output format of each stage must be the same as the input format of the next stage.");
+  std::apply(
+      [this](const Stages&... stage) {
+        rows_above_ = {stage.rowsAbove()...};
+        rows_below_ = {stage.rowsBelow()...};
+      },
+      stages_);
+}
+
+template <class... Stages>
+constexpr unsigned int Pipeline<Stages...>::contextAbove(std::size_t stage) const noexcept {
+  unsigned int result = 0;
+  for (std::size_t k = stage + 1; k < kNumStages; ++k) {
+    result += rows_above_[k];
+  }
+  return result;
+}
+
+template <class... Stages>
+constexpr unsigned int Pipeline<Stages...>::contextBelow(std::size_t stage) const noexcept {
+  unsigned int result = 0;
+  for (std::size_t k = stage + 1; k < kNumStages; ++k) {
+    result += rows_below_[k];
+  }
+  return result;
+}
+
+template <class... Stages>
+template <class PixelFormat>
+Pipeline<Stages...>::RingBuffer<PixelFormat>::RingBuffer(unsigned int capacity, unsigned int width,
+                                                         unsigned int first_row, const PixelFormat& pixel_format)
+    : data(static_cast<std::size_t>(capacity) * width * PixelFormat::kBytesPerPixel),
+      capacity(capacity),
+      width(width),
+      pixel_format(pixel_format),
+      next_row(first_row) {}
+
+template <class... Stages>
+template <class PixelFormat>
+ImageView<PixelFormat, true> Pipeline<Stages...>::RingBuffer<PixelFormat>::rows() {
+  return ImageView<PixelFormat, true>(capacity, width, width, data, pixel_format);
+}
+
+template <class... Stages>
+template <std::size_t... K>
+auto Pipeline<Stages...>::makeBandState(unsigned int width, unsigned int first_row, unsigned int height,
+                                        std::index_sequence<K...>) const -> BandState {
+  // The last stage writes directly into the output image, so it doesn't need a ring buffer.
+  const auto capacity = [this, height](std::size_t k) -> unsigned int {
+    if (k + 1 == kNumStages)
+    {
+      return 0;
+    }
+    return std::min(rows_above_[k + 1] + rows_below_[k + 1] + 1, height);
+  };
+  const auto band_first_row = [this, first_row](std::size_t k) -> unsigned int {
+    return first_row - std::min(first_row, contextAbove(k));
+  };
+  return BandState(RingBuffer<typename Stages::output_format>(capacity(K), width, band_first_row(K),
+                                                              std::get<K>(stages_).outputFormat())...);
+}
+
+template <class... Stages>
+template <std::size_t K>
+void Pipeline<Stages...>::computeRow(BandState& state, ImageView<input_format> src,
+                                     ImageView<output_format, true> dst, unsigned int y) const {
+  const auto& stage = std::get<K>(stages_);
+  const unsigned int height = src.height();
+  using StageInputFormat = typename std::tuple_element_t<K, std::tuple<Stages...>>::input_format;
+  const auto input_rows = [&]() -> ImageView<StageInputFormat> {
+    if constexpr (K == 0) {
+      return src;
+    } else {
+      // Make sure that the previous stage has computed all rows this one needs.
+      auto& input = std::get<K - 1>(state);
+      const unsigned int last_needed_row = std::min(y + rows_below_[K], height - 1);
+      for (; input.next_row <= last_needed_row; ++input.next_row) {
+        computeRow<K - 1>(state, src, dst, input.next_row);
+      }
+      return input.rows();
+    }
+  }();
+  const RowWindow<StageInputFormat> window(input_rows, height, y, rows_above_[K], rows_below_[K]);
+  if constexpr (K + 1 == kNumStages) {
+    stage(window, dst.row(y));
+  } else {
+    const auto output_rows = std::get<K>(state).rows();
+    stage(window, output_rows.row(y % output_rows.height()));
+  }
+}
+
+template <class... Stages>
+void Pipeline<Stages...>::runBand(ImageView<input_format> src, ImageView<output_format, true> dst,
+                                  unsigned int first_row, unsigned int last_row) const {
+  BandState state = makeBandState(src.width(), first_row, src.height(), std::index_sequence_for<Stages...>());
+  for (unsigned int y = first_row; y < last_row; ++y) {
+    computeRow<kNumStages - 1>(state, src, dst, y);
+  }
+}
+
+template <class... Stages>
+void Pipeline<Stages...>::run(ImageView<input_format> src, ImageView<output_format, true> dst,
+                              unsigned int num_threads) const {
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::Pipeline::run(): src and dst must have the same dimensions.");
+  }
+  if (src.height() == 0 || src.width() == 0)
+  {
+    return;
+  }
+  detail::parallelFor(src.height(), num_threads, [&](std::size_t, std::size_t first, std::size_t last) {
+    runBand(src, dst, static_cast<unsigned int>(first), static_cast<unsigned int>(last));
+  });
+}
+
+}  // namespace imageview
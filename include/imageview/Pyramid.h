@@ -0,0 +1,259 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/internal/ByteChannels.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Image pyramids: sequences of images where every image is the previous one downsampled by 2 in each dimension.
+//
+// All levels are computed in a single streaming pass: as soon as the rows that a row of level k + 1 depends on
+// have been written to level k, that row is computed. Thus, a row of level k is consumed while it is still in
+// the cache, and no level is re-read from memory after it has been completed. All downsampled levels share one
+// contiguous allocation.
+//
+// Level k + 1 of a level of size height x width has size ceil(height / 2) x ceil(width / 2). Pixels outside of
+// the image are replaced with the nearest border pixels.
+
+namespace imageview {
+
+// Filter used to downsample each level of a pyramid.
+enum class PyramidMode {
+  // Each pixel is the mean of a 2x2 block.
+  kBox2x2,
+  // Each pixel is computed with the separable 5x5 kernel [1 4 6 4 1] / 16 centered at the pixel (2y, 2x).
+  kGaussian5,
+};
+
+// Image pyramid with 8-bit channels.
+// Level 0 is the source image; the pyramid does not own it, so it must outlive the pyramid.
+// ImagePyramid is movable, but not copyable.
+template <class PixelFormat>
+class ImagePyramid {
+ public:
+  static_assert(detail::HasByteChannels<PixelFormat>::value, "Only pixel formats with 8-bit channels are supported.");
+
+  // Constructs an empty pyramid.
+  ImagePyramid() = default;
+
+  // Builds a pyramid.
+  // \param src - source image (level 0).
+  // \param num_levels - the number of levels, including level 0. Must be positive.
+  // \param mode - filter used for downsampling.
+  // \throw std::invalid_argument if @num_levels is 0.
+  ImagePyramid(ImageView<PixelFormat> src, std::size_t num_levels, PyramidMode mode);
+
+  ImagePyramid(const ImagePyramid&) = delete;
+  ImagePyramid(ImagePyramid&&) noexcept = default;
+  ImagePyramid& operator=(const ImagePyramid&) = delete;
+  ImagePyramid& operator=(ImagePyramid&&) noexcept = default;
+
+  // Returns the number of levels.
+  std::size_t size() const noexcept;
+
+  // Returns all levels.
+  std::span<const ImageView<PixelFormat>> levels() const noexcept;
+
+  // Returns the specified level.
+  ImageView<PixelFormat> operator[](std::size_t level) const;
+
+  // Returns the specified level.
+  // \throw std::out_of_range if @level is outside [0; size()).
+  ImageView<PixelFormat> at(std::size_t level) const;
+
+ private:
+  // Computes the row @y of the level @level and then all rows of the following levels that become computable.
+  void computeRow(std::size_t level, unsigned int y);
+
+  // Returns the last row of the level @level - 1 that the row @y of the level @level depends on.
+  unsigned int getLastInputRow(std::size_t level, unsigned int y) const noexcept;
+
+  PyramidMode mode_ = PyramidMode::kBox2x2;
+  // Storage for the levels 1, 2, ..., size() - 1.
+  std::vector<std::byte> storage_;
+  std::vector<ImageView<PixelFormat>> levels_;
+  // Mutable views into the levels 1, 2, ..., size() - 1.
+  std::vector<ImageView<PixelFormat, true>> outputs_;
+  // num_computed_rows_[k] is the number of rows of the level k computed so far.
+  std::vector<unsigned int> num_computed_rows_;
+  // Vertically filtered row with 2 pixels of padding on each side; used by PyramidMode::kGaussian5.
+  std::vector<std::uint16_t> gaussian_row_;
+};
+
+// Builds an image pyramid.
+// \param src - source image (level 0). Must outlive the returned pyramid.
+// \param num_levels - the number of levels, including level 0. Must be positive.
+// \param mode - filter used for downsampling.
+// \throw std::invalid_argument if @num_levels is 0.
+template <class PixelFormat, bool Mutable>
+ImagePyramid<PixelFormat> buildPyramid(ImageView<PixelFormat, Mutable> src, std::size_t num_levels,
+                                       PyramidMode mode) {
+  return ImagePyramid<PixelFormat>(ImageView<PixelFormat>(src), num_levels, mode);
+}
+
+namespace detail {
+
+// Downsamples 2 rows of a level into 1 row of the next level by averaging 2x2 blocks.
+// \param row0, row1 - the rows of the source level (equal if the source level has an odd height).
+// \param dst - the row of the next level.
+// \param src_width - the width of the source level.
+template <std::size_t kChannels>
+void downsampleRowsBox(const unsigned char* row0, const unsigned char* row1, unsigned char* dst,
+                       unsigned int src_width) {
+  const std::size_t num_pairs = src_width / 2;
+  for (std::size_t x = 0; x < num_pairs; ++x) {
+    for (std::size_t c = 0; c < kChannels; ++c) {
+      const std::size_t i = 2 * x * kChannels + c;
+      const unsigned int sum = row0[i] + row0[i + kChannels] + row1[i] + row1[i + kChannels];
+      dst[x * kChannels + c] = static_cast<unsigned char>((sum + 2) >> 2);
+    }
+  }
+  if (src_width % 2 != 0) {
+    for (std::size_t c = 0; c < kChannels; ++c) {
+      const std::size_t i = 2 * num_pairs * kChannels + c;
+      dst[num_pairs * kChannels + c] = static_cast<unsigned char>((2 * (row0[i] + row1[i]) + 2) >> 2);
+    }
+  }
+}
+
+// Filters 5 rows with the vertical kernel [1 4 6 4 1] and stores the sums into @dst, padded by replicating 2
+// pixels on each side.
+template <std::size_t kChannels>
+void filterRowsGaussian5(const unsigned char* const* rows, std::uint16_t* dst, unsigned int width) {
+  const std::size_t size = static_cast<std::size_t>(width) * kChannels;
+  std::uint16_t* center = dst + 2 * kChannels;
+  for (std::size_t i = 0; i < size; ++i) {
+    center[i] = static_cast<std::uint16_t>(rows[0][i] + 4 * rows[1][i] + 6 * rows[2][i] + 4 * rows[3][i] +
+                                           rows[4][i]);
+  }
+  for (std::size_t c = 0; c < kChannels; ++c) {
+    dst[c] = dst[kChannels + c] = center[c];
+    center[size + c] = center[size + kChannels + c] = center[size - kChannels + c];
+  }
+}
+
+// Applies the horizontal kernel [1 4 6 4 1] to the padded row produced by filterRowsGaussian5() at every even
+// column, and normalizes the result.
+template <std::size_t kChannels>
+void downsampleRowGaussian5(const std::uint16_t* src, unsigned char* dst, unsigned int dst_width) {
+  for (std::size_t x = 0; x < dst_width; ++x) {
+    for (std::size_t c = 0; c < kChannels; ++c) {
+      // src[i] is the column 2x - 2 of the channel c.
+      const std::size_t i = 2 * x * kChannels + c;
+      const std::uint32_t sum = src[i] + 4 * src[i + kChannels] + 6 * src[i + 2 * kChannels] +
+                                4 * src[i + 3 * kChannels] + src[i + 4 * kChannels];
+      dst[x * kChannels + c] = static_cast<unsigned char>((sum + 128) >> 8);
+    }
+  }
+}
+
+}  // namespace detail
+
+template <class PixelFormat>
+ImagePyramid<PixelFormat>::ImagePyramid(ImageView<PixelFormat> src, std::size_t num_levels, PyramidMode mode)
+    : mode_(mode) {
+  if (num_levels == 0)
+  {
+    throw std::invalid_argument("ImagePyramid(): the number of levels must be positive.");
+  }
+  constexpr std::size_t kBytesPerPixel = PixelFormat::kBytesPerPixel;
+  std::size_t total_size = 0;
+  unsigned int height = src.height();
+  unsigned int width = src.width();
+  for (std::size_t level = 1; level < num_levels; ++level) {
+    height = height / 2 + height % 2;
+    width = width / 2 + width % 2;
+    total_size += static_cast<std::size_t>(height) * width * kBytesPerPixel;
+  }
+  storage_.resize(total_size);
+  levels_.reserve(num_levels);
+  outputs_.reserve(num_levels - 1);
+  levels_.push_back(src);
+  std::size_t offset = 0;
+  for (std::size_t level = 1; level < num_levels; ++level) {
+    height = levels_.back().height() / 2 + levels_.back().height() % 2;
+    width = levels_.back().width() / 2 + levels_.back().width() % 2;
+    const std::size_t size = static_cast<std::size_t>(height) * width * kBytesPerPixel;
+    outputs_.push_back(ImageView<PixelFormat, true>(height, width, width, std::span(storage_.data() + offset, size)));
+    levels_.push_back(outputs_.back());
+    offset += size;
+  }
+  if (num_levels == 1 || src.empty()) {
+    return;
+  }
+  if (mode_ == PyramidMode::kGaussian5) {
+    gaussian_row_.resize((static_cast<std::size_t>(src.width()) + 4) * kBytesPerPixel);
+  }
+  num_computed_rows_.assign(num_levels, 0);
+  num_computed_rows_[0] = src.height();
+  for (unsigned int y = 0; y < levels_[1].height(); ++y) {
+    computeRow(1, y);
+  }
+}
+
+template <class PixelFormat>
+std::size_t ImagePyramid<PixelFormat>::size() const noexcept {
+  return levels_.size();
+}
+
+template <class PixelFormat>
+std::span<const ImageView<PixelFormat>> ImagePyramid<PixelFormat>::levels() const noexcept {
+  return levels_;
+}
+
+template <class PixelFormat>
+ImageView<PixelFormat> ImagePyramid<PixelFormat>::operator[](std::size_t level) const {
+  return levels_[level];
+}
+
+template <class PixelFormat>
+ImageView<PixelFormat> ImagePyramid<PixelFormat>::at(std::size_t level) const {
+  if (level >= size())
+  {
+    throw std::out_of_range("ImagePyramid::at(): level is out of range.");
+  }
+  return levels_[level];
+}
+
+template <class PixelFormat>
+unsigned int ImagePyramid<PixelFormat>::getLastInputRow(std::size_t level, unsigned int y) const noexcept {
+  const unsigned int radius = (mode_ == PyramidMode::kBox2x2) ? 1 : 2;
+  return std::min(2 * y + radius, levels_[level - 1].height() - 1);
+}
+
+template <class PixelFormat>
+void ImagePyramid<PixelFormat>::computeRow(std::size_t level, unsigned int y) {
+  constexpr std::size_t kChannels = PixelFormat::kBytesPerPixel;
+  const ImageView<PixelFormat> src = levels_[level - 1];
+  const ImageView<PixelFormat> dst = levels_[level];
+  unsigned char* dst_row = detail::getRowData(outputs_[level - 1], y);
+  const auto src_row = [&](int row) {
+    return detail::getRowData(src, static_cast<unsigned int>(std::clamp(row, 0, static_cast<int>(src.height()) - 1)));
+  };
+  const int center = 2 * static_cast<int>(y);
+  if (mode_ == PyramidMode::kBox2x2) {
+    detail::downsampleRowsBox<kChannels>(src_row(center), src_row(center + 1), dst_row, src.width());
+  } else {
+    const unsigned char* rows[5] = {src_row(center - 2), src_row(center - 1), src_row(center), src_row(center + 1),
+                                    src_row(center + 2)};
+    detail::filterRowsGaussian5<kChannels>(rows, gaussian_row_.data(), src.width());
+    detail::downsampleRowGaussian5<kChannels>(gaussian_row_.data(), dst_row, dst.width());
+  }
+  num_computed_rows_[level] = y + 1;
+  // Feed the next level with the rows that no longer wait for input.
+  const std::size_t next = level + 1;
+  if (next == levels_.size()) {
+    return;
+  }
+  while (num_computed_rows_[next] < levels_[next].height() &&
+         getLastInputRow(next, num_computed_rows_[next]) < num_computed_rows_[level]) {
+    computeRow(next, num_computed_rows_[next]);
+  }
+}
+
+}  // namespace imageview
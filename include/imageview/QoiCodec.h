@@ -0,0 +1,546 @@
+#pragma once
+
+#include <imageview/ImageRowView.h>
+#include <imageview/ImageView.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/internal/ByteOrder.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+// Lossless encoding and decoding of images in the QOI format (https://qoiformat.org/qoi-specification.pdf).
+//
+// The codec works row by row, so images of any size can be streamed with bounded memory:
+// * QoiEncoder encodes one row at a time, reading the pixels straight from an ImageRowView, and writes the result
+//   into a std::ostream or appends it to a std::vector. Besides its fixed-size state it only keeps a buffer for the
+//   encoded bytes of 1 row.
+// * QoiDecoder decodes one row at a time straight into a mutable ImageRowView. It either reads from a std::istream
+//   through a fixed-size buffer, or reads directly from an in-memory span without copying it.
+// Thus, rows of views with gaps between rows are encoded/decoded in place, without an intermediate image.
+//
+// Supported pixel formats:
+// * encoding: PixelFormatGrayscale8 (as a 3-channel image with equal channels), PixelFormatRGB24 (3 channels),
+//   PixelFormatRGBA32 (4 channels);
+// * decoding: PixelFormatRGB24 (the alpha channel is dropped), PixelFormatRGBA32 (alpha is 255 for 3-channel images).
+
+namespace imageview {
+
+// Colorspace tag stored in the header. It is informational only and doesn't affect the encoding.
+enum class QoiColorspace : unsigned char {
+  // sRGB color channels with linear alpha.
+  kSrgb = 0,
+  // All channels are linear.
+  kLinear = 1,
+};
+
+struct QoiHeader {
+  unsigned int width = 0;
+  unsigned int height = 0;
+  // The number of channels: 3 (RGB) or 4 (RGBA).
+  unsigned int channels = 0;
+  QoiColorspace colorspace = QoiColorspace::kSrgb;
+};
+
+// The size of the header in bytes.
+inline constexpr std::size_t kQoiHeaderSize = 14;
+
+// Parses the header of a QOI image.
+// \param data - the encoded image (or at least its first kQoiHeaderSize bytes).
+// \throw std::runtime_error if @data doesn't start with a valid header.
+QoiHeader parseQoiHeader(std::span<const std::byte> data);
+
+namespace detail {
+
+struct QoiPixel {
+  unsigned char r = 0;
+  unsigned char g = 0;
+  unsigned char b = 0;
+  unsigned char a = 0;
+
+  constexpr bool operator==(const QoiPixel&) const noexcept = default;
+};
+
+constexpr unsigned int getQoiIndex(QoiPixel pixel) noexcept {
+  return (pixel.r * 3u + pixel.g * 5u + pixel.b * 7u + pixel.a * 11u) % 64u;
+}
+
+constexpr unsigned char kQoiOpIndex = 0x00;
+constexpr unsigned char kQoiOpDiff = 0x40;
+constexpr unsigned char kQoiOpLuma = 0x80;
+constexpr unsigned char kQoiOpRun = 0xC0;
+constexpr unsigned char kQoiOpRgb = 0xFE;
+constexpr unsigned char kQoiOpRgba = 0xFF;
+constexpr unsigned char kQoiOpMask = 0xC0;
+// The longest run a single QOI_OP_RUN can encode.
+constexpr unsigned int kQoiMaxRun = 62;
+// The longest operation (QOI_OP_RGBA).
+constexpr std::size_t kQoiMaxOpSize = 5;
+// The limit on the number of pixels imposed by the specification.
+constexpr std::uint64_t kQoiMaxPixels = 400000000;
+constexpr std::array<std::byte, 4> kQoiMagic = {std::byte{'q'}, std::byte{'o'}, std::byte{'i'}, std::byte{'f'}};
+constexpr std::array<std::byte, 8> kQoiEndMarker = {std::byte{0}, std::byte{0}, std::byte{0}, std::byte{0},
+                                                    std::byte{0}, std::byte{0}, std::byte{0}, std::byte{1}};
+
+template <class PixelFormat>
+constexpr unsigned int getQoiChannels() noexcept {
+  return (PixelFormat::kBytesPerPixel == 4) ? 4 : 3;
+}
+
+}  // namespace detail
+
+// Streaming QOI encoder.
+// The header is written by the constructor; then every row must be passed to encodeRow() in order, and finally
+// finish() writes the end of the stream.
+class QoiEncoder {
+ public:
+  // Constructs an encoder that writes into @stream, which must outlive the encoder.
+  // \param stream - output stream.
+  // \param height - height of the image.
+  // \param width - width of the image.
+  // \param channels - the number of channels stored in the header: 3 or 4. If 3, the alpha channel of the input
+  //        rows is ignored.
+  // \param colorspace - colorspace stored in the header.
+  // \throw std::invalid_argument if the image is empty, too large, or @channels is neither 3 nor 4.
+  // \throw std::runtime_error if writing into @stream fails.
+  QoiEncoder(std::ostream& stream, unsigned int height, unsigned int width, unsigned int channels,
+             QoiColorspace colorspace = QoiColorspace::kSrgb);
+
+  // Constructs an encoder that appends to @output, which must outlive the encoder.
+  // See the constructor above for the parameters.
+  QoiEncoder(std::vector<std::byte>& output, unsigned int height, unsigned int width, unsigned int channels,
+             QoiColorspace colorspace = QoiColorspace::kSrgb);
+
+  QoiEncoder(const QoiEncoder&) = delete;
+  QoiEncoder& operator=(const QoiEncoder&) = delete;
+
+  const QoiHeader& header() const noexcept;
+
+  // Returns the number of rows encoded so far.
+  unsigned int numEncodedRows() const noexcept;
+
+  // Encodes the next row.
+  // \param row - row of the image; must have header().width pixels.
+  // \throw std::invalid_argument if @row has a wrong size or all rows have already been encoded.
+  // \throw std::runtime_error if writing into the stream fails.
+  template <class PixelFormat, bool Mutable>
+  void encodeRow(ImageRowView<PixelFormat, Mutable> row);
+
+  // Writes the end of the stream. Must be called once, after the last row has been encoded.
+  // \throw std::invalid_argument if not all rows have been encoded, or finish() has already been called.
+  // \throw std::runtime_error if writing into the stream fails.
+  void finish();
+
+ private:
+  QoiEncoder(std::ostream* stream, std::vector<std::byte>* output, unsigned int height, unsigned int width,
+             unsigned int channels, QoiColorspace colorspace);
+
+  void write(const std::byte* data, std::size_t size);
+
+  std::ostream* stream_;
+  std::vector<std::byte>* output_;
+  QoiHeader header_;
+  unsigned int num_encoded_rows_ = 0;
+  bool finished_ = false;
+  std::array<detail::QoiPixel, 64> index_{};
+  detail::QoiPixel previous_{0, 0, 0, 255};
+  // The length of the current run of pixels equal to previous_; runs can span several rows.
+  unsigned int run_ = 0;
+  // Encoded bytes of the current row: at most kQoiMaxOpSize per pixel plus 1 for the run carried over from the
+  // previous row.
+  std::vector<std::byte> row_buffer_;
+};
+
+// Streaming QOI decoder.
+// The header is parsed by the constructor; then decodeRow() decodes the rows in order.
+class QoiDecoder {
+ public:
+  // The size of the read buffer used when decoding from a std::istream.
+  static constexpr std::size_t kBufferSize = 64 * 1024;
+
+  // Constructs a decoder that reads from @stream, which must outlive the decoder.
+  // The decoder reads the stream in chunks of kBufferSize bytes, so it may consume bytes past the end of the image.
+  // \throw std::runtime_error if the header cannot be read or is invalid.
+  explicit QoiDecoder(std::istream& stream);
+
+  // Constructs a decoder that reads from @data without copying it. @data must outlive the decoder.
+  // \throw std::runtime_error if @data doesn't start with a valid header.
+  explicit QoiDecoder(std::span<const std::byte> data);
+
+  QoiDecoder(const QoiDecoder&) = delete;
+  QoiDecoder& operator=(const QoiDecoder&) = delete;
+
+  const QoiHeader& header() const noexcept;
+
+  // Returns the number of rows decoded so far.
+  unsigned int numDecodedRows() const noexcept;
+
+  // Decodes the next row into @row.
+  // \param row - destination row; must have header().width pixels.
+  // \throw std::invalid_argument if @row has a wrong size or all rows have already been decoded.
+  // \throw std::runtime_error if the data is truncated or corrupted.
+  template <class PixelFormat>
+  void decodeRow(ImageRowView<PixelFormat, true> row);
+
+ private:
+  // Moves the unread bytes to the beginning of the buffer and reads more bytes from the stream.
+  // Does nothing if the decoder reads from a span.
+  void refill();
+
+  std::istream* stream_ = nullptr;
+  std::vector<std::byte> buffer_;
+  const std::byte* position_ = nullptr;
+  const std::byte* end_ = nullptr;
+  QoiHeader header_;
+  unsigned int num_decoded_rows_ = 0;
+  std::array<detail::QoiPixel, 64> index_{};
+  detail::QoiPixel previous_{0, 0, 0, 255};
+  // The number of pixels left in the current run; runs can span several rows.
+  unsigned int run_ = 0;
+};
+
+// Encodes an image and writes it into @stream.
+// \param image - image to encode; must not be empty.
+// \param stream - output stream.
+// \param colorspace - colorspace stored in the header.
+// \throw std::invalid_argument if the image is empty or too large.
+// \throw std::runtime_error if writing into @stream fails.
+template <class PixelFormat, bool Mutable>
+void encodeQoi(ImageView<PixelFormat, Mutable> image, std::ostream& stream,
+               QoiColorspace colorspace = QoiColorspace::kSrgb) {
+  QoiEncoder encoder(stream, image.height(), image.width(), detail::getQoiChannels<PixelFormat>(), colorspace);
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    encoder.encodeRow(image.row(y));
+  }
+  encoder.finish();
+}
+
+// Encodes an image and appends the result to @output.
+// \param image - image to encode; must not be empty.
+// \param output - vector to append the encoded image to.
+// \param colorspace - colorspace stored in the header.
+// \throw std::invalid_argument if the image is empty or too large.
+template <class PixelFormat, bool Mutable>
+void encodeQoi(ImageView<PixelFormat, Mutable> image, std::vector<std::byte>& output,
+               QoiColorspace colorspace = QoiColorspace::kSrgb) {
+  QoiEncoder encoder(output, image.height(), image.width(), detail::getQoiChannels<PixelFormat>(), colorspace);
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    encoder.encodeRow(image.row(y));
+  }
+  encoder.finish();
+}
+
+// Decodes a QOI image into @image.
+// \param data - the encoded image.
+// \param image - destination image; must have the dimensions stored in the header (see parseQoiHeader()).
+// \throw std::invalid_argument if @image has wrong dimensions.
+// \throw std::runtime_error if the data is invalid.
+template <class PixelFormat>
+void decodeQoi(std::span<const std::byte> data, ImageView<PixelFormat, true> image) {
+  QoiDecoder decoder(data);
+  if (decoder.header().height != image.height() || decoder.header().width != image.width())
+  {
+    throw std::invalid_argument("imageview::decodeQoi(): the image has wrong dimensions.");
+  }
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    decoder.decodeRow(image.row(y));
+  }
+}
+
+// Decodes a QOI image read from @stream into @image.
+// \param stream - input stream.
+// \param image - destination image; must have the dimensions stored in the header.
+// \throw std::invalid_argument if @image has wrong dimensions.
+// \throw std::runtime_error if reading fails or the data is invalid.
+template <class PixelFormat>
+void decodeQoi(std::istream& stream, ImageView<PixelFormat, true> image) {
+  QoiDecoder decoder(stream);
+  if (decoder.header().height != image.height() || decoder.header().width != image.width())
+  {
+    throw std::invalid_argument("imageview::decodeQoi(): the image has wrong dimensions.");
+  }
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    decoder.decodeRow(image.row(y));
+  }
+}
+
+inline QoiHeader parseQoiHeader(std::span<const std::byte> data) {
+  if (data.size() < kQoiHeaderSize || !std::equal(detail::kQoiMagic.begin(), detail::kQoiMagic.end(), data.begin()))
+  {
+    throw std::runtime_error("imageview::parseQoiHeader(): not a QOI image.");
+  }
+  QoiHeader header;
+  header.width = detail::loadUint32<std::endian::big>(data.subspan<4, 4>());
+  header.height = detail::loadUint32<std::endian::big>(data.subspan<8, 4>());
+  header.channels = static_cast<unsigned int>(data[12]);
+  const unsigned int colorspace = static_cast<unsigned int>(data[13]);
+  if (header.width == 0 || header.height == 0 ||
+      static_cast<std::uint64_t>(header.width) * header.height > detail::kQoiMaxPixels)
+  {
+    throw std::runtime_error("imageview::parseQoiHeader(): invalid dimensions.");
+  }
+  if ((header.channels != 3 && header.channels != 4) || colorspace > 1)
+  {
+    throw std::runtime_error("imageview::parseQoiHeader(): invalid header.");
+  }
+  header.colorspace = static_cast<QoiColorspace>(colorspace);
+  return header;
+}
+
+inline QoiEncoder::QoiEncoder(std::ostream& stream, unsigned int height, unsigned int width, unsigned int channels,
+                              QoiColorspace colorspace)
+    : QoiEncoder(&stream, nullptr, height, width, channels, colorspace) {}
+
+inline QoiEncoder::QoiEncoder(std::vector<std::byte>& output, unsigned int height, unsigned int width,
+                              unsigned int channels, QoiColorspace colorspace)
+    : QoiEncoder(nullptr, &output, height, width, channels, colorspace) {}
+
+inline QoiEncoder::QoiEncoder(std::ostream* stream, std::vector<std::byte>* output, unsigned int height,
+                              unsigned int width, unsigned int channels, QoiColorspace colorspace)
+    : stream_(stream), output_(output), header_{width, height, channels, colorspace} {
+  if (width == 0 || height == 0 || static_cast<std::uint64_t>(width) * height > detail::kQoiMaxPixels)
+  {
+    throw std::invalid_argument("QoiEncoder(): the image must be non-empty and have at most 400 million pixels.");
+  }
+  if (channels != 3 && channels != 4)
+  {
+    throw std::invalid_argument("QoiEncoder(): the number of channels must be 3 or 4.");
+  }
+  row_buffer_.resize(static_cast<std::size_t>(width) * detail::kQoiMaxOpSize + 1);
+  std::array<std::byte, kQoiHeaderSize> header_data{};
+  std::copy(detail::kQoiMagic.begin(), detail::kQoiMagic.end(), header_data.begin());
+  detail::storeUint32<std::endian::big>(width, std::span(header_data).subspan<4, 4>());
+  detail::storeUint32<std::endian::big>(height, std::span(header_data).subspan<8, 4>());
+  header_data[12] = static_cast<std::byte>(channels);
+  header_data[13] = static_cast<std::byte>(colorspace);
+  write(header_data.data(), header_data.size());
+}
+
+inline const QoiHeader& QoiEncoder::header() const noexcept { return header_; }
+
+inline unsigned int QoiEncoder::numEncodedRows() const noexcept { return num_encoded_rows_; }
+
+template <class PixelFormat, bool Mutable>
+void QoiEncoder::encodeRow(ImageRowView<PixelFormat, Mutable> row) {
+  static_assert(detail::HasByteChannels<PixelFormat>::value, "Only pixel formats with 8-bit channels are supported.");
+  constexpr std::size_t kChannels = PixelFormat::kBytesPerPixel;
+  if (row.size() != header_.width || num_encoded_rows_ == header_.height)
+  {
+    throw std::invalid_argument("QoiEncoder::encodeRow(): wrong row size, or all rows have already been encoded.");
+  }
+  const unsigned char* src = reinterpret_cast<const unsigned char*>(row.data().data());
+  unsigned char* out = reinterpret_cast<unsigned char*>(row_buffer_.data());
+  unsigned char* position = out;
+  detail::QoiPixel previous = previous_;
+  unsigned int run = run_;
+  for (std::size_t x = 0; x < header_.width; ++x, src += kChannels) {
+    detail::QoiPixel pixel;
+    if constexpr (kChannels == 1) {
+      pixel = {src[0], src[0], src[0], 255};
+    } else if constexpr (kChannels == 3) {
+      pixel = {src[0], src[1], src[2], 255};
+    } else {
+      pixel = {src[0], src[1], src[2], (header_.channels == 4) ? src[3] : static_cast<unsigned char>(255)};
+    }
+    if (pixel == previous) {
+      if (++run == detail::kQoiMaxRun) {
+        *position++ = static_cast<unsigned char>(detail::kQoiOpRun | (run - 1));
+        run = 0;
+      }
+      continue;
+    }
+    if (run > 0) {
+      *position++ = static_cast<unsigned char>(detail::kQoiOpRun | (run - 1));
+      run = 0;
+    }
+    const unsigned int index = detail::getQoiIndex(pixel);
+    if (index_[index] == pixel) {
+      *position++ = static_cast<unsigned char>(detail::kQoiOpIndex | index);
+    } else {
+      index_[index] = pixel;
+      if (pixel.a == previous.a) {
+        const int dr = static_cast<signed char>(pixel.r - previous.r);
+        const int dg = static_cast<signed char>(pixel.g - previous.g);
+        const int db = static_cast<signed char>(pixel.b - previous.b);
+        const int dr_dg = dr - dg;
+        const int db_dg = db - dg;
+        if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+          *position++ = static_cast<unsigned char>(detail::kQoiOpDiff | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+        } else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+          position[0] = static_cast<unsigned char>(detail::kQoiOpLuma | (dg + 32));
+          position[1] = static_cast<unsigned char>(((dr_dg + 8) << 4) | (db_dg + 8));
+          position += 2;
+        } else {
+          position[0] = detail::kQoiOpRgb;
+          position[1] = pixel.r;
+          position[2] = pixel.g;
+          position[3] = pixel.b;
+          position += 4;
+        }
+      } else {
+        position[0] = detail::kQoiOpRgba;
+        position[1] = pixel.r;
+        position[2] = pixel.g;
+        position[3] = pixel.b;
+        position[4] = pixel.a;
+        position += 5;
+      }
+    }
+    previous = pixel;
+  }
+  previous_ = previous;
+  run_ = run;
+  ++num_encoded_rows_;
+  write(row_buffer_.data(), static_cast<std::size_t>(position - out));
+}
+
+inline void QoiEncoder::finish() {
+  if (finished_ || num_encoded_rows_ != header_.height)
+  {
+    throw std::invalid_argument("QoiEncoder::finish(): not all rows have been encoded, or finish() was called twice.");
+  }
+  finished_ = true;
+  if (run_ > 0) {
+    const std::byte op = static_cast<std::byte>(detail::kQoiOpRun | (run_ - 1));
+    write(&op, 1);
+    run_ = 0;
+  }
+  write(detail::kQoiEndMarker.data(), detail::kQoiEndMarker.size());
+  if (stream_ != nullptr && !stream_->flush())
+  {
+    throw std::runtime_error("QoiEncoder::finish(): failed to flush the stream.");
+  }
+}
+
+inline void QoiEncoder::write(const std::byte* data, std::size_t size) {
+  if (output_ != nullptr) {
+    output_->insert(output_->end(), data, data + size);
+    return;
+  }
+  if (!stream_->write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size)))
+  {
+    throw std::runtime_error("QoiEncoder: failed to write into the stream.");
+  }
+}
+
+inline QoiDecoder::QoiDecoder(std::istream& stream) : stream_(&stream), buffer_(kBufferSize) {
+  position_ = end_ = buffer_.data();
+  refill();
+  header_ = parseQoiHeader(std::span<const std::byte>(position_, end_));
+  position_ += kQoiHeaderSize;
+}
+
+inline QoiDecoder::QoiDecoder(std::span<const std::byte> data)
+    : position_(data.data()), end_(data.data() + data.size()), header_(parseQoiHeader(data)) {
+  position_ += kQoiHeaderSize;
+}
+
+inline const QoiHeader& QoiDecoder::header() const noexcept { return header_; }
+
+inline unsigned int QoiDecoder::numDecodedRows() const noexcept { return num_decoded_rows_; }
+
+template <class PixelFormat>
+void QoiDecoder::decodeRow(ImageRowView<PixelFormat, true> row) {
+  static_assert(PixelFormat::kBytesPerPixel >= 3 && detail::HasByteChannels<PixelFormat>::value,
+                "Only PixelFormatRGB24 and PixelFormatRGBA32 are supported.");
+  constexpr std::size_t kChannels = PixelFormat::kBytesPerPixel;
+  if (row.size() != header_.width || num_decoded_rows_ == header_.height)
+  {
+    throw std::invalid_argument("QoiDecoder::decodeRow(): wrong row size, or all rows have already been decoded.");
+  }
+  unsigned char* dst = reinterpret_cast<unsigned char*>(row.data().data());
+  // The state is kept in local variables: stores into @dst may alias the members, which would otherwise have to be
+  // reloaded after every pixel.
+  detail::QoiPixel pixel = previous_;
+  std::array<detail::QoiPixel, 64> index = index_;
+  unsigned int run = run_;
+  const std::byte* position = position_;
+  for (std::size_t x = 0; x < header_.width; ++x, dst += kChannels) {
+    if (run > 0) {
+      --run;
+    } else {
+      // Every operation is followed by at least the end marker, so a valid stream always has kQoiMaxOpSize bytes here.
+      if (static_cast<std::size_t>(end_ - position) < detail::kQoiMaxOpSize) {
+        position_ = position;
+        refill();
+        position = position_;
+        if (static_cast<std::size_t>(end_ - position) < detail::kQoiMaxOpSize)
+        {
+          throw std::runtime_error("QoiDecoder::decodeRow(): the data is truncated.");
+        }
+      }
+      const auto* data = reinterpret_cast<const unsigned char*>(position);
+      const unsigned char op = data[0];
+      if (op == detail::kQoiOpRgb) {
+        pixel.r = data[1];
+        pixel.g = data[2];
+        pixel.b = data[3];
+        position += 4;
+      } else if (op == detail::kQoiOpRgba) {
+        pixel = {data[1], data[2], data[3], data[4]};
+        position += 5;
+      } else {
+        switch (op & detail::kQoiOpMask) {
+          case detail::kQoiOpIndex:
+            pixel = index[op];
+            break;
+          case detail::kQoiOpDiff:
+            pixel.r = static_cast<unsigned char>(pixel.r + ((op >> 4) & 0x03) - 2);
+            pixel.g = static_cast<unsigned char>(pixel.g + ((op >> 2) & 0x03) - 2);
+            pixel.b = static_cast<unsigned char>(pixel.b + (op & 0x03) - 2);
+            break;
+          case detail::kQoiOpLuma: {
+            const int dg = (op & 0x3F) - 32;
+            pixel.r = static_cast<unsigned char>(pixel.r + dg - 8 + ((data[1] >> 4) & 0x0F));
+            pixel.g = static_cast<unsigned char>(pixel.g + dg);
+            pixel.b = static_cast<unsigned char>(pixel.b + dg - 8 + (data[1] & 0x0F));
+            ++position;
+            break;
+          }
+          default:
+            run = op & 0x3F;
+            break;
+        }
+        ++position;
+      }
+      index[detail::getQoiIndex(pixel)] = pixel;
+    }
+    dst[0] = pixel.r;
+    dst[1] = pixel.g;
+    dst[2] = pixel.b;
+    if constexpr (kChannels == 4) {
+      dst[3] = pixel.a;
+    }
+  }
+  index_ = index;
+  run_ = run;
+  position_ = position;
+  previous_ = pixel;
+  ++num_decoded_rows_;
+}
+
+inline void QoiDecoder::refill() {
+  if (stream_ == nullptr) {
+    return;
+  }
+  std::byte* buffer = buffer_.data();
+  const std::size_t num_unread = static_cast<std::size_t>(end_ - position_);
+  std::copy(position_, end_, buffer);
+  const std::size_t num_free = buffer_.size() - num_unread;
+  stream_->read(reinterpret_cast<char*>(buffer + num_unread), static_cast<std::streamsize>(num_free));
+  if (stream_->bad())
+  {
+    throw std::runtime_error("QoiDecoder: failed to read from the stream.");
+  }
+  position_ = buffer;
+  end_ = buffer + num_unread + static_cast<std::size_t>(stream_->gcount());
+}
+
+}  // namespace imageview
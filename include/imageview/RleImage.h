@@ -0,0 +1,505 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/IsPixelFormat.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Run-length encoded images.
+//
+// RleImage stores every row as a sequence of runs of identical pixels. Runs never cross row boundaries, and the
+// index of the first run of every row is kept, so any row can be accessed in O(1). The algorithms below work on
+// the runs directly: their cost depends on the number of runs rather than on the number of pixels, which makes
+// RleImage a good fit for masks, label maps and screen captures.
+
+namespace imageview {
+
+// Axis-aligned rectangle within an image.
+struct BoundingBox {
+  unsigned int first_row = 0;
+  unsigned int first_column = 0;
+  unsigned int num_rows = 0;
+  unsigned int num_columns = 0;
+};
+
+// Run-length encoded image.
+//
+// Pixels are compared by their encoded bytes rather than by their colors, so the encoding is lossless for any
+// pixel format, even if different encodings represent equal colors.
+//
+// \param PixelFormat - specifies how colors are encoded.
+template <class PixelFormat>
+class RleImage {
+ public:
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+
+  using color_type = typename PixelFormat::color_type;
+
+  // Constructs an empty image.
+  // \param pixel_format - instance of PixelFormat to use.
+  explicit RleImage(const PixelFormat& pixel_format = PixelFormat());
+
+  // Constructs an image of the specified width without rows. Rows are added by appendRun().
+  // \param width - width of the image.
+  // \param pixel_format - instance of PixelFormat to use.
+  explicit RleImage(unsigned int width, const PixelFormat& pixel_format = PixelFormat());
+
+  // Encodes the specified image.
+  template <bool Mutable>
+  explicit RleImage(ImageView<PixelFormat, Mutable> image);
+
+  // Returns the number of complete rows.
+  unsigned int height() const noexcept;
+
+  unsigned int width() const noexcept;
+
+  // Returns true if the image has zero area, false otherwise.
+  bool empty() const noexcept;
+
+  // Returns the pixel format used by this image.
+  const PixelFormat& pixelFormat() const noexcept;
+
+  // Returns the total number of runs in the complete rows.
+  std::size_t numRuns() const noexcept;
+
+  // Returns the ends of the runs in the specified row: run i covers the columns [ends[i - 1]; ends[i]), where
+  // ends[-1] is 0. The last element always equals width().
+  // \param y - 0-based index of the row.
+  // \throw std::out_of_range if y >= height().
+  std::span<const unsigned int> runEnds(unsigned int y) const;
+
+  // Returns the color of the specified run.
+  // \param y - 0-based index of the row.
+  // \param index - 0-based index of the run within the row.
+  // \throw std::out_of_range if y >= height() or index >= runEnds(y).size().
+  color_type runColor(unsigned int y, std::size_t index) const;
+
+  // Returns the color of the specified pixel. The run is found by binary search.
+  // \throw std::out_of_range if y >= height() or x >= width().
+  color_type operator()(unsigned int y, unsigned int x) const;
+
+  // Appends a run of pixels to the last row. A new row is started once the last row is complete.
+  // Consecutive runs of the same color are merged.
+  // \param color - the color of the pixels.
+  // \param length - the number of pixels.
+  // \throw std::invalid_argument if length is 0 or the run doesn't fit into the row.
+  void appendRun(const color_type& color, unsigned int length);
+
+  // Sets all pixels within the specified rectangle to @color.
+  // The runs are spliced in a single pass over the runs; no pixels are decompressed.
+  // \throw std::out_of_range if the rectangle is not within the image.
+  void fill(const BoundingBox& box, const color_type& color);
+
+ private:
+  template <class OtherPixelFormat>
+  friend void decompress(const RleImage<OtherPixelFormat>& source, ImageView<OtherPixelFormat, true> destination);
+
+  static constexpr std::size_t kBytesPerPixel = PixelFormat::kBytesPerPixel;
+
+  using EncodedColor = std::array<std::byte, kBytesPerPixel>;
+
+  EncodedColor encode(const color_type& color) const;
+
+  color_type decode(std::size_t run_index) const;
+
+  void appendEncodedRun(const std::byte* color, unsigned int length);
+
+  // Index of the first run of the incomplete row.
+  std::size_t rowEnd() const noexcept;
+
+  // The number of pixels in the incomplete row.
+  unsigned int incompleteRowWidth() const noexcept;
+
+  // The end of each run relative to the beginning of its row.
+  std::vector<unsigned int> run_ends_;
+  // The encoded color of each run.
+  std::vector<std::byte> colors_;
+  // row_begin_[y] is the index of the first run of the row y; row_begin_.back() == rowEnd().
+  std::vector<std::size_t> row_begin_ = {0};
+  unsigned int width_ = 0;
+  PixelFormat pixel_format_;
+};
+
+// Returns the number of pixels of the image whose color equals @value.
+template <class PixelFormat>
+std::size_t count(const RleImage<PixelFormat>& image, const typename PixelFormat::color_type& value);
+
+// Returns the smallest rectangle containing all pixels whose color equals @value, or std::nullopt if there are
+// no such pixels.
+template <class PixelFormat>
+std::optional<BoundingBox> boundingBox(const RleImage<PixelFormat>& image,
+                                       const typename PixelFormat::color_type& value);
+
+// Combines 2 images pixel by pixel without decompressing them.
+// Run boundaries of both images are merged, so the cost is O(lhs.numRuns() + rhs.numRuns()). For example,
+// combine(lhs, rhs, std::bit_and<>()) computes the intersection of 2 Grayscale8 masks.
+// \param lhs, rhs - images of the same size.
+// \param function - function with the signature equivalent to
+//          PixelFormat::color_type function(const PixelFormat::color_type& lhs,
+//                                           const OtherPixelFormat::color_type& rhs);
+// \return image with the pixel format of @lhs.
+// \throw std::invalid_argument if the images have different sizes.
+template <class PixelFormat, class OtherPixelFormat, class Function>
+RleImage<PixelFormat> combine(const RleImage<PixelFormat>& lhs, const RleImage<OtherPixelFormat>& rhs,
+                              Function function);
+
+// Decompresses an RLE image. Each run is written with memset() or with a memcpy() of a doubling pattern.
+// \param source - image to decompress.
+// \param destination - image of the same size.
+// \throw std::invalid_argument if the images have different sizes.
+template <class PixelFormat>
+void decompress(const RleImage<PixelFormat>& source, ImageView<PixelFormat, true> destination);
+
+namespace detail {
+
+// Returns the index of the first byte i in [first; last) such that data[i] != data[i - period],
+// or @last if there is no such byte. Long runs are skipped 32 bytes per iteration, and the differing byte is found
+// within a 64-bit word without a loop.
+inline std::size_t findPeriodBreak(const std::byte* data, std::size_t first, std::size_t last,
+                                   std::size_t period) noexcept {
+  constexpr std::size_t kWordSize = sizeof(std::uint64_t);
+  const auto word_difference = [data, period](std::size_t i) {
+    std::uint64_t current;
+    std::uint64_t previous;
+    std::memcpy(&current, data + i, kWordSize);
+    std::memcpy(&previous, data + i - period, kWordSize);
+    return current ^ previous;
+  };
+  std::size_t i = first;
+  while (i + 4 * kWordSize <= last && (word_difference(i) | word_difference(i + kWordSize) |
+                                       word_difference(i + 2 * kWordSize) | word_difference(i + 3 * kWordSize)) == 0) {
+    i += 4 * kWordSize;
+  }
+  for (; i + kWordSize <= last; i += kWordSize) {
+    const std::uint64_t difference = word_difference(i);
+    if (difference != 0) {
+      if constexpr (std::endian::native == std::endian::little) {
+        return i + static_cast<std::size_t>(std::countr_zero(difference)) / 8;
+      } else {
+        return i + static_cast<std::size_t>(std::countl_zero(difference)) / 8;
+      }
+    }
+  }
+  for (; i < last; ++i) {
+    if (data[i] != data[i - period]) {
+      return i;
+    }
+  }
+  return last;
+}
+
+// Fills @size bytes at @destination with copies of the @pattern_size bytes at @pattern.
+inline void fillPattern(std::byte* destination, std::size_t size, const std::byte* pattern,
+                        std::size_t pattern_size) noexcept {
+  if (pattern_size == 1) {
+    std::memset(destination, static_cast<int>(pattern[0]), size);
+    return;
+  }
+  std::memcpy(destination, pattern, pattern_size);
+  for (std::size_t filled = pattern_size; filled < size;) {
+    const std::size_t chunk = std::min(filled, size - filled);
+    std::memcpy(destination + filled, destination, chunk);
+    filled += chunk;
+  }
+}
+
+}  // namespace detail
+
+template <class PixelFormat>
+RleImage<PixelFormat>::RleImage(const PixelFormat& pixel_format) : pixel_format_(pixel_format) {}
+
+template <class PixelFormat>
+RleImage<PixelFormat>::RleImage(unsigned int width, const PixelFormat& pixel_format)
+    : width_(width), pixel_format_(pixel_format) {}
+
+template <class PixelFormat>
+template <bool Mutable>
+RleImage<PixelFormat>::RleImage(ImageView<PixelFormat, Mutable> image)
+    : width_(image.width()), pixel_format_(image.pixelFormat()) {
+  const std::size_t row_size = static_cast<std::size_t>(image.width()) * kBytesPerPixel;
+  row_begin_.reserve(static_cast<std::size_t>(image.height()) + 1);
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    const std::byte* row = image.data().data() + static_cast<std::size_t>(y) * image.stride() * kBytesPerPixel;
+    std::size_t run_begin = 0;
+    while (run_begin < row_size) {
+      const std::size_t run_end =
+          detail::findPeriodBreak(row, run_begin + kBytesPerPixel, row_size, kBytesPerPixel) / kBytesPerPixel *
+          kBytesPerPixel;
+      run_ends_.push_back(static_cast<unsigned int>(run_end / kBytesPerPixel));
+      colors_.insert(colors_.end(), row + run_begin, row + run_begin + kBytesPerPixel);
+      run_begin = run_end;
+    }
+    row_begin_.push_back(run_ends_.size());
+  }
+}
+
+template <class PixelFormat>
+unsigned int RleImage<PixelFormat>::height() const noexcept {
+  return static_cast<unsigned int>(row_begin_.size() - 1);
+}
+
+template <class PixelFormat>
+unsigned int RleImage<PixelFormat>::width() const noexcept {
+  return width_;
+}
+
+template <class PixelFormat>
+bool RleImage<PixelFormat>::empty() const noexcept {
+  return height() == 0 || width_ == 0;
+}
+
+template <class PixelFormat>
+const PixelFormat& RleImage<PixelFormat>::pixelFormat() const noexcept {
+  return pixel_format_;
+}
+
+template <class PixelFormat>
+std::size_t RleImage<PixelFormat>::numRuns() const noexcept {
+  return rowEnd();
+}
+
+template <class PixelFormat>
+std::span<const unsigned int> RleImage<PixelFormat>::runEnds(unsigned int y) const {
+  if (y >= height())
+  {
+    throw std::out_of_range("RleImage::runEnds(): y is out of range.");
+  }
+  return std::span<const unsigned int>(run_ends_.data() + row_begin_[y], row_begin_[y + 1] - row_begin_[y]);
+}
+
+template <class PixelFormat>
+auto RleImage<PixelFormat>::runColor(unsigned int y, std::size_t index) const -> color_type {
+  if (y >= height())
+  {
+    throw std::out_of_range("RleImage::runColor(): y is out of range.");
+  }
+  if (index >= row_begin_[y + 1] - row_begin_[y])
+  {
+    throw std::out_of_range("RleImage::runColor(): index is out of range.");
+  }
+  return decode(row_begin_[y] + index);
+}
+
+template <class PixelFormat>
+auto RleImage<PixelFormat>::operator()(unsigned int y, unsigned int x) const -> color_type {
+  if (y >= height())
+  {
+    throw std::out_of_range("RleImage::operator(): y is out of range.");
+  }
+  if (x >= width_)
+  {
+    throw std::out_of_range("RleImage::operator(): x is out of range.");
+  }
+  const auto first = run_ends_.begin() + row_begin_[y];
+  const auto last = run_ends_.begin() + row_begin_[y + 1];
+  return decode(std::upper_bound(first, last, x) - run_ends_.begin());
+}
+
+template <class PixelFormat>
+void RleImage<PixelFormat>::appendRun(const color_type& color, unsigned int length) {
+  if (length == 0)
+  {
+    throw std::invalid_argument("RleImage::appendRun(): length cannot be 0.");
+  }
+  if (length > width_ - incompleteRowWidth())
+  {
+    throw std::invalid_argument("RleImage::appendRun(): the run doesn't fit into the row.");
+  }
+  const EncodedColor encoded = encode(color);
+  appendEncodedRun(encoded.data(), length);
+}
+
+template <class PixelFormat>
+void RleImage<PixelFormat>::fill(const BoundingBox& box, const color_type& color) {
+  if (box.first_row > height() || box.num_rows > height() - box.first_row)
+  {
+    throw std::out_of_range("RleImage::fill(): the rectangle is out of range vertically.");
+  }
+  if (box.first_column > width_ || box.num_columns > width_ - box.first_column)
+  {
+    throw std::out_of_range("RleImage::fill(): the rectangle is out of range horizontally.");
+  }
+  if (box.num_rows == 0 || box.num_columns == 0) {
+    return;
+  }
+  const EncodedColor encoded = encode(color);
+  const unsigned int last_column = box.first_column + box.num_columns;
+  RleImage result(width_, pixel_format_);
+  result.run_ends_.reserve(run_ends_.size() + 2 * box.num_rows);
+  result.colors_.reserve(colors_.size() + 2 * box.num_rows * kBytesPerPixel);
+  result.row_begin_.reserve(row_begin_.size());
+  for (unsigned int y = 0; y < height(); ++y) {
+    if (y < box.first_row || y >= box.first_row + box.num_rows) {
+      // Copy the row as is.
+      result.run_ends_.insert(result.run_ends_.end(), run_ends_.begin() + row_begin_[y],
+                              run_ends_.begin() + row_begin_[y + 1]);
+      result.colors_.insert(result.colors_.end(), colors_.begin() + row_begin_[y] * kBytesPerPixel,
+                            colors_.begin() + row_begin_[y + 1] * kBytesPerPixel);
+      result.row_begin_.push_back(result.run_ends_.size());
+      continue;
+    }
+    unsigned int run_begin = 0;
+    bool filled = false;
+    for (std::size_t run = row_begin_[y]; run < row_begin_[y + 1]; ++run) {
+      const unsigned int run_end = run_ends_[run];
+      // The part of the run to the left of the rectangle.
+      if (run_begin < box.first_column) {
+        result.appendEncodedRun(colors_.data() + run * kBytesPerPixel,
+                                std::min(run_end, box.first_column) - run_begin);
+      }
+      if (!filled && run_end > box.first_column) {
+        result.appendEncodedRun(encoded.data(), box.num_columns);
+        filled = true;
+      }
+      // The part of the run to the right of the rectangle.
+      if (run_end > last_column) {
+        result.appendEncodedRun(colors_.data() + run * kBytesPerPixel, run_end - std::max(run_begin, last_column));
+      }
+      run_begin = run_end;
+    }
+  }
+  // Keep the incomplete row, if any.
+  for (std::size_t run = rowEnd(); run < run_ends_.size(); ++run) {
+    result.appendEncodedRun(colors_.data() + run * kBytesPerPixel,
+                            run_ends_[run] - ((run == rowEnd()) ? 0 : run_ends_[run - 1]));
+  }
+  *this = std::move(result);
+}
+
+template <class PixelFormat>
+auto RleImage<PixelFormat>::encode(const color_type& color) const -> EncodedColor {
+  EncodedColor encoded{};
+  pixel_format_.write(color, std::span<std::byte, kBytesPerPixel>(encoded));
+  return encoded;
+}
+
+template <class PixelFormat>
+auto RleImage<PixelFormat>::decode(std::size_t run_index) const -> color_type {
+  return pixel_format_.read(std::span<const std::byte, kBytesPerPixel>(colors_.data() + run_index * kBytesPerPixel,
+                                                                       kBytesPerPixel));
+}
+
+template <class PixelFormat>
+void RleImage<PixelFormat>::appendEncodedRun(const std::byte* color, unsigned int length) {
+  const unsigned int row_width = incompleteRowWidth();
+  if (row_width != 0 && std::memcmp(colors_.data() + colors_.size() - kBytesPerPixel, color, kBytesPerPixel) == 0) {
+    run_ends_.back() += length;
+  } else {
+    run_ends_.push_back(row_width + length);
+    colors_.insert(colors_.end(), color, color + kBytesPerPixel);
+  }
+  if (run_ends_.back() == width_) {
+    row_begin_.push_back(run_ends_.size());
+  }
+}
+
+template <class PixelFormat>
+std::size_t RleImage<PixelFormat>::rowEnd() const noexcept {
+  return row_begin_.back();
+}
+
+template <class PixelFormat>
+unsigned int RleImage<PixelFormat>::incompleteRowWidth() const noexcept {
+  return (run_ends_.size() == rowEnd()) ? 0 : run_ends_.back();
+}
+
+template <class PixelFormat>
+std::size_t count(const RleImage<PixelFormat>& image, const typename PixelFormat::color_type& value) {
+  std::size_t result = 0;
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    const std::span<const unsigned int> run_ends = image.runEnds(y);
+    unsigned int run_begin = 0;
+    for (std::size_t run = 0; run < run_ends.size(); ++run) {
+      if (image.runColor(y, run) == value) {
+        result += run_ends[run] - run_begin;
+      }
+      run_begin = run_ends[run];
+    }
+  }
+  return result;
+}
+
+template <class PixelFormat>
+std::optional<BoundingBox> boundingBox(const RleImage<PixelFormat>& image,
+                                       const typename PixelFormat::color_type& value) {
+  unsigned int first_row = image.height();
+  unsigned int last_row = 0;
+  unsigned int first_column = image.width();
+  unsigned int last_column = 0;
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    const std::span<const unsigned int> run_ends = image.runEnds(y);
+    unsigned int run_begin = 0;
+    for (std::size_t run = 0; run < run_ends.size(); ++run) {
+      if (image.runColor(y, run) == value) {
+        first_row = std::min(first_row, y);
+        last_row = y + 1;
+        first_column = std::min(first_column, run_begin);
+        last_column = std::max(last_column, run_ends[run]);
+      }
+      run_begin = run_ends[run];
+    }
+  }
+  if (first_row == image.height()) {
+    return std::nullopt;
+  }
+  return BoundingBox{first_row, first_column, last_row - first_row, last_column - first_column};
+}
+
+template <class PixelFormat, class OtherPixelFormat, class Function>
+RleImage<PixelFormat> combine(const RleImage<PixelFormat>& lhs, const RleImage<OtherPixelFormat>& rhs,
+                              Function function) {
+  if (lhs.height() != rhs.height() || lhs.width() != rhs.width())
+  {
+    throw std::invalid_argument("imageview::combine(): the images must have the same size.");
+  }
+  RleImage<PixelFormat> result(lhs.width(), lhs.pixelFormat());
+  for (unsigned int y = 0; y < lhs.height(); ++y) {
+    const std::span<const unsigned int> lhs_ends = lhs.runEnds(y);
+    const std::span<const unsigned int> rhs_ends = rhs.runEnds(y);
+    std::size_t lhs_run = 0;
+    std::size_t rhs_run = 0;
+    unsigned int x = 0;
+    while (x < lhs.width()) {
+      const unsigned int run_end = std::min(lhs_ends[lhs_run], rhs_ends[rhs_run]);
+      result.appendRun(static_cast<typename PixelFormat::color_type>(
+                           function(lhs.runColor(y, lhs_run), rhs.runColor(y, rhs_run))),
+                       run_end - x);
+      lhs_run += (lhs_ends[lhs_run] == run_end);
+      rhs_run += (rhs_ends[rhs_run] == run_end);
+      x = run_end;
+    }
+  }
+  return result;
+}
+
+template <class PixelFormat>
+void decompress(const RleImage<PixelFormat>& source, ImageView<PixelFormat, true> destination) {
+  if (source.height() != destination.height() || source.width() != destination.width())
+  {
+    throw std::invalid_argument("imageview::decompress(): the images must have the same size.");
+  }
+  constexpr std::size_t kBytesPerPixel = PixelFormat::kBytesPerPixel;
+  for (unsigned int y = 0; y < source.height(); ++y) {
+    std::byte* row = destination.data().data() + static_cast<std::size_t>(y) * destination.stride() * kBytesPerPixel;
+    unsigned int run_begin = 0;
+    for (std::size_t run = source.row_begin_[y]; run < source.row_begin_[y + 1]; ++run) {
+      // The encoded bytes are copied as is, so the decompressed image is identical to the encoded one.
+      detail::fillPattern(row + static_cast<std::size_t>(run_begin) * kBytesPerPixel,
+                          static_cast<std::size_t>(source.run_ends_[run] - run_begin) * kBytesPerPixel,
+                          source.colors_.data() + run * kBytesPerPixel, kBytesPerPixel);
+      run_begin = source.run_ends_[run];
+    }
+  }
+}
+
+}  // namespace imageview
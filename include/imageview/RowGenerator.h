@@ -0,0 +1,390 @@
+#pragma once
+
+#include <imageview/BmpCodec.h>
+#include <imageview/ImageRowView.h>
+#include <imageview/ImageView.h>
+#include <imageview/IsPixelFormat.h>
+#include <imageview/QoiCodec.h>
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// Lazy row-by-row producers based on C++20 coroutines.
+//
+// A RowGenerator is a range of ImageRowViews that are produced one at a time, when the consumer asks for the next
+// row. A consumer that stops early (e.g., a search that has found its target) never pays for the remaining rows,
+// and a producer never has to materialize the whole image.
+//
+// The frame of a coroutine is allocated from a CoroutineArena if the first 2 parameters of the coroutine are
+// (std::allocator_arg_t, CoroutineArena&); all producers below accept them. The arena reuses its memory once all
+// frames allocated from it are destroyed, so processing a sequence of images with the same arena doesn't allocate
+// memory at all.
+
+namespace imageview {
+
+// Bump allocator over a caller-provided buffer.
+// Memory is released in LIFO order: a block is reclaimed immediately if it is the most recently allocated one,
+// and the whole buffer is reclaimed once all blocks have been released. CoroutineArena is not thread-safe.
+class CoroutineArena {
+ public:
+  // Alignment of every block.
+  static constexpr std::size_t kAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+  // Constructs an arena that allocates from @buffer. The buffer must outlive the arena.
+  explicit CoroutineArena(std::span<std::byte> buffer) noexcept;
+
+  CoroutineArena(const CoroutineArena&) = delete;
+  CoroutineArena& operator=(const CoroutineArena&) = delete;
+
+  // Allocates @size bytes aligned to kAlignment.
+  // \throw std::bad_alloc if there is not enough space left in the buffer.
+  void* allocate(std::size_t size);
+
+  // Releases a block returned by allocate().
+  void deallocate(void* data, std::size_t size) noexcept;
+
+  // Returns the size of the buffer.
+  std::size_t capacity() const noexcept;
+
+  // Returns the number of bytes that are not available for allocation.
+  std::size_t bytesUsed() const noexcept;
+
+ private:
+  std::span<std::byte> buffer_;
+  std::size_t offset_ = 0;
+  std::size_t num_blocks_ = 0;
+};
+
+namespace detail {
+
+// Every coroutine frame is preceded by a header storing the arena it was allocated from (or nullptr).
+constexpr std::size_t kFrameHeaderSize = CoroutineArena::kAlignment;
+
+inline void* allocateFrame(std::size_t size, CoroutineArena* arena) {
+  std::byte* data = static_cast<std::byte*>((arena == nullptr) ? ::operator new(size + kFrameHeaderSize)
+                                                                : arena->allocate(size + kFrameHeaderSize));
+  ::new (data) CoroutineArena*(arena);
+  return data + kFrameHeaderSize;
+}
+
+inline void deallocateFrame(void* frame, std::size_t size) noexcept {
+  std::byte* data = static_cast<std::byte*>(frame) - kFrameHeaderSize;
+  CoroutineArena* arena = *std::launder(reinterpret_cast<CoroutineArena**>(data));
+  if (arena == nullptr) {
+    ::operator delete(data, size + kFrameHeaderSize);
+  } else {
+    arena->deallocate(data, size + kFrameHeaderSize);
+  }
+}
+
+// Block of memory allocated from a CoroutineArena for the lifetime of the object.
+class ArenaBuffer {
+ public:
+  ArenaBuffer(CoroutineArena& arena, std::size_t size)
+      : arena_(arena), data_(static_cast<std::byte*>(arena.allocate(size)), size) {}
+
+  ArenaBuffer(const ArenaBuffer&) = delete;
+  ArenaBuffer& operator=(const ArenaBuffer&) = delete;
+
+  ~ArenaBuffer() { arena_.deallocate(data_.data(), data_.size()); }
+
+  std::span<std::byte> data() const noexcept { return data_; }
+
+ private:
+  CoroutineArena& arena_;
+  std::span<std::byte> data_;
+};
+
+}  // namespace detail
+
+// Coroutine that yields rows of an image one at a time.
+//
+// RowGenerator is a move-only input range: begin() runs the producer up to the first row, and incrementing the
+// iterator resumes it up to the next one. A yielded row view is only guaranteed to be valid until the iterator is
+// incremented, because producers may reuse a single row buffer. Exceptions thrown by the producer are rethrown
+// from begin() and from the increment.
+//
+// \param PixelFormat - pixel format of the rows.
+// \param Mutable - if true, the rows provide write access to the pixels.
+template <class PixelFormat, bool Mutable = false>
+class RowGenerator {
+ public:
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+
+  using value_type = ImageRowView<PixelFormat, Mutable>;
+
+  class promise_type {
+   public:
+    RowGenerator get_return_object() noexcept;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+
+    std::suspend_always final_suspend() const noexcept { return {}; }
+
+    std::suspend_always yield_value(value_type row) noexcept(std::is_nothrow_copy_constructible_v<value_type>);
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    // Allocates the frame of a coroutine whose first parameters are (std::allocator_arg_t, CoroutineArena&).
+    template <class... Args>
+    static void* operator new(std::size_t size, std::allocator_arg_t, CoroutineArena& arena, Args&&...) {
+      return detail::allocateFrame(size, &arena);
+    }
+
+    // Allocates the frame of any other coroutine.
+    static void* operator new(std::size_t size) { return detail::allocateFrame(size, nullptr); }
+
+    static void operator delete(void* frame, std::size_t size) noexcept { detail::deallocateFrame(frame, size); }
+
+   private:
+    friend class RowGenerator;
+
+    std::optional<value_type> row_;
+    std::exception_ptr exception_;
+  };
+
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  // Input iterator over the rows.
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = RowGenerator::value_type;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    iterator() = default;
+
+    reference operator*() const { return *handle_.promise().row_; }
+
+    pointer operator->() const { return &*handle_.promise().row_; }
+
+    iterator& operator++();
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+      return it.handle_ == nullptr || it.handle_.done();
+    }
+
+   private:
+    friend class RowGenerator;
+
+    explicit iterator(handle_type handle) noexcept : handle_(handle) {}
+
+    handle_type handle_;
+  };
+
+  // Constructs a generator that yields no rows.
+  RowGenerator() = default;
+
+  RowGenerator(const RowGenerator&) = delete;
+  RowGenerator(RowGenerator&& other) noexcept;
+  RowGenerator& operator=(const RowGenerator&) = delete;
+  RowGenerator& operator=(RowGenerator&& other) noexcept;
+
+  // Destroys the coroutine, even if it hasn't produced all rows.
+  ~RowGenerator();
+
+  // Runs the producer up to the first row. Must be called at most once.
+  iterator begin();
+
+  std::default_sentinel_t end() const noexcept;
+
+ private:
+  explicit RowGenerator(handle_type handle) noexcept;
+
+  // Resumes the producer and rethrows its exception, if any.
+  static void resume(handle_type handle);
+
+  handle_type handle_;
+};
+
+// Yields the rows of an image.
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable> generateRows(ImageView<PixelFormat, Mutable> image);
+
+// Same as generateRows(image), but allocates the coroutine frame from @arena.
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable> generateRows(std::allocator_arg_t, CoroutineArena& arena,
+                                                ImageView<PixelFormat, Mutable> image);
+
+// Yields the rows of a BMP image from top to bottom. The rows point directly into the BMP data.
+// \param bmp - BMP image. Must outlive the generator.
+// \throw std::invalid_argument (from begin()) if PixelFormat doesn't match the bit depth of the image.
+template <class PixelFormat>
+RowGenerator<PixelFormat> generateBmpRows(std::allocator_arg_t, CoroutineArena& arena, const BmpImage& bmp);
+
+// Decodes a QOI image row by row: a row is only decoded when the consumer asks for it. The rows are decoded into a
+// single row buffer, which is allocated from @arena.
+// \param data - QOI file. Must outlive the generator.
+// \param pixel_format - instance of PixelFormat to use.
+// \throw std::runtime_error (from begin() or the increment) if the data is not a valid QOI file.
+template <class PixelFormat>
+RowGenerator<PixelFormat> decodeQoiRows(std::allocator_arg_t, CoroutineArena& arena, std::span<const std::byte> data,
+                                        PixelFormat pixel_format = PixelFormat());
+
+// Yields the rows of @source transformed by @function. A row of the source is only pulled when the consumer asks
+// for the corresponding output row. The output rows are written into a single row buffer, which is allocated from
+// @arena.
+// \param source - the input rows.
+// \param width - width of the output rows.
+// \param function - function with the signature equivalent to
+//          void function(ImageRowView<SrcFormat, SrcMutable> src, ImageRowView<DstFormat, true> dst);
+// \param pixel_format - instance of DstFormat to use.
+template <class DstFormat, class SrcFormat, bool SrcMutable, class Function>
+RowGenerator<DstFormat> transformRows(std::allocator_arg_t, CoroutineArena& arena,
+                                      RowGenerator<SrcFormat, SrcMutable> source, unsigned int width,
+                                      Function function, DstFormat pixel_format = DstFormat());
+
+inline CoroutineArena::CoroutineArena(std::span<std::byte> buffer) noexcept : buffer_(buffer) {}
+
+inline void* CoroutineArena::allocate(std::size_t size) {
+  const auto base = reinterpret_cast<std::uintptr_t>(buffer_.data());
+  const std::size_t aligned_offset = ((base + offset_ + kAlignment - 1) & ~(kAlignment - 1)) - base;
+  if (aligned_offset > buffer_.size() || size > buffer_.size() - aligned_offset)
+  {
+    throw std::bad_alloc();
+  }
+  offset_ = aligned_offset + size;
+  ++num_blocks_;
+  return buffer_.data() + aligned_offset;
+}
+
+inline void CoroutineArena::deallocate(void* data, std::size_t size) noexcept {
+  if (--num_blocks_ == 0) {
+    offset_ = 0;
+  } else if (static_cast<std::byte*>(data) + size == buffer_.data() + offset_) {
+    offset_ = static_cast<std::size_t>(static_cast<std::byte*>(data) - buffer_.data());
+  }
+}
+
+inline std::size_t CoroutineArena::capacity() const noexcept { return buffer_.size(); }
+
+inline std::size_t CoroutineArena::bytesUsed() const noexcept { return offset_; }
+
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable> RowGenerator<PixelFormat, Mutable>::promise_type::get_return_object() noexcept {
+  return RowGenerator(handle_type::from_promise(*this));
+}
+
+template <class PixelFormat, bool Mutable>
+std::suspend_always RowGenerator<PixelFormat, Mutable>::promise_type::yield_value(value_type row) noexcept(
+    std::is_nothrow_copy_constructible_v<value_type>) {
+  row_.emplace(row);
+  return {};
+}
+
+template <class PixelFormat, bool Mutable>
+auto RowGenerator<PixelFormat, Mutable>::iterator::operator++() -> iterator& {
+  RowGenerator::resume(handle_);
+  return *this;
+}
+
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable>::RowGenerator(handle_type handle) noexcept : handle_(handle) {}
+
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable>::RowGenerator(RowGenerator&& other) noexcept
+    : handle_(std::exchange(other.handle_, nullptr)) {}
+
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable>& RowGenerator<PixelFormat, Mutable>::operator=(RowGenerator&& other) noexcept {
+  if (this != &other) {
+    if (handle_ != nullptr) {
+      handle_.destroy();
+    }
+    handle_ = std::exchange(other.handle_, nullptr);
+  }
+  return *this;
+}
+
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable>::~RowGenerator() {
+  if (handle_ != nullptr) {
+    handle_.destroy();
+  }
+}
+
+template <class PixelFormat, bool Mutable>
+auto RowGenerator<PixelFormat, Mutable>::begin() -> iterator {
+  if (handle_ != nullptr) {
+    resume(handle_);
+  }
+  return iterator(handle_);
+}
+
+template <class PixelFormat, bool Mutable>
+std::default_sentinel_t RowGenerator<PixelFormat, Mutable>::end() const noexcept {
+  return std::default_sentinel;
+}
+
+template <class PixelFormat, bool Mutable>
+void RowGenerator<PixelFormat, Mutable>::resume(handle_type handle) {
+  handle.resume();
+  if (std::exception_ptr exception = std::exchange(handle.promise().exception_, nullptr)) {
+    std::rethrow_exception(exception);
+  }
+}
+
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable> generateRows(ImageView<PixelFormat, Mutable> image) {
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    co_yield image.row(y);
+  }
+}
+
+template <class PixelFormat, bool Mutable>
+RowGenerator<PixelFormat, Mutable> generateRows(std::allocator_arg_t, [[maybe_unused]] CoroutineArena& arena,
+                                                ImageView<PixelFormat, Mutable> image) {
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    co_yield image.row(y);
+  }
+}
+
+template <class PixelFormat>
+RowGenerator<PixelFormat> generateBmpRows(std::allocator_arg_t, [[maybe_unused]] CoroutineArena& arena,
+                                          const BmpImage& bmp) {
+  for (unsigned int y = 0; y < bmp.height(); ++y) {
+    co_yield bmp.row<PixelFormat>(y);
+  }
+}
+
+template <class PixelFormat>
+RowGenerator<PixelFormat> decodeQoiRows(std::allocator_arg_t, CoroutineArena& arena, std::span<const std::byte> data,
+                                        PixelFormat pixel_format) {
+  QoiDecoder decoder(data);
+  const unsigned int width = decoder.header().width;
+  const detail::ArenaBuffer buffer(arena, static_cast<std::size_t>(width) * PixelFormat::kBytesPerPixel);
+  const ImageRowView<PixelFormat, true> row(buffer.data(), width, pixel_format);
+  for (unsigned int y = 0; y < decoder.header().height; ++y) {
+    decoder.decodeRow(row);
+    co_yield ImageRowView<PixelFormat>(row);
+  }
+}
+
+template <class DstFormat, class SrcFormat, bool SrcMutable, class Function>
+RowGenerator<DstFormat> transformRows(std::allocator_arg_t, CoroutineArena& arena,
+                                      RowGenerator<SrcFormat, SrcMutable> source, unsigned int width,
+                                      Function function, DstFormat pixel_format) {
+  const detail::ArenaBuffer buffer(arena, static_cast<std::size_t>(width) * DstFormat::kBytesPerPixel);
+  const ImageRowView<DstFormat, true> row(buffer.data(), width, pixel_format);
+  for (const ImageRowView<SrcFormat, SrcMutable> src : source) {
+    function(src, row);
+    co_yield ImageRowView<DstFormat>(row);
+  }
+}
+
+}  // namespace imageview
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/internal/ImageViewFlatIterator.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+// Versions of common algorithms for ImageView::iterator.
+//
+// Iterating over an ImageView with a single loop requires checking for the end of the row after every pixel.
+// The algorithms below avoid this by splitting the range into row segments and running a separate inner loop
+// over ImageViewIterator for each of them.
+
+namespace imageview {
+
+// Invokes @function for each pixel in the range [first; last).
+// \param first, last - range of pixels.
+// \param function - function with the signature equivalent to
+//          void function(ImageView<PixelFormat, Mutable>::reference pixel);
+// \return @function.
+template <class PixelFormat, bool Mutable, class Function>
+constexpr Function forEach(detail::ImageViewFlatIterator<PixelFormat, Mutable> first,
+                           detail::ImageViewFlatIterator<PixelFormat, Mutable> last, Function function) {
+  detail::forEachSegment(first, last, [&function](auto local_first, auto local_last) {
+    for (; local_first != local_last; ++local_first) {
+      function(*local_first);
+    }
+  });
+  return function;
+}
+
+// Invokes @function for each pixel of the image.
+template <class PixelFormat, bool Mutable, class Function>
+constexpr Function forEach(ImageView<PixelFormat, Mutable> image, Function function) {
+  return forEach(image.begin(), image.end(), std::move(function));
+}
+
+// Returns the number of pixels in the range [first; last) whose color equals @value.
+template <class PixelFormat, bool Mutable>
+constexpr std::ptrdiff_t count(detail::ImageViewFlatIterator<PixelFormat, Mutable> first,
+                               detail::ImageViewFlatIterator<PixelFormat, Mutable> last,
+                               const typename PixelFormat::color_type& value) {
+  std::ptrdiff_t result = 0;
+  detail::forEachSegment(first, last, [&result, &value](auto local_first, auto local_last) {
+    result += std::count(local_first, local_last, value);
+  });
+  return result;
+}
+
+// Returns an iterator to the first pixel in the range [first; last) whose color equals @value,
+// or @last if there is no such pixel.
+template <class PixelFormat, bool Mutable>
+constexpr detail::ImageViewFlatIterator<PixelFormat, Mutable> find(
+    detail::ImageViewFlatIterator<PixelFormat, Mutable> first, detail::ImageViewFlatIterator<PixelFormat, Mutable> last,
+    const typename PixelFormat::color_type& value) {
+  while (first != last) {
+    const auto local_first = first.local();
+    const auto local_last = (first.rowIndex() == last.rowIndex()) ? last.local() : first.localEnd();
+    const auto found = std::find(local_first, local_last, value);
+    first += found - local_first;
+    if (found != local_last) {
+      return first;
+    }
+  }
+  return last;
+}
+
+}  // namespace imageview
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/IsPixelFormat.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace imageview {
+
+// Reference-counted owning image with copy-on-write semantics.
+//
+// Copying a SharedImage is cheap: the copies share the same bitmap. Read-only views can be obtained at any time
+// without copying pixels; the first request for a mutable view of a shared bitmap makes a private copy of it, so
+// the other owners never observe the modification. This lets several consumers of a frame keep it alive without
+// defensive deep copies, and only the consumers that actually modify it pay for a copy.
+//
+// Views returned by view() and mutableView() are valid until the SharedImage is destroyed, assigned to, or
+// mutableView() is called on it. A mutable view must not be used after the SharedImage has been copied: the copy
+// shares the bitmap, so writes through an earlier mutable view would be visible in it. Call mutableView() again
+// instead.
+//
+// Different SharedImage objects sharing the same bitmap can be used from different threads; a single
+// SharedImage object cannot be modified concurrently (the same guarantee as for std::shared_ptr).
+//
+// \param PixelFormat - specifies how colors are stored in the bitmap.
+template <class PixelFormat>
+class SharedImage {
+ public:
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+
+  // Constructs an empty image.
+  // \param pixel_format - instance of PixelFormat to use.
+  explicit SharedImage(const PixelFormat& pixel_format = PixelFormat());
+
+  // Constructs an image of the specified size whose bytes are all zeros.
+  // \param height - height of the image.
+  // \param width - width of the image.
+  // \param pixel_format - instance of PixelFormat to use.
+  SharedImage(unsigned int height, unsigned int width, const PixelFormat& pixel_format = PixelFormat());
+
+  // Constructs an image with a copy of the pixels of @image.
+  template <bool Mutable>
+  explicit SharedImage(ImageView<PixelFormat, Mutable> image);
+
+  // Returns the height of the image.
+  unsigned int height() const noexcept;
+
+  // Returns the width of the image.
+  unsigned int width() const noexcept;
+
+  // Returns true if the image has zero area, false otherwise.
+  bool empty() const noexcept;
+
+  // Returns the pixel format used by this image.
+  const PixelFormat& pixelFormat() const noexcept;
+
+  // Returns true if the bitmap is shared with another SharedImage, false otherwise.
+  bool isShared() const noexcept;
+
+  // Returns a read-only view into the image. Never copies pixels.
+  ImageView<PixelFormat> view() const noexcept;
+
+  // Returns a mutable view into the image.
+  // If the bitmap is shared with another SharedImage, it is copied first, and this object releases its reference
+  // to the shared bitmap.
+  ImageView<PixelFormat, true> mutableView();
+
+ private:
+  // Makes sure that this object is the only owner of the bitmap.
+  void detach();
+
+  std::shared_ptr<std::vector<std::byte>> data_;
+  unsigned int height_ = 0;
+  unsigned int width_ = 0;
+  PixelFormat pixel_format_;
+};
+
+template <class PixelFormat>
+SharedImage<PixelFormat>::SharedImage(const PixelFormat& pixel_format) : pixel_format_(pixel_format) {}
+
+template <class PixelFormat>
+SharedImage<PixelFormat>::SharedImage(unsigned int height, unsigned int width, const PixelFormat& pixel_format)
+    : data_(std::make_shared<std::vector<std::byte>>(static_cast<std::size_t>(height) * width *
+                                                     PixelFormat::kBytesPerPixel)),
+      height_(height),
+      width_(width),
+      pixel_format_(pixel_format) {}
+
+template <class PixelFormat>
+template <bool Mutable>
+SharedImage<PixelFormat>::SharedImage(ImageView<PixelFormat, Mutable> image)
+    : SharedImage(image.height(), image.width(), image.pixelFormat()) {
+  const std::size_t row_size = static_cast<std::size_t>(width_) * PixelFormat::kBytesPerPixel;
+  for (unsigned int y = 0; y < height_; ++y) {
+    std::memcpy(data_->data() + y * row_size, image.row(y).data().data(), row_size);
+  }
+}
+
+template <class PixelFormat>
+unsigned int SharedImage<PixelFormat>::height() const noexcept {
+  return height_;
+}
+
+template <class PixelFormat>
+unsigned int SharedImage<PixelFormat>::width() const noexcept {
+  return width_;
+}
+
+template <class PixelFormat>
+bool SharedImage<PixelFormat>::empty() const noexcept {
+  return height_ == 0 || width_ == 0;
+}
+
+template <class PixelFormat>
+const PixelFormat& SharedImage<PixelFormat>::pixelFormat() const noexcept {
+  return pixel_format_;
+}
+
+template <class PixelFormat>
+bool SharedImage<PixelFormat>::isShared() const noexcept {
+  return data_ != nullptr && data_.use_count() > 1;
+}
+
+template <class PixelFormat>
+ImageView<PixelFormat> SharedImage<PixelFormat>::view() const noexcept {
+  const std::span<const std::byte> data = (data_ == nullptr) ? std::span<const std::byte>() : *data_;
+  return ImageView<PixelFormat>(height_, width_, width_, data, pixel_format_);
+}
+
+template <class PixelFormat>
+ImageView<PixelFormat, true> SharedImage<PixelFormat>::mutableView() {
+  detach();
+  const std::span<std::byte> data = (data_ == nullptr) ? std::span<std::byte>() : *data_;
+  return ImageView<PixelFormat, true>(height_, width_, width_, data, pixel_format_);
+}
+
+template <class PixelFormat>
+void SharedImage<PixelFormat>::detach() {
+  if (data_ == nullptr) {
+    return;
+  }
+  if (data_.use_count() == 1) {
+    // The other owners release the bitmap with a release decrement of the reference count; the fence makes
+    // their last reads of the bitmap happen before our writes to it.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return;
+  }
+  data_ = std::make_shared<std::vector<std::byte>>(*data_);
+}
+
+}  // namespace imageview
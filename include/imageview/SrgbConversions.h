@@ -0,0 +1,194 @@
+#pragma once
+
+#include <imageview/ColorDepthConversions.h>
+#include <imageview/ImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale16.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatGrayscaleF32.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGB48.h>
+#include <imageview/pixel_formats/PixelFormatRGBF32.h>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Conversions between sRGB-encoded 8-bit images and linear-light 16-bit / floating-point images.
+//
+// Decoding (8 bits -> linear) is a lookup in a 256-entry table. Encoding (linear -> 8 bits) quantizes the linear
+// value to 16 bits and uses a bucketed inverse table: the 12 high bits select a bucket, which stores the encoded
+// value at the start of the bucket, and a single comparison with the next decision threshold gives the exact
+// result. The buckets are narrower than the distance between any 2 adjacent thresholds, so a bucket never contains
+// more than 1 threshold. All tables are computed once, on first use.
+//
+// Conventions:
+// * 8 bits -> 16 bits: round(decode(v / 255) * 65535).
+// * 16 bits -> 8 bits: round(encode(v / 65535) * 255).
+// * 8 bits -> float: decode(v / 255).
+// * float -> 8 bits: the value is saturated to [0; 1] (NaN maps to 0), rounded to 16 bits and encoded as above.
+// where decode() and encode() are the sRGB transfer functions (IEC 61966-2-1).
+
+namespace imageview {
+namespace detail {
+
+// Converts an sRGB-encoded intensity in [0; 1] into linear light.
+inline double decodeSrgb(double value) noexcept {
+  return (value <= 0.04045) ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+}
+
+// Converts a linear-light intensity in [0; 1] into sRGB encoding.
+inline double encodeSrgb(double value) noexcept {
+  return (value <= 0.0031308) ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+}
+
+class SrgbTables {
+ public:
+  // Each bucket covers 2^kBucketShift consecutive 16-bit linear values.
+  static constexpr unsigned int kBucketShift = 4;
+
+  SrgbTables();
+
+  // decode_f32[v] = decodeSrgb(v / 255).
+  std::array<float, 256> decode_f32;
+  // decode_16[v] = round(decodeSrgb(v / 255) * 65535).
+  std::array<std::uint16_t, 256> decode_16;
+  // thresholds[v] is the smallest 16-bit linear value that is encoded as v; thresholds[256] = 65536.
+  std::array<std::uint32_t, 257> thresholds;
+  // buckets[i] is the encoded value of the 16-bit linear value (i << kBucketShift).
+  std::array<std::uint8_t, (65536 >> kBucketShift)> buckets;
+
+  // Returns round(encodeSrgb(value / 65535) * 255).
+  unsigned char encode(std::uint32_t value) const noexcept {
+    const unsigned int code = buckets[value >> kBucketShift];
+    return static_cast<unsigned char>(code + (value >= thresholds[code + 1] ? 1 : 0));
+  }
+};
+
+inline SrgbTables::SrgbTables() {
+  for (unsigned int v = 0; v < 256; ++v) {
+    const double linear = decodeSrgb(v / 255.0);
+    decode_f32[v] = static_cast<float>(linear);
+    decode_16[v] = static_cast<std::uint16_t>(std::lround(linear * 65535.0));
+  }
+  thresholds.fill(65536);
+  thresholds[0] = 0;
+  long previous_code = 0;
+  for (std::uint32_t v = 0; v < 65536; ++v) {
+    const long code = std::lround(encodeSrgb(v / 65535.0) * 255.0);
+    // The encoding is monotonic and increases by at most 1 between adjacent 16-bit values.
+    if (code != previous_code) {
+      thresholds[code] = v;
+      previous_code = code;
+    }
+    if (v % (1u << kBucketShift) == 0) {
+      buckets[v >> kBucketShift] = static_cast<std::uint8_t>(code);
+    }
+  }
+}
+
+inline const SrgbTables& getSrgbTables() {
+  static const SrgbTables tables;
+  return tables;
+}
+
+template <std::endian ByteOrder>
+void decodeSrgbChannels8To16(const std::byte* src, std::byte* dst, std::size_t num_channels) {
+  const std::array<std::uint16_t, 256>& table = getSrgbTables().decode_16;
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    storeUint16<ByteOrder>(table[static_cast<unsigned char>(src[i])], std::span<std::byte, 2>(dst + 2 * i, 2));
+  }
+}
+
+template <std::endian ByteOrder>
+void encodeSrgbChannels16To8(const std::byte* src, std::byte* dst, std::size_t num_channels) {
+  const SrgbTables& tables = getSrgbTables();
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    const std::uint16_t value = loadUint16<ByteOrder>(std::span<const std::byte, 2>(src + 2 * i, 2));
+    dst[i] = static_cast<std::byte>(tables.encode(value));
+  }
+}
+
+template <std::endian ByteOrder>
+void decodeSrgbChannels8ToF32(const std::byte* src, std::byte* dst, std::size_t num_channels) {
+  const std::array<float, 256>& table = getSrgbTables().decode_f32;
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    storeFloat<ByteOrder>(table[static_cast<unsigned char>(src[i])], dst + 4 * i);
+  }
+}
+
+template <std::endian ByteOrder>
+void encodeSrgbChannelsF32To8(const std::byte* src, std::byte* dst, std::size_t num_channels) {
+  const SrgbTables& tables = getSrgbTables();
+  for (std::size_t i = 0; i < num_channels; ++i) {
+    const float value = loadClampedUnitFloat<ByteOrder>(src + 4 * i);
+    dst[i] = static_cast<std::byte>(tables.encode(static_cast<std::uint32_t>(value * 65535.0f + 0.5f)));
+  }
+}
+
+inline constexpr const char* kSrgbToLinearError = "imageview::srgbToLinear(): images must have the same dimensions.";
+inline constexpr const char* kLinearToSrgbError = "imageview::linearToSrgb(): images must have the same dimensions.";
+
+}  // namespace detail
+
+// Converts an sRGB-encoded Grayscale8 image into a linear Grayscale16 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder>
+void srgbToLinear(ImageView<PixelFormatGrayscale8> src, ImageView<BasicPixelFormatGrayscale16<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::decodeSrgbChannels8To16<ByteOrder>, detail::kSrgbToLinearError);
+}
+
+// Converts a linear Grayscale16 image into an sRGB-encoded Grayscale8 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder, bool Mutable>
+void linearToSrgb(ImageView<BasicPixelFormatGrayscale16<ByteOrder>, Mutable> src,
+                  ImageView<PixelFormatGrayscale8, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::encodeSrgbChannels16To8<ByteOrder>, detail::kLinearToSrgbError);
+}
+
+// Converts an sRGB-encoded Grayscale8 image into a linear GrayscaleF32 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder>
+void srgbToLinear(ImageView<PixelFormatGrayscale8> src, ImageView<BasicPixelFormatGrayscaleF32<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::decodeSrgbChannels8ToF32<ByteOrder>, detail::kSrgbToLinearError);
+}
+
+// Converts a linear GrayscaleF32 image into an sRGB-encoded Grayscale8 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder, bool Mutable>
+void linearToSrgb(ImageView<BasicPixelFormatGrayscaleF32<ByteOrder>, Mutable> src,
+                  ImageView<PixelFormatGrayscale8, true> dst) {
+  detail::convertChannels(src, dst, 1, detail::encodeSrgbChannelsF32To8<ByteOrder>, detail::kLinearToSrgbError);
+}
+
+// Converts an sRGB-encoded RGB24 image into a linear RGB48 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder>
+void srgbToLinear(ImageView<PixelFormatRGB24> src, ImageView<BasicPixelFormatRGB48<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::decodeSrgbChannels8To16<ByteOrder>, detail::kSrgbToLinearError);
+}
+
+// Converts a linear RGB48 image into an sRGB-encoded RGB24 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder, bool Mutable>
+void linearToSrgb(ImageView<BasicPixelFormatRGB48<ByteOrder>, Mutable> src, ImageView<PixelFormatRGB24, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::encodeSrgbChannels16To8<ByteOrder>, detail::kLinearToSrgbError);
+}
+
+// Converts an sRGB-encoded RGB24 image into a linear RGBF32 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder>
+void srgbToLinear(ImageView<PixelFormatRGB24> src, ImageView<BasicPixelFormatRGBF32<ByteOrder>, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::decodeSrgbChannels8ToF32<ByteOrder>, detail::kSrgbToLinearError);
+}
+
+// Converts a linear RGBF32 image into an sRGB-encoded RGB24 image.
+// \throw std::invalid_argument if the images have different dimensions.
+template <std::endian ByteOrder, bool Mutable>
+void linearToSrgb(ImageView<BasicPixelFormatRGBF32<ByteOrder>, Mutable> src, ImageView<PixelFormatRGB24, true> dst) {
+  detail::convertChannels(src, dst, 3, detail::encodeSrgbChannelsF32To8<ByteOrder>, detail::kLinearToSrgbError);
+}
+
+}  // namespace imageview
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <imageview/BitImageView.h>
+#include <imageview/ImageView.h>
+#include <imageview/internal/BitPacking.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatMask1.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// Binarization of grayscale images.
+//
+// Every function writes its result either into a PixelFormatGrayscale8 image (255 for foreground, 0 for background)
+// or into a bit-packed PixelFormatMask1 image. The comparisons are done by branch-free loops over raw rows, which
+// the compiler vectorizes; for bit-packed output 8 comparisons are combined into 1 byte.
+
+namespace imageview {
+namespace detail {
+
+// Writes the row @y of a binary image: the pixel x is set to 255 if is_set(x) is true, and to 0 otherwise.
+template <class IsSet>
+void writeBinaryRow(ImageView<PixelFormatGrayscale8, true> dst, unsigned int y, IsSet is_set) {
+  unsigned char* row = getRowData(dst, y);
+  for (unsigned int x = 0; x < dst.width(); ++x) {
+    row[x] = is_set(x) ? 255 : 0;
+  }
+}
+
+// Writes the row @y of a bit-packed mask: the pixel x is set if is_set(x) is true.
+template <class IsSet>
+void writeBinaryRow(BitImageView<PixelFormatMask1, true> dst, unsigned int y, IsSet is_set) {
+  std::byte* data = dst.data().data();
+  std::size_t position = dst.rowBitOffset(y);
+  const unsigned int width = dst.width();
+  unsigned int x = 0;
+  for (; x < width && position % 8 != 0; ++x, ++position) {
+    storeBits(data, position, 1, is_set(x) ? 1 : 0);
+  }
+  for (; width - x >= 8; x += 8, position += 8) {
+    unsigned int byte = 0;
+    for (unsigned int i = 0; i < 8; ++i) {
+      byte = (byte << 1) | (is_set(x + i) ? 1u : 0u);
+    }
+    data[position / 8] = static_cast<std::byte>(byte);
+  }
+  for (; x < width; ++x, ++position) {
+    storeBits(data, position, 1, is_set(x) ? 1 : 0);
+  }
+}
+
+template <class DstView>
+void thresholdImpl(ImageView<PixelFormatGrayscale8> src, DstView dst, unsigned char value) {
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::threshold(): images must have the same dimensions.");
+  }
+  for (unsigned int y = 0; y < src.height(); ++y) {
+    const unsigned char* src_row = getRowData(src, y);
+    writeBinaryRow(dst, y, [src_row, value](unsigned int x) { return src_row[x] > value; });
+  }
+}
+
+template <class DstView>
+void adaptiveThresholdImpl(ImageView<PixelFormatGrayscale8> src, DstView dst, unsigned int radius, int offset) {
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::adaptiveThreshold(): images must have the same dimensions.");
+  }
+  // The sum over a window must fit into std::uint32_t.
+  if (radius > 2047)
+  {
+    throw std::invalid_argument("imageview::adaptiveThreshold(): radius must not exceed 2047.");
+  }
+  const unsigned int height = src.height();
+  const unsigned int width = src.width();
+  if (height == 0 || width == 0) {
+    return;
+  }
+  // column_sums[x] is the sum of the column x over the rows of the current window.
+  std::vector<std::uint32_t> column_sums(width, 0);
+  // prefix_sums[x] is the sum of column_sums[0], ..., column_sums[x - 1]. It may wrap around, but the differences
+  // of its elements are still correct.
+  std::vector<std::uint32_t> prefix_sums(width + 1, 0);
+  // window_sums[x] and window_counts[x] are the sum and the number of pixels in the window centered at x.
+  std::vector<std::uint32_t> window_sums(width);
+  std::vector<std::uint32_t> column_counts(width);
+  for (unsigned int x = 0; x < width; ++x) {
+    column_counts[x] = std::min(x + radius + 1, width) - (x - std::min(x, radius));
+  }
+  const auto add_row = [&](unsigned int y) {
+    const unsigned char* row = getRowData(src, y);
+    for (unsigned int x = 0; x < width; ++x) {
+      column_sums[x] += row[x];
+    }
+  };
+  const auto remove_row = [&](unsigned int y) {
+    const unsigned char* row = getRowData(src, y);
+    for (unsigned int x = 0; x < width; ++x) {
+      column_sums[x] -= row[x];
+    }
+  };
+  for (unsigned int y = 0; y < std::min(radius, height); ++y) {
+    add_row(y);
+  }
+  for (unsigned int y = 0; y < height; ++y) {
+    if (y + radius < height) {
+      add_row(y + radius);
+    }
+    if (y > radius) {
+      remove_row(y - radius - 1);
+    }
+    for (unsigned int x = 0; x < width; ++x) {
+      prefix_sums[x + 1] = prefix_sums[x] + column_sums[x];
+    }
+    for (unsigned int x = 0; x < width; ++x) {
+      window_sums[x] = prefix_sums[std::min(x + radius + 1, width)] - prefix_sums[x - std::min(x, radius)];
+    }
+    const std::int64_t num_rows = std::min(y + radius + 1, height) - (y - std::min(y, radius));
+    const unsigned char* src_row = getRowData(src, y);
+    // pixel > mean - offset  <=>  (pixel + offset) * count > sum
+    writeBinaryRow(dst, y, [&](unsigned int x) {
+      const std::int64_t count = num_rows * column_counts[x];
+      return (static_cast<std::int64_t>(src_row[x]) + offset) * count > static_cast<std::int64_t>(window_sums[x]);
+    });
+  }
+}
+
+}  // namespace detail
+
+// Binarizes the image with a global threshold: pixels brighter than @value become foreground.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src. May be the same image as @src.
+// \param value - threshold.
+// \throw std::invalid_argument if the images have different dimensions.
+template <bool Mutable>
+void threshold(ImageView<PixelFormatGrayscale8, Mutable> src, ImageView<PixelFormatGrayscale8, true> dst,
+               unsigned char value) {
+  detail::thresholdImpl(ImageView<PixelFormatGrayscale8>(src), dst, value);
+}
+
+// Same as above, but writes the result into a bit-packed mask.
+template <bool Mutable>
+void threshold(ImageView<PixelFormatGrayscale8, Mutable> src, BitImageView<PixelFormatMask1, true> dst,
+               unsigned char value) {
+  detail::thresholdImpl(ImageView<PixelFormatGrayscale8>(src), dst, value);
+}
+
+// Computes the histogram of intensities of the image.
+template <bool Mutable>
+std::array<std::uint64_t, 256> computeHistogram(ImageView<PixelFormatGrayscale8, Mutable> image) {
+  // Several partial histograms reduce the stalls caused by incrementing the same bin repeatedly.
+  std::array<std::array<std::uint64_t, 256>, 4> partial = {};
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    const unsigned char* row = detail::getRowData(ImageView<PixelFormatGrayscale8>(image), y);
+    unsigned int x = 0;
+    for (; x + 4 <= image.width(); x += 4) {
+      ++partial[0][row[x]];
+      ++partial[1][row[x + 1]];
+      ++partial[2][row[x + 2]];
+      ++partial[3][row[x + 3]];
+    }
+    for (; x < image.width(); ++x) {
+      ++partial[0][row[x]];
+    }
+  }
+  std::array<std::uint64_t, 256> result = {};
+  for (std::size_t i = 0; i < 256; ++i) {
+    result[i] = partial[0][i] + partial[1][i] + partial[2][i] + partial[3][i];
+  }
+  return result;
+}
+
+// Computes the threshold that maximizes the between-class variance (Otsu's method).
+// Passing the result to threshold() separates the pixels into the 2 classes.
+// \return the threshold, or 0 if the image is empty.
+template <bool Mutable>
+unsigned char otsuThreshold(ImageView<PixelFormatGrayscale8, Mutable> image) {
+  const std::array<std::uint64_t, 256> histogram = computeHistogram(image);
+  const double total = static_cast<double>(image.area());
+  double total_sum = 0.0;
+  for (std::size_t i = 0; i < 256; ++i) {
+    total_sum += static_cast<double>(i) * histogram[i];
+  }
+  double background_count = 0.0;
+  double background_sum = 0.0;
+  double best_variance = -1.0;
+  unsigned char best_threshold = 0;
+  for (std::size_t t = 0; t < 256; ++t) {
+    background_count += histogram[t];
+    background_sum += static_cast<double>(t) * histogram[t];
+    const double foreground_count = total - background_count;
+    if (background_count == 0 || foreground_count == 0) {
+      continue;
+    }
+    const double mean_difference = background_sum / background_count - (total_sum - background_sum) / foreground_count;
+    const double variance = background_count * foreground_count * mean_difference * mean_difference;
+    if (variance > best_variance) {
+      best_variance = variance;
+      best_threshold = static_cast<unsigned char>(t);
+    }
+  }
+  return best_threshold;
+}
+
+// Binarizes the image with a threshold computed for each pixel from its neighbourhood: pixels brighter than
+// mean - offset, where mean is the mean intensity in the (2 * radius + 1) x (2 * radius + 1) window centered at the
+// pixel, become foreground. Pixels outside of the image are not included in the mean.
+// The means are computed with running sums, so the cost per pixel does not depend on @radius.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src and must not overlap with it.
+// \param radius - radius of the window. Must not exceed 2047.
+// \param offset - constant subtracted from the mean.
+// \throw std::invalid_argument if the images have different dimensions or @radius > 2047.
+template <bool Mutable>
+void adaptiveThreshold(ImageView<PixelFormatGrayscale8, Mutable> src, ImageView<PixelFormatGrayscale8, true> dst,
+                       unsigned int radius, int offset) {
+  detail::adaptiveThresholdImpl(ImageView<PixelFormatGrayscale8>(src), dst, radius, offset);
+}
+
+// Same as above, but writes the result into a bit-packed mask.
+template <bool Mutable>
+void adaptiveThreshold(ImageView<PixelFormatGrayscale8, Mutable> src, BitImageView<PixelFormatMask1, true> dst,
+                       unsigned int radius, int offset) {
+  detail::adaptiveThresholdImpl(ImageView<PixelFormatGrayscale8>(src), dst, radius, offset);
+}
+
+}  // namespace imageview
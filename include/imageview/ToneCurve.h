@@ -0,0 +1,193 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/internal/ByteOrder.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+// Tone curves for pixel formats with 8-bit channels.
+//
+// A ToneCurve maps each of the 256 possible channel values to a new value. Curves are stored as lookup tables, so
+// composing any number of curves produces a single table, and applying the composition costs 1 lookup per channel.
+// The image is transformed in a single pass over its rows.
+
+namespace imageview {
+
+// Lookup table mapping 8-bit channel values to 8-bit channel values.
+class ToneCurve {
+ public:
+  // Constructs the identity curve.
+  constexpr ToneCurve() noexcept;
+
+  // Constructs a curve from a lookup table: the value v is mapped to table[v].
+  constexpr explicit ToneCurve(const std::array<unsigned char, 256>& table) noexcept;
+
+  // Constructs a curve by sampling a function.
+  // \param function - function with the signature equivalent to
+  //          double function(double value);
+  //        mapping [0; 1] to [0; 1]. The value v is mapped to round(function(v / 255) * 255), saturated to
+  //        [0; 255]; NaN maps to 0.
+  template <class Function>
+  static ToneCurve fromFunction(Function function);
+
+  // Returns the curve v -> 255 * (v / 255)^gamma.
+  // \throw std::invalid_argument if @gamma is not positive.
+  static ToneCurve gamma(double gamma);
+
+  // Returns the curve that linearly maps [black; white] onto [0; 255], saturating the values outside of it.
+  // \throw std::invalid_argument if black >= white.
+  static constexpr ToneCurve levels(unsigned char black, unsigned char white);
+
+  // Returns the curve v -> 255 - v.
+  static constexpr ToneCurve invert() noexcept;
+
+  // Returns the value that @value is mapped to.
+  constexpr unsigned char operator()(unsigned char value) const noexcept;
+
+  // Returns the lookup table of the curve.
+  constexpr const std::array<unsigned char, 256>& table() const noexcept;
+
+  // Returns the curve equivalent to applying this curve and then @next.
+  constexpr ToneCurve then(const ToneCurve& next) const noexcept;
+
+ private:
+  std::array<unsigned char, 256> table_;
+};
+
+constexpr ToneCurve::ToneCurve() noexcept : table_() {
+  for (std::size_t i = 0; i < 256; ++i) {
+    table_[i] = static_cast<unsigned char>(i);
+  }
+}
+
+constexpr ToneCurve::ToneCurve(const std::array<unsigned char, 256>& table) noexcept : table_(table) {}
+
+template <class Function>
+ToneCurve ToneCurve::fromFunction(Function function) {
+  std::array<unsigned char, 256> table;
+  for (std::size_t i = 0; i < 256; ++i) {
+    const double value = detail::clampToUnit(static_cast<double>(function(static_cast<double>(i) / 255.0)));
+    table[i] = static_cast<unsigned char>(value * 255.0 + 0.5);
+  }
+  return ToneCurve(table);
+}
+
+inline ToneCurve ToneCurve::gamma(double gamma) {
+  if (!(gamma > 0.0))
+  {
+    throw std::invalid_argument("ToneCurve::gamma(): gamma must be positive.");
+  }
+  return fromFunction([gamma](double value) { return std::pow(value, gamma); });
+}
+
+constexpr ToneCurve ToneCurve::levels(unsigned char black, unsigned char white) {
+  if (black >= white)
+  {
+    throw std::invalid_argument("ToneCurve::levels(): black must be less than white.");
+  }
+  std::array<unsigned char, 256> table = {};
+  const unsigned int range = white - black;
+  for (unsigned int i = 0; i < 256; ++i) {
+    const unsigned int clamped = (i < black) ? black : ((i > white) ? white : i);
+    table[i] = static_cast<unsigned char>(((clamped - black) * 255 + range / 2) / range);
+  }
+  return ToneCurve(table);
+}
+
+constexpr ToneCurve ToneCurve::invert() noexcept {
+  std::array<unsigned char, 256> table = {};
+  for (std::size_t i = 0; i < 256; ++i) {
+    table[i] = static_cast<unsigned char>(255 - i);
+  }
+  return ToneCurve(table);
+}
+
+constexpr unsigned char ToneCurve::operator()(unsigned char value) const noexcept { return table_[value]; }
+
+constexpr const std::array<unsigned char, 256>& ToneCurve::table() const noexcept { return table_; }
+
+constexpr ToneCurve ToneCurve::then(const ToneCurve& next) const noexcept {
+  std::array<unsigned char, 256> table = {};
+  for (std::size_t i = 0; i < 256; ++i) {
+    table[i] = next.table_[table_[i]];
+  }
+  return ToneCurve(table);
+}
+
+namespace detail {
+
+// Applies a separate lookup table to each channel of the image.
+template <class PixelFormat, bool Mutable>
+void applyChannelTables(ImageView<PixelFormat, Mutable> src, ImageView<PixelFormat, true> dst,
+                        const std::array<const ToneCurve*, PixelFormat::kBytesPerPixel>& curves) {
+  constexpr std::size_t kChannels = PixelFormat::kBytesPerPixel;
+  if (src.height() != dst.height() || src.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::applyToneCurve(): images must have the same dimensions.");
+  }
+  std::array<std::array<unsigned char, 256>, kChannels> tables;
+  for (std::size_t channel = 0; channel < kChannels; ++channel) {
+    tables[channel] = curves[channel]->table();
+  }
+  const ImageView<PixelFormat> input(src);
+  for (unsigned int y = 0; y < src.height(); ++y) {
+    const unsigned char* src_row = getRowData(input, y);
+    unsigned char* dst_row = getRowData(dst, y);
+    for (std::size_t x = 0; x < src.width(); ++x) {
+      for (std::size_t channel = 0; channel < kChannels; ++channel) {
+        dst_row[x * kChannels + channel] = tables[channel][src_row[x * kChannels + channel]];
+      }
+    }
+  }
+}
+
+inline constexpr ToneCurve kIdentityToneCurve;
+
+}  // namespace detail
+
+// Applies the tone curve to every color channel of the image. The alpha channel (if any) is copied unchanged.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src. May be the same image as @src.
+// \param curve - tone curve to apply.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool Mutable>
+void applyToneCurve(ImageView<PixelFormat, Mutable> src, ImageView<PixelFormat, true> dst, const ToneCurve& curve) {
+  static_assert(detail::HasByteChannels<PixelFormat>::value, "Only pixel formats with 8-bit channels are supported.");
+  if constexpr (std::is_same_v<PixelFormat, PixelFormatRGBA32>) {
+    detail::applyChannelTables(src, dst, {&curve, &curve, &curve, &detail::kIdentityToneCurve});
+  } else if constexpr (std::is_same_v<PixelFormat, PixelFormatRGB24>) {
+    detail::applyChannelTables(src, dst, {&curve, &curve, &curve});
+  } else {
+    detail::applyChannelTables(src, dst, {&curve});
+  }
+}
+
+// Applies separate tone curves to the red, green and blue channels of the image.
+// \param src - input image.
+// \param dst - output image. Must have the same dimensions as @src. May be the same image as @src.
+// \param red - tone curve for the red channel.
+// \param green - tone curve for the green channel.
+// \param blue - tone curve for the blue channel.
+// \throw std::invalid_argument if the images have different dimensions.
+template <bool Mutable>
+void applyToneCurves(ImageView<PixelFormatRGB24, Mutable> src, ImageView<PixelFormatRGB24, true> dst,
+                     const ToneCurve& red, const ToneCurve& green, const ToneCurve& blue) {
+  detail::applyChannelTables(src, dst, {&red, &green, &blue});
+}
+
+// Same as above, but for RGBA32 images. The alpha channel is copied unchanged.
+template <bool Mutable>
+void applyToneCurves(ImageView<PixelFormatRGBA32, Mutable> src, ImageView<PixelFormatRGBA32, true> dst,
+                     const ToneCurve& red, const ToneCurve& green, const ToneCurve& blue) {
+  detail::applyChannelTables(src, dst, {&red, &green, &blue, &detail::kIdentityToneCurve});
+}
+
+}  // namespace imageview
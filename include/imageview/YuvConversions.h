@@ -0,0 +1,295 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/YuvImageView.h>
+#include <imageview/internal/ByteChannels.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Conversions between YUV 4:2:0 frames (NV12ImageView, I420ImageView) and RGB images (PixelFormatRGB24,
+// PixelFormatRGBA32).
+//
+// The conversions use 14-bit fixed-point arithmetic and process 2 rows at a time, so that every chroma sample is
+// read (or computed) once per 2x2 block of luma samples. The per-pixel loops operate on raw rows and contain no
+// branches, so the compiler vectorizes them.
+
+namespace imageview {
+
+// The matrix used to convert between RGB and YUV.
+enum class YuvMatrix {
+  // ITU-R BT.601 (SD video).
+  kBT601,
+  // ITU-R BT.709 (HD video).
+  kBT709,
+};
+
+// The range of YUV values.
+enum class YuvRange {
+  // Y is within [16; 235], U and V are within [16; 240] (the usual range for video).
+  kLimited,
+  // Y, U and V are within [0; 255] (e.g., JPEG).
+  kFull,
+};
+
+namespace detail {
+
+// The number of fractional bits in fixed-point coefficients.
+inline constexpr int kYuvFractionBits = 14;
+
+constexpr int toYuvFixedPoint(double value) noexcept {
+  const double scaled = value * (1 << kYuvFractionBits);
+  return scaled >= 0 ? static_cast<int>(scaled + 0.5) : -static_cast<int>(-scaled + 0.5);
+}
+
+// R = Y' + r_v * V'
+// G = Y' - g_u * U' - g_v * V'
+// B = Y' + b_u * U'
+// where Y' = (Y - y_offset) * y_scale, U' = U - 128, V' = V - 128.
+struct YuvToRgbCoefficients {
+  int y_offset;
+  int y_scale;
+  int r_v;
+  int g_u;
+  int g_v;
+  int b_u;
+};
+
+// Y = y_offset + y_r * R + y_g * G + y_b * B
+// U = 128 + u_r * R + u_g * G + u_b * B
+// V = 128 + v_r * R + v_g * G + v_b * B
+struct RgbToYuvCoefficients {
+  int y_offset;
+  int y_r;
+  int y_g;
+  int y_b;
+  int u_r;
+  int u_g;
+  int u_b;
+  int v_r;
+  int v_g;
+  int v_b;
+};
+
+constexpr YuvToRgbCoefficients getYuvToRgbCoefficients(YuvMatrix matrix, YuvRange range) noexcept {
+  const double kr = (matrix == YuvMatrix::kBT601) ? 0.299 : 0.2126;
+  const double kb = (matrix == YuvMatrix::kBT601) ? 0.114 : 0.0722;
+  const double kg = 1.0 - kr - kb;
+  const bool full = (range == YuvRange::kFull);
+  const double y_scale = full ? 1.0 : 255.0 / 219.0;
+  const double c_scale = full ? 1.0 : 255.0 / 224.0;
+  return YuvToRgbCoefficients{full ? 0 : 16,
+                              toYuvFixedPoint(y_scale),
+                              toYuvFixedPoint(2 * (1 - kr) * c_scale),
+                              toYuvFixedPoint(2 * kb * (1 - kb) / kg * c_scale),
+                              toYuvFixedPoint(2 * kr * (1 - kr) / kg * c_scale),
+                              toYuvFixedPoint(2 * (1 - kb) * c_scale)};
+}
+
+constexpr RgbToYuvCoefficients getRgbToYuvCoefficients(YuvMatrix matrix, YuvRange range) noexcept {
+  const double kr = (matrix == YuvMatrix::kBT601) ? 0.299 : 0.2126;
+  const double kb = (matrix == YuvMatrix::kBT601) ? 0.114 : 0.0722;
+  const double kg = 1.0 - kr - kb;
+  const bool full = (range == YuvRange::kFull);
+  const double y_scale = full ? 1.0 : 219.0 / 255.0;
+  const double c_scale = full ? 1.0 : 224.0 / 255.0;
+  const double u_scale = c_scale / (2 * (1 - kb));
+  const double v_scale = c_scale / (2 * (1 - kr));
+  return RgbToYuvCoefficients{full ? 0 : 16,
+                              toYuvFixedPoint(kr * y_scale),
+                              toYuvFixedPoint(kg * y_scale),
+                              toYuvFixedPoint(kb * y_scale),
+                              toYuvFixedPoint(-kr * u_scale),
+                              toYuvFixedPoint(-kg * u_scale),
+                              toYuvFixedPoint((1 - kb) * u_scale),
+                              toYuvFixedPoint((1 - kr) * v_scale),
+                              toYuvFixedPoint(-kg * v_scale),
+                              toYuvFixedPoint(-kb * v_scale)};
+}
+
+// Converts a fixed-point value into an 8-bit channel.
+constexpr unsigned char fromYuvFixedPoint(int value) noexcept {
+  return static_cast<unsigned char>(
+      std::clamp((value + (1 << (kYuvFractionBits - 1))) >> kYuvFractionBits, 0, 255));
+}
+
+template <class PixelFormat>
+class IsRgbByteFormat : public std::false_type {};
+
+template <>
+class IsRgbByteFormat<PixelFormatRGB24> : public std::true_type {};
+
+template <>
+class IsRgbByteFormat<PixelFormatRGBA32> : public std::true_type {};
+
+// Converts a YUV 4:2:0 frame into an RGB image.
+// \param get_chroma_rows - function that returns the pair of pointers to the U and V samples of the chroma row cy.
+// \param kChromaStep - distance between consecutive U (V) samples.
+template <std::size_t kChromaStep, class PixelFormat, class GetChromaRows>
+void yuvToRgb(ImageView<PixelFormatGrayscale8> luma, GetChromaRows get_chroma_rows, ImageView<PixelFormat, true> dst,
+              YuvMatrix matrix, YuvRange range) {
+  constexpr std::size_t kChannels = PixelFormat::kBytesPerPixel;
+  if (luma.height() != dst.height() || luma.width() != dst.width())
+  {
+    throw std::invalid_argument("imageview::convert(): images must have the same dimensions.");
+  }
+  const YuvToRgbCoefficients c = getYuvToRgbCoefficients(matrix, range);
+  const unsigned int width = luma.width();
+  // Chroma terms of the current pair of rows, upsampled to the full width.
+  std::vector<int> r_terms(width);
+  std::vector<int> g_terms(width);
+  std::vector<int> b_terms(width);
+  for (unsigned int y = 0; y < luma.height(); y += 2) {
+    const auto [u_row, v_row] = get_chroma_rows(y / 2);
+    for (unsigned int x = 0; x < width; ++x) {
+      const int u = u_row[(x / 2) * kChromaStep] - 128;
+      const int v = v_row[(x / 2) * kChromaStep] - 128;
+      r_terms[x] = c.r_v * v;
+      g_terms[x] = -c.g_u * u - c.g_v * v;
+      b_terms[x] = c.b_u * u;
+    }
+    for (unsigned int row = y; row < std::min(y + 2, luma.height()); ++row) {
+      const unsigned char* src = getRowData(luma, row);
+      unsigned char* out = getRowData(dst, row);
+      for (unsigned int x = 0; x < width; ++x) {
+        const int luma_term = (src[x] - c.y_offset) * c.y_scale;
+        out[x * kChannels] = fromYuvFixedPoint(luma_term + r_terms[x]);
+        out[x * kChannels + 1] = fromYuvFixedPoint(luma_term + g_terms[x]);
+        out[x * kChannels + 2] = fromYuvFixedPoint(luma_term + b_terms[x]);
+        if constexpr (kChannels == 4) {
+          out[x * kChannels + 3] = 255;
+        }
+      }
+    }
+  }
+}
+
+// Converts an RGB image into a YUV 4:2:0 frame. Each chroma sample is computed from the mean color of its 2x2 block.
+// \param get_chroma_rows - function that returns the pair of pointers to the U and V samples of the chroma row cy.
+// \param kChromaStep - distance between consecutive U (V) samples.
+template <std::size_t kChromaStep, class PixelFormat, class GetChromaRows>
+void rgbToYuv(ImageView<PixelFormat> src, ImageView<PixelFormatGrayscale8, true> luma, GetChromaRows get_chroma_rows,
+              YuvMatrix matrix, YuvRange range) {
+  constexpr std::size_t kChannels = PixelFormat::kBytesPerPixel;
+  if (src.height() != luma.height() || src.width() != luma.width())
+  {
+    throw std::invalid_argument("imageview::convert(): images must have the same dimensions.");
+  }
+  const RgbToYuvCoefficients c = getRgbToYuvCoefficients(matrix, range);
+  const unsigned int height = src.height();
+  const unsigned int width = src.width();
+  constexpr int kHalf = 1 << (kYuvFractionBits - 1);
+  for (unsigned int y = 0; y < height; y += 2) {
+    const unsigned int num_rows = std::min(2u, height - y);
+    for (unsigned int row = y; row < y + num_rows; ++row) {
+      const unsigned char* in = getRowData(src, row);
+      unsigned char* out = getRowData(luma, row);
+      for (unsigned int x = 0; x < width; ++x) {
+        const int value = c.y_r * in[x * kChannels] + c.y_g * in[x * kChannels + 1] + c.y_b * in[x * kChannels + 2];
+        out[x] = static_cast<unsigned char>(c.y_offset + ((value + kHalf) >> kYuvFractionBits));
+      }
+    }
+    const unsigned char* in_rows[2] = {getRowData(src, y), getRowData(src, y + num_rows - 1)};
+    const auto [u_row, v_row] = get_chroma_rows(y / 2);
+    for (unsigned int cx = 0; cx < getChromaSize(width); ++cx) {
+      // Sums of the channels over the 2x2 block; missing pixels at the right/bottom border are replicated.
+      const std::size_t x0 = 2 * cx * kChannels;
+      const std::size_t x1 = std::min(2 * cx + 1, width - 1) * kChannels;
+      int sums[3];
+      for (std::size_t channel = 0; channel < 3; ++channel) {
+        sums[channel] = in_rows[0][x0 + channel] + in_rows[0][x1 + channel] + in_rows[1][x0 + channel] +
+                        in_rows[1][x1 + channel];
+      }
+      // The sums are 4 times larger than the means, hence the 2 extra bits.
+      const int u = c.u_r * sums[0] + c.u_g * sums[1] + c.u_b * sums[2];
+      const int v = c.v_r * sums[0] + c.v_g * sums[1] + c.v_b * sums[2];
+      u_row[cx * kChromaStep] = static_cast<unsigned char>(
+          std::clamp(128 + ((u + 4 * kHalf) >> (kYuvFractionBits + 2)), 0, 255));
+      v_row[cx * kChromaStep] = static_cast<unsigned char>(
+          std::clamp(128 + ((v + 4 * kHalf) >> (kYuvFractionBits + 2)), 0, 255));
+    }
+  }
+}
+
+}  // namespace detail
+
+// Converts an NV12 frame into an RGB image.
+// \param src - input frame.
+// \param dst - output image; PixelFormat must be PixelFormatRGB24 or PixelFormatRGBA32 (alpha is set to 255).
+//        Must have the same dimensions as @src.
+// \param matrix - YUV matrix of @src.
+// \param range - YUV range of @src.
+// \throw std::invalid_argument if the images have different dimensions.
+template <bool Mutable, class PixelFormat>
+void convert(NV12ImageView<Mutable> src, ImageView<PixelFormat, true> dst, YuvMatrix matrix = YuvMatrix::kBT601,
+             YuvRange range = YuvRange::kLimited) {
+  static_assert(detail::IsRgbByteFormat<PixelFormat>::value,
+                "Only PixelFormatRGB24 and PixelFormatRGBA32 are supported.");
+  const ImageView<PixelFormatGrayscale8> chroma = src.chroma();
+  detail::yuvToRgb<2>(
+      src.luma(),
+      [chroma](unsigned int cy) {
+        const unsigned char* row = detail::getRowData(chroma, cy);
+        return std::make_pair(row, row + 1);
+      },
+      dst, matrix, range);
+}
+
+// Converts an I420 frame into an RGB image.
+// The parameters are the same as for the NV12ImageView overload.
+template <bool Mutable, class PixelFormat>
+void convert(I420ImageView<Mutable> src, ImageView<PixelFormat, true> dst, YuvMatrix matrix = YuvMatrix::kBT601,
+             YuvRange range = YuvRange::kLimited) {
+  static_assert(detail::IsRgbByteFormat<PixelFormat>::value,
+                "Only PixelFormatRGB24 and PixelFormatRGBA32 are supported.");
+  const ImageView<PixelFormatGrayscale8> u = src.u();
+  const ImageView<PixelFormatGrayscale8> v = src.v();
+  detail::yuvToRgb<1>(
+      src.luma(),
+      [u, v](unsigned int cy) { return std::make_pair(detail::getRowData(u, cy), detail::getRowData(v, cy)); }, dst,
+      matrix, range);
+}
+
+// Converts an RGB image into an NV12 frame.
+// \param src - input image; PixelFormat must be PixelFormatRGB24 or PixelFormatRGBA32 (alpha is ignored).
+// \param dst - output frame. Must have the same dimensions as @src.
+// \param matrix - YUV matrix of @dst.
+// \param range - YUV range of @dst.
+// \throw std::invalid_argument if the images have different dimensions.
+template <class PixelFormat, bool Mutable>
+void convert(ImageView<PixelFormat, Mutable> src, NV12ImageView<true> dst, YuvMatrix matrix = YuvMatrix::kBT601,
+             YuvRange range = YuvRange::kLimited) {
+  static_assert(detail::IsRgbByteFormat<PixelFormat>::value,
+                "Only PixelFormatRGB24 and PixelFormatRGBA32 are supported.");
+  const ImageView<PixelFormatGrayscale8, true> chroma = dst.chroma();
+  detail::rgbToYuv<2>(
+      ImageView<PixelFormat>(src), dst.luma(),
+      [chroma](unsigned int cy) {
+        unsigned char* row = detail::getRowData(chroma, cy);
+        return std::make_pair(row, row + 1);
+      },
+      matrix, range);
+}
+
+// Converts an RGB image into an I420 frame.
+// The parameters are the same as for the NV12ImageView overload.
+template <class PixelFormat, bool Mutable>
+void convert(ImageView<PixelFormat, Mutable> src, I420ImageView<true> dst, YuvMatrix matrix = YuvMatrix::kBT601,
+             YuvRange range = YuvRange::kLimited) {
+  static_assert(detail::IsRgbByteFormat<PixelFormat>::value,
+                "Only PixelFormatRGB24 and PixelFormatRGBA32 are supported.");
+  const ImageView<PixelFormatGrayscale8, true> u = dst.u();
+  const ImageView<PixelFormatGrayscale8, true> v = dst.v();
+  detail::rgbToYuv<1>(
+      ImageView<PixelFormat>(src), dst.luma(),
+      [u, v](unsigned int cy) { return std::make_pair(detail::getRowData(u, cy), detail::getRowData(v, cy)); },
+      matrix, range);
+}
+
+}  // namespace imageview
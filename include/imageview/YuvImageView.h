@@ -0,0 +1,227 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+// Views into YUV 4:2:0 frames.
+//
+// Chroma-subsampled layouts cannot be described by a PixelFormat, because a single chroma sample is shared by
+// 2x2 luma samples. Instead, the views below store each plane as an ImageView<PixelFormatGrayscale8>.
+// For a frame of size height x width the chroma planes have ceil(height / 2) rows of ceil(width / 2) samples.
+
+namespace imageview {
+
+// Returns the size of a chroma plane along a dimension whose luma size is @luma_size.
+constexpr unsigned int getChromaSize(unsigned int luma_size) noexcept {
+  return luma_size / 2 + luma_size % 2;
+}
+
+// Non-owning view into an NV12 frame: a luma plane followed by a plane of interleaved U and V samples.
+// \param Mutable - if true, the view provides write access to the planes.
+template <bool Mutable = false>
+class NV12ImageView {
+ public:
+  using byte_type = std::conditional_t<Mutable, std::byte, const std::byte>;
+  using plane_type = ImageView<PixelFormatGrayscale8, Mutable>;
+
+  // Constructs an empty view.
+  constexpr NV12ImageView() noexcept = default;
+
+  // Constructs a view from separate planes.
+  // \param luma - luma plane of size height x width.
+  // \param chroma - interleaved chroma plane of size getChromaSize(height) x (2 * getChromaSize(width)).
+  //        Each row stores U0, V0, U1, V1, ...
+  // \throw std::invalid_argument if the planes have inconsistent dimensions.
+  constexpr NV12ImageView(plane_type luma, plane_type chroma);
+
+  // Constructs a view into a frame stored contiguously: the luma plane without padding, immediately followed by
+  // the chroma plane without padding.
+  // \param height - height of the frame.
+  // \param width - width of the frame.
+  // \param data - frame data. Its size should be exactly
+  //          height * width + 2 * getChromaSize(height) * getChromaSize(width).
+  // \throw std::invalid_argument if @data has the wrong size.
+  constexpr NV12ImageView(unsigned int height, unsigned int width, std::span<byte_type> data);
+
+  // Construct a read-only view from a mutable view.
+  template <class Enable = std::enable_if_t<!Mutable>>
+  constexpr NV12ImageView(NV12ImageView<!Mutable> other);
+
+  // Returns the height of the frame.
+  constexpr unsigned int height() const noexcept;
+
+  // Returns the width of the frame.
+  constexpr unsigned int width() const noexcept;
+
+  // Returns the luma plane.
+  constexpr plane_type luma() const noexcept;
+
+  // Returns the interleaved chroma plane.
+  constexpr plane_type chroma() const noexcept;
+
+ private:
+  plane_type luma_;
+  plane_type chroma_;
+};
+
+// Non-owning view into an I420 frame: a luma plane, a U plane and a V plane.
+// \param Mutable - if true, the view provides write access to the planes.
+template <bool Mutable = false>
+class I420ImageView {
+ public:
+  using byte_type = std::conditional_t<Mutable, std::byte, const std::byte>;
+  using plane_type = ImageView<PixelFormatGrayscale8, Mutable>;
+
+  // Constructs an empty view.
+  constexpr I420ImageView() noexcept = default;
+
+  // Constructs a view from separate planes.
+  // \param luma - luma plane of size height x width.
+  // \param u - U plane of size getChromaSize(height) x getChromaSize(width).
+  // \param v - V plane of size getChromaSize(height) x getChromaSize(width).
+  // \throw std::invalid_argument if the planes have inconsistent dimensions.
+  constexpr I420ImageView(plane_type luma, plane_type u, plane_type v);
+
+  // Constructs a view into a frame stored contiguously: the luma plane, the U plane and the V plane, all without
+  // padding.
+  // \param height - height of the frame.
+  // \param width - width of the frame.
+  // \param data - frame data. Its size should be exactly
+  //          height * width + 2 * getChromaSize(height) * getChromaSize(width).
+  // \throw std::invalid_argument if @data has the wrong size.
+  constexpr I420ImageView(unsigned int height, unsigned int width, std::span<byte_type> data);
+
+  // Construct a read-only view from a mutable view.
+  template <class Enable = std::enable_if_t<!Mutable>>
+  constexpr I420ImageView(I420ImageView<!Mutable> other);
+
+  // Returns the height of the frame.
+  constexpr unsigned int height() const noexcept;
+
+  // Returns the width of the frame.
+  constexpr unsigned int width() const noexcept;
+
+  // Returns the luma plane.
+  constexpr plane_type luma() const noexcept;
+
+  // Returns the U plane.
+  constexpr plane_type u() const noexcept;
+
+  // Returns the V plane.
+  constexpr plane_type v() const noexcept;
+
+ private:
+  plane_type luma_;
+  plane_type u_;
+  plane_type v_;
+};
+
+template <bool Mutable>
+constexpr NV12ImageView<Mutable>::NV12ImageView(plane_type luma, plane_type chroma) : luma_(luma), chroma_(chroma) {
+  if (chroma.height() != getChromaSize(luma.height()) || chroma.width() != 2 * getChromaSize(luma.width()))
+  {
+    throw std::invalid_argument("NV12ImageView(): the chroma plane has wrong dimensions.");
+  }
+}
+
+template <bool Mutable>
+constexpr NV12ImageView<Mutable>::NV12ImageView(unsigned int height, unsigned int width, std::span<byte_type> data) {
+  const std::size_t luma_size = static_cast<std::size_t>(height) * width;
+  const std::size_t chroma_size = static_cast<std::size_t>(getChromaSize(height)) * 2 * getChromaSize(width);
+  if (data.size() != luma_size + chroma_size)
+  {
+    throw std::invalid_argument("NV12ImageView(): wrong number of bytes in the input data.");
+  }
+  luma_ = plane_type(height, width, width, data.first(luma_size));
+  chroma_ = plane_type(getChromaSize(height), 2 * getChromaSize(width), 2 * getChromaSize(width),
+                       data.subspan(luma_size));
+}
+
+template <bool Mutable>
+template <class Enable>
+constexpr NV12ImageView<Mutable>::NV12ImageView(NV12ImageView<!Mutable> other)
+    : luma_(other.luma()), chroma_(other.chroma()) {}
+
+template <bool Mutable>
+constexpr unsigned int NV12ImageView<Mutable>::height() const noexcept {
+  return luma_.height();
+}
+
+template <bool Mutable>
+constexpr unsigned int NV12ImageView<Mutable>::width() const noexcept {
+  return luma_.width();
+}
+
+template <bool Mutable>
+constexpr auto NV12ImageView<Mutable>::luma() const noexcept -> plane_type {
+  return luma_;
+}
+
+template <bool Mutable>
+constexpr auto NV12ImageView<Mutable>::chroma() const noexcept -> plane_type {
+  return chroma_;
+}
+
+template <bool Mutable>
+constexpr I420ImageView<Mutable>::I420ImageView(plane_type luma, plane_type u, plane_type v)
+    : luma_(luma), u_(u), v_(v) {
+  const unsigned int chroma_height = getChromaSize(luma.height());
+  const unsigned int chroma_width = getChromaSize(luma.width());
+  if (u.height() != chroma_height || u.width() != chroma_width || v.height() != chroma_height ||
+      v.width() != chroma_width)
+  {
+    throw std::invalid_argument("I420ImageView(): the chroma planes have wrong dimensions.");
+  }
+}
+
+template <bool Mutable>
+constexpr I420ImageView<Mutable>::I420ImageView(unsigned int height, unsigned int width, std::span<byte_type> data) {
+  const unsigned int chroma_height = getChromaSize(height);
+  const unsigned int chroma_width = getChromaSize(width);
+  const std::size_t luma_size = static_cast<std::size_t>(height) * width;
+  const std::size_t chroma_size = static_cast<std::size_t>(chroma_height) * chroma_width;
+  if (data.size() != luma_size + 2 * chroma_size)
+  {
+    throw std::invalid_argument("I420ImageView(): wrong number of bytes in the input data.");
+  }
+  luma_ = plane_type(height, width, width, data.first(luma_size));
+  u_ = plane_type(chroma_height, chroma_width, chroma_width, data.subspan(luma_size, chroma_size));
+  v_ = plane_type(chroma_height, chroma_width, chroma_width, data.subspan(luma_size + chroma_size));
+}
+
+template <bool Mutable>
+template <class Enable>
+constexpr I420ImageView<Mutable>::I420ImageView(I420ImageView<!Mutable> other)
+    : luma_(other.luma()), u_(other.u()), v_(other.v()) {}
+
+template <bool Mutable>
+constexpr unsigned int I420ImageView<Mutable>::height() const noexcept {
+  return luma_.height();
+}
+
+template <bool Mutable>
+constexpr unsigned int I420ImageView<Mutable>::width() const noexcept {
+  return luma_.width();
+}
+
+template <bool Mutable>
+constexpr auto I420ImageView<Mutable>::luma() const noexcept -> plane_type {
+  return luma_;
+}
+
+template <bool Mutable>
+constexpr auto I420ImageView<Mutable>::u() const noexcept -> plane_type {
+  return u_;
+}
+
+template <bool Mutable>
+constexpr auto I420ImageView<Mutable>::v() const noexcept -> plane_type {
+  return v_;
+}
+
+}  // namespace imageview
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace imageview {
+namespace detail {
+
+// Helper functions for bit-packed bitmaps. Bits are numbered starting from the
+// most significant bit of the first byte, i.e. the bit stream is big-endian.
+
+// Reads @num_bits consecutive bits starting at the bit @bit_position.
+// \param data - pointer to the bitmap.
+// \param bit_position - index of the first bit to read.
+// \param num_bits - the number of bits to read. Should be within [1; 64].
+// \return the read bits, the last read bit being the least significant bit of the result.
+inline std::uint64_t loadBits(const std::byte* data, std::size_t bit_position, unsigned int num_bits) noexcept {
+  const std::byte* byte = data + bit_position / 8;
+  const unsigned int available = 8 - static_cast<unsigned int>(bit_position % 8);
+  std::uint64_t result = static_cast<std::uint64_t>(*byte) & (0xFFu >> (8 - available));
+  if (num_bits <= available) {
+    return result >> (available - num_bits);
+  }
+  unsigned int remaining = num_bits - available;
+  for (++byte; remaining >= 8; ++byte, remaining -= 8) {
+    result = (result << 8) | static_cast<std::uint64_t>(*byte);
+  }
+  if (remaining != 0) {
+    result = (result << remaining) | (static_cast<std::uint64_t>(*byte) >> (8 - remaining));
+  }
+  return result;
+}
+
+// Writes the lowest @num_bits bits of @bits starting at the bit @bit_position.
+// Bits outside [bit_position; bit_position + num_bits) are not modified.
+// \param data - pointer to the bitmap.
+// \param bit_position - index of the first bit to write.
+// \param num_bits - the number of bits to write. Should be within [1; 64].
+// \param bits - the bits to write.
+inline void storeBits(std::byte* data, std::size_t bit_position, unsigned int num_bits, std::uint64_t bits) noexcept {
+  std::byte* byte = data + bit_position / 8;
+  const unsigned int head_offset = static_cast<unsigned int>(bit_position % 8);
+  if (head_offset != 0) {
+    const unsigned int available = 8 - head_offset;
+    const unsigned int count = num_bits < available ? num_bits : available;
+    const unsigned int shift = available - count;
+    const unsigned int mask = ((1u << count) - 1) << shift;
+    const unsigned int value = static_cast<unsigned int>(bits >> (num_bits - count)) << shift;
+    *byte = static_cast<std::byte>((static_cast<unsigned int>(*byte) & ~mask) | (value & mask));
+    num_bits -= count;
+    ++byte;
+  }
+  for (; num_bits >= 8; ++byte) {
+    num_bits -= 8;
+    *byte = static_cast<std::byte>(bits >> num_bits);
+  }
+  if (num_bits != 0) {
+    const unsigned int shift = 8 - num_bits;
+    const unsigned int mask = (0xFFu << shift) & 0xFFu;
+    const unsigned int value = static_cast<unsigned int>(bits << shift);
+    *byte = static_cast<std::byte>((static_cast<unsigned int>(*byte) & ~mask) | (value & mask));
+  }
+}
+
+// Returns the number of nonzero codes in the given word.
+// \param word - bitmap of kBitsPerPixel-bit codes. Each code must be aligned to a multiple of kBitsPerPixel
+//        (this holds both for the result of loadBits() and for bytes copied from memory as they are).
+template <unsigned int kBitsPerPixel>
+constexpr int countNonZeroCodes(std::uint64_t word) noexcept {
+  static_assert(kBitsPerPixel == 1 || kBitsPerPixel == 2 || kBitsPerPixel == 4, "Unsupported code size.");
+  if constexpr (kBitsPerPixel == 1) {
+    return std::popcount(word);
+  } else if constexpr (kBitsPerPixel == 2) {
+    return std::popcount((word | (word >> 1)) & 0x5555555555555555ull);
+  } else {
+    word |= word >> 1;
+    word |= word >> 2;
+    return std::popcount(word & 0x1111111111111111ull);
+  }
+}
+
+}  // namespace detail
+}  // namespace imageview
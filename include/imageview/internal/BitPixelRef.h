@@ -0,0 +1,80 @@
+#pragma once
+
+#include <imageview/IsBitPackedPixelFormat.h>
+#include <imageview/internal/ImageViewStorage.h>
+
+#include <cstddef>
+#include <functional>
+
+namespace imageview {
+namespace detail {
+
+// Proxy class that mimics a reference to a pixel in a bit-packed image.
+template <class PixelFormat>
+class BitPixelRef {
+ public:
+  static_assert(IsBitPackedPixelFormat<PixelFormat>::value, "Not a bit-packed PixelFormat.");
+
+  using color_type = typename PixelFormat::color_type;
+
+  // \param data - pointer to the byte containing the pixel.
+  // \param shift - position of the lowest bit of the pixel within the byte.
+  // \param pixel_format - PixelFormat instance to use.
+  constexpr BitPixelRef(std::byte* data, unsigned int shift, std::reference_wrapper<const PixelFormat> pixel_format);
+
+  constexpr BitPixelRef(const BitPixelRef& other) = default;
+  constexpr BitPixelRef(BitPixelRef&&) = default;
+  ~BitPixelRef() = default;
+
+  // Implicit conversion to color_type.
+  // \return the color of the referenced pixel.
+  constexpr operator color_type() const;
+
+  // Assigns the specified color to the referenced pixel.
+  // \param color - color to assign.
+  // \return *this.
+  constexpr BitPixelRef& operator=(const color_type& color);
+
+  // Assigns the specified color to the referenced pixel.
+  // Note: BitPixelRef has reference semantics, just like PixelRef.
+  constexpr BitPixelRef& operator=(const BitPixelRef& other);
+  constexpr BitPixelRef& operator=(BitPixelRef&& other);
+
+ private:
+  static constexpr unsigned int kCodeMask = (1u << PixelFormat::kBitsPerPixel) - 1;
+
+  detail::ImageViewStorage<PixelFormat, true> storage_;
+  unsigned int shift_ = 0;
+};
+
+template <class PixelFormat>
+constexpr BitPixelRef<PixelFormat>::BitPixelRef(std::byte* data, unsigned int shift,
+                                                std::reference_wrapper<const PixelFormat> pixel_format)
+    : storage_(data, pixel_format.get()), shift_(shift) {}
+
+template <class PixelFormat>
+constexpr BitPixelRef<PixelFormat>::operator color_type() const {
+  const unsigned int code = (static_cast<unsigned int>(*storage_.data_) >> shift_) & kCodeMask;
+  return storage_.pixelFormat().read(static_cast<unsigned char>(code));
+}
+
+template <class PixelFormat>
+constexpr BitPixelRef<PixelFormat>& BitPixelRef<PixelFormat>::operator=(const color_type& color) {
+  const unsigned int code = storage_.pixelFormat().write(color) & kCodeMask;
+  const unsigned int old_bits = static_cast<unsigned int>(*storage_.data_) & ~(kCodeMask << shift_);
+  *storage_.data_ = static_cast<std::byte>(old_bits | (code << shift_));
+  return *this;
+}
+
+template <class PixelFormat>
+constexpr BitPixelRef<PixelFormat>& BitPixelRef<PixelFormat>::operator=(const BitPixelRef& other) {
+  return *this = static_cast<color_type>(other);
+}
+
+template <class PixelFormat>
+constexpr BitPixelRef<PixelFormat>& BitPixelRef<PixelFormat>::operator=(BitPixelRef&& other) {
+  return *this = static_cast<color_type>(other);
+}
+
+}  // namespace detail
+}  // namespace imageview
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <imageview/ImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace imageview {
+namespace detail {
+
+// Trait for pixel formats whose every byte is an independent unsigned 8-bit channel.
+template <class PixelFormat>
+class HasByteChannels : public std::false_type {};
+
+template <>
+class HasByteChannels<PixelFormatGrayscale8> : public std::true_type {};
+
+template <>
+class HasByteChannels<PixelFormatRGB24> : public std::true_type {};
+
+template <>
+class HasByteChannels<PixelFormatRGBA32> : public std::true_type {};
+
+template <class PixelFormat>
+const unsigned char* getRowData(ImageView<PixelFormat> image, unsigned int y) noexcept {
+  return reinterpret_cast<const unsigned char*>(image.data().data()) +
+         static_cast<std::size_t>(y) * image.stride() * PixelFormat::kBytesPerPixel;
+}
+
+template <class PixelFormat>
+unsigned char* getRowData(ImageView<PixelFormat, true> image, unsigned int y) noexcept {
+  return reinterpret_cast<unsigned char*>(image.data().data()) +
+         static_cast<std::size_t>(y) * image.stride() * PixelFormat::kBytesPerPixel;
+}
+
+}  // namespace detail
+}  // namespace imageview
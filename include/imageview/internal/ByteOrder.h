@@ -0,0 +1,93 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace imageview {
+namespace detail {
+
+// Helper functions for pixel formats whose channels occupy several bytes.
+// \param ByteOrder - order of bytes within a channel in the bitmap; must be either
+//        std::endian::little or std::endian::big.
+
+template <std::endian ByteOrder>
+constexpr std::uint16_t loadUint16(std::span<const std::byte, 2> data) noexcept {
+  static_assert(ByteOrder == std::endian::little || ByteOrder == std::endian::big, "Unsupported byte order.");
+  const auto byte0 = static_cast<std::uint16_t>(data[0]);
+  const auto byte1 = static_cast<std::uint16_t>(data[1]);
+  if constexpr (ByteOrder == std::endian::little) {
+    return static_cast<std::uint16_t>(byte0 | (byte1 << 8));
+  } else {
+    return static_cast<std::uint16_t>((byte0 << 8) | byte1);
+  }
+}
+
+template <std::endian ByteOrder>
+constexpr void storeUint16(std::uint16_t value, std::span<std::byte, 2> data) noexcept {
+  static_assert(ByteOrder == std::endian::little || ByteOrder == std::endian::big, "Unsupported byte order.");
+  const auto low = static_cast<std::byte>(value & 0xFF);
+  const auto high = static_cast<std::byte>(value >> 8);
+  data[ByteOrder == std::endian::little ? 0 : 1] = low;
+  data[ByteOrder == std::endian::little ? 1 : 0] = high;
+}
+
+template <std::endian ByteOrder>
+constexpr std::uint32_t loadUint32(std::span<const std::byte, 4> data) noexcept {
+  static_assert(ByteOrder == std::endian::little || ByteOrder == std::endian::big, "Unsupported byte order.");
+  std::uint32_t result = 0;
+  for (int i = 0; i < 4; ++i) {
+    const int index = (ByteOrder == std::endian::little) ? (3 - i) : i;
+    result = (result << 8) | static_cast<std::uint32_t>(data[index]);
+  }
+  return result;
+}
+
+template <std::endian ByteOrder>
+constexpr void storeUint32(std::uint32_t value, std::span<std::byte, 4> data) noexcept {
+  static_assert(ByteOrder == std::endian::little || ByteOrder == std::endian::big, "Unsupported byte order.");
+  for (int i = 0; i < 4; ++i) {
+    const int index = (ByteOrder == std::endian::little) ? i : (3 - i);
+    data[index] = static_cast<std::byte>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+// Loads an IEEE 754 binary32 number from @data[0; 4).
+template <std::endian ByteOrder>
+inline float loadFloat(const std::byte* data) noexcept {
+  if constexpr (ByteOrder == std::endian::native) {
+    float value;
+    std::memcpy(&value, data, 4);
+    return value;
+  } else {
+    return std::bit_cast<float>(loadUint32<ByteOrder>(std::span<const std::byte, 4>(data, 4)));
+  }
+}
+
+// Stores an IEEE 754 binary32 number into @data[0; 4).
+template <std::endian ByteOrder>
+inline void storeFloat(float value, std::byte* data) noexcept {
+  if constexpr (ByteOrder == std::endian::native) {
+    std::memcpy(data, &value, 4);
+  } else {
+    storeUint32<ByteOrder>(std::bit_cast<std::uint32_t>(value), std::span<std::byte, 4>(data, 4));
+  }
+}
+
+// Clamps @value to [0; 1]; NaN is mapped to 0.
+template <class T>
+constexpr T clampToUnit(T value) noexcept {
+  // Written so that NaN fails both comparisons and ends up as 0.
+  return (value > T(0)) ? ((value < T(1)) ? value : T(1)) : T(0);
+}
+
+// Loads an IEEE 754 binary32 number from @data[0; 4) and clamps it to [0; 1]; NaN is mapped to 0.
+template <std::endian ByteOrder>
+inline float loadClampedUnitFloat(const std::byte* data) noexcept {
+  return clampToUnit(loadFloat<ByteOrder>(data));
+}
+
+}  // namespace detail
+}  // namespace imageview
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <imageview/IsPixelFormat.h>
+#include <imageview/internal/ImageViewIterator.h>
+#include <imageview/internal/ImageViewStorage.h>
+#include <imageview/internal/PixelRef.h>
+
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+namespace imageview {
+namespace detail {
+
+// Iterator over all pixels of an image whose rows may have gaps between them (e.g., ImageView).
+// Pixels are traversed in row-major order; the gaps between rows are skipped.
+//
+// This is a segmented iterator: each row is a segment, within which pixels are stored continuously.
+// rowIndex(), local() and localEnd() expose this structure, which allows algorithms to process a range
+// row by row with ImageViewIterator (i.e. without checking for the end of the row after every pixel);
+// see forEachSegment().
+template <class PixelFormat, bool Mutable>
+class ImageViewFlatIterator {
+  using byte_type = std::conditional_t<Mutable, std::byte, const std::byte>;
+
+ public:
+  static_assert(IsPixelFormat<PixelFormat>::value, "Not a PixelFormat.");
+
+  using difference_type = std::ptrdiff_t;
+  using value_type = typename PixelFormat::color_type;
+  using pointer = void;
+  using reference = std::conditional_t<Mutable, PixelRef<PixelFormat>, value_type>;
+  using iterator_category = std::input_iterator_tag;
+  // Iterator within a single row.
+  using local_iterator = ImageViewIterator<PixelFormat, Mutable>;
+
+  template <class Enable = std::enable_if_t<std::is_default_constructible_v<PixelFormat>>>
+  constexpr ImageViewFlatIterator() noexcept(noexcept(std::is_nothrow_default_constructible_v<PixelFormat>)) {}
+
+  // Constructs an iterator pointing to the pixel (y, x).
+  // \param data - pointer to the pixel (0, 0) of the image.
+  // \param width - width of the image.
+  // \param stride - distance (in pixels) between the first pixels of consecutive rows.
+  // \param y - Y coordinate of the pixel.
+  // \param x - X coordinate of the pixel. Should be within [0; width).
+  // \param pixel_format - PixelFormat instance to use.
+  constexpr ImageViewFlatIterator(byte_type* data, unsigned int width, unsigned int stride, unsigned int y,
+                                  unsigned int x, const PixelFormat& pixel_format);
+
+  constexpr const PixelFormat& pixelFormat() const noexcept;
+
+  // Returns the Y coordinate of the pixel this iterator points to.
+  constexpr unsigned int rowIndex() const noexcept;
+
+  // Returns the X coordinate of the pixel this iterator points to.
+  constexpr unsigned int columnIndex() const noexcept;
+
+  // Returns an iterator within the current row pointing to the same pixel.
+  constexpr local_iterator local() const noexcept;
+
+  // Returns an iterator past the last pixel of the current row.
+  constexpr local_iterator localEnd() const noexcept;
+
+  constexpr reference operator*() const;
+
+  constexpr reference operator[](std::ptrdiff_t index) const;
+
+  constexpr ImageViewFlatIterator& operator++() noexcept;
+
+  constexpr ImageViewFlatIterator operator++(int) noexcept;
+
+  constexpr ImageViewFlatIterator& operator+=(std::ptrdiff_t n) noexcept;
+
+  constexpr ImageViewFlatIterator operator+(std::ptrdiff_t n) const noexcept;
+
+  constexpr ImageViewFlatIterator& operator--() noexcept;
+
+  constexpr ImageViewFlatIterator operator--(int) noexcept;
+
+  constexpr ImageViewFlatIterator& operator-=(std::ptrdiff_t n) noexcept;
+
+  constexpr ImageViewFlatIterator operator-(std::ptrdiff_t n) const noexcept;
+
+  constexpr bool operator==(const ImageViewFlatIterator& other) const noexcept;
+
+  constexpr bool operator!=(const ImageViewFlatIterator& other) const noexcept;
+
+  constexpr bool operator<(const ImageViewFlatIterator& other) const noexcept;
+
+  constexpr bool operator<=(const ImageViewFlatIterator& other) const noexcept;
+
+  constexpr bool operator>(const ImageViewFlatIterator& other) const noexcept;
+
+  constexpr bool operator>=(const ImageViewFlatIterator& other) const noexcept;
+
+  constexpr std::ptrdiff_t operator-(const ImageViewFlatIterator& other) const noexcept;
+
+ private:
+  // Returns the index of the current pixel in the row-major order.
+  constexpr std::ptrdiff_t linearIndex() const noexcept;
+
+  constexpr void setLinearIndex(std::ptrdiff_t index) noexcept;
+
+  constexpr byte_type* pixelData() const noexcept;
+
+  // Pointer to the pixel (0, 0).
+  ImageViewStorage<PixelFormat, Mutable> storage_;
+  unsigned int width_ = 0;
+  unsigned int stride_ = 0;
+  unsigned int y_ = 0;
+  unsigned int x_ = 0;
+};
+
+// Invokes @function(local_first, local_last) for each row segment of the range [first; last), where
+// [local_first; local_last) is a range of ImageViewIterator.
+template <class PixelFormat, bool Mutable, class Function>
+constexpr void forEachSegment(ImageViewFlatIterator<PixelFormat, Mutable> first,
+                              ImageViewFlatIterator<PixelFormat, Mutable> last, Function function) {
+  for (; first.rowIndex() < last.rowIndex(); first += first.localEnd() - first.local()) {
+    function(first.local(), first.localEnd());
+  }
+  if (first.columnIndex() < last.columnIndex()) {
+    function(first.local(), last.local());
+  }
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr ImageViewFlatIterator<PixelFormat, Mutable>::ImageViewFlatIterator(byte_type* data, unsigned int width,
+                                                                             unsigned int stride, unsigned int y,
+                                                                             unsigned int x,
+                                                                             const PixelFormat& pixel_format)
+    : storage_(data, pixel_format), width_(width), stride_(stride), y_(y), x_(x) {}
+
+template <class PixelFormat, bool Mutable>
+constexpr const PixelFormat& ImageViewFlatIterator<PixelFormat, Mutable>::pixelFormat() const noexcept {
+  return storage_.pixelFormat();
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr unsigned int ImageViewFlatIterator<PixelFormat, Mutable>::rowIndex() const noexcept {
+  return y_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr unsigned int ImageViewFlatIterator<PixelFormat, Mutable>::columnIndex() const noexcept {
+  return x_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::pixelData() const noexcept -> byte_type* {
+  return storage_.data_ + (static_cast<std::size_t>(y_) * stride_ + x_) * PixelFormat::kBytesPerPixel;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::local() const noexcept -> local_iterator {
+  return local_iterator(pixelData(), pixelFormat());
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::localEnd() const noexcept -> local_iterator {
+  return local_iterator(pixelData() + static_cast<std::size_t>(width_ - x_) * PixelFormat::kBytesPerPixel,
+                        pixelFormat());
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator*() const -> reference {
+  return *local();
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator[](std::ptrdiff_t index) const -> reference {
+  return *(*this + index);
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr std::ptrdiff_t ImageViewFlatIterator<PixelFormat, Mutable>::linearIndex() const noexcept {
+  return static_cast<std::ptrdiff_t>(y_) * width_ + x_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr void ImageViewFlatIterator<PixelFormat, Mutable>::setLinearIndex(std::ptrdiff_t index) noexcept {
+  if (width_ == 0) {
+    return;
+  }
+  y_ = static_cast<unsigned int>(index / width_);
+  x_ = static_cast<unsigned int>(index % width_);
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator++() noexcept -> ImageViewFlatIterator& {
+  if (++x_ == width_) {
+    x_ = 0;
+    ++y_;
+  }
+  return *this;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator++(int) noexcept -> ImageViewFlatIterator {
+  ImageViewFlatIterator result = *this;
+  ++(*this);
+  return result;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator+=(std::ptrdiff_t n) noexcept
+    -> ImageViewFlatIterator& {
+  setLinearIndex(linearIndex() + n);
+  return *this;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator+(std::ptrdiff_t n) const noexcept
+    -> ImageViewFlatIterator {
+  ImageViewFlatIterator result = *this;
+  result += n;
+  return result;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator--() noexcept -> ImageViewFlatIterator& {
+  if (x_ == 0) {
+    x_ = width_;
+    --y_;
+  }
+  --x_;
+  return *this;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator--(int) noexcept -> ImageViewFlatIterator {
+  ImageViewFlatIterator result = *this;
+  --(*this);
+  return result;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator-=(std::ptrdiff_t n) noexcept
+    -> ImageViewFlatIterator& {
+  setLinearIndex(linearIndex() - n);
+  return *this;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr auto ImageViewFlatIterator<PixelFormat, Mutable>::operator-(std::ptrdiff_t n) const noexcept
+    -> ImageViewFlatIterator {
+  ImageViewFlatIterator result = *this;
+  result -= n;
+  return result;
+}
+
+// As with ImageViewIterator, comparison operators only need to work for iterators into the same image.
+template <class PixelFormat, bool Mutable>
+constexpr bool ImageViewFlatIterator<PixelFormat, Mutable>::operator==(
+    const ImageViewFlatIterator& other) const noexcept {
+  return y_ == other.y_ && x_ == other.x_;
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr bool ImageViewFlatIterator<PixelFormat, Mutable>::operator!=(
+    const ImageViewFlatIterator& other) const noexcept {
+  return !(*this == other);
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr bool ImageViewFlatIterator<PixelFormat, Mutable>::operator<(
+    const ImageViewFlatIterator& other) const noexcept {
+  return linearIndex() < other.linearIndex();
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr bool ImageViewFlatIterator<PixelFormat, Mutable>::operator<=(
+    const ImageViewFlatIterator& other) const noexcept {
+  return linearIndex() <= other.linearIndex();
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr bool ImageViewFlatIterator<PixelFormat, Mutable>::operator>(
+    const ImageViewFlatIterator& other) const noexcept {
+  return linearIndex() > other.linearIndex();
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr bool ImageViewFlatIterator<PixelFormat, Mutable>::operator>=(
+    const ImageViewFlatIterator& other) const noexcept {
+  return linearIndex() >= other.linearIndex();
+}
+
+template <class PixelFormat, bool Mutable>
+constexpr std::ptrdiff_t ImageViewFlatIterator<PixelFormat, Mutable>::operator-(
+    const ImageViewFlatIterator& other) const noexcept {
+  return linearIndex() - other.linearIndex();
+}
+
+}  // namespace detail
+}  // namespace imageview
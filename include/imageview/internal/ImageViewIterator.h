@@ -1,5 +1,6 @@
 #pragma once
 
+#include <imageview/Instrumentation.h>
 #include <imageview/IsPixelFormat.h>
 #include <imageview/internal/ImageViewStorage.h>
 #include <imageview/internal/PixelRef.h>
@@ -109,6 +110,7 @@ constexpr auto ImageViewIterator<PixelFormat, Mutable>::operator*() const -> ref
   if constexpr (Mutable) {
     return PixelRef<PixelFormat>(getPixelData(), pixelFormat());
   } else {
+    instrumentPixelRead<PixelFormat>(storage_.data_);
     return pixelFormat().read(getPixelData());
   }
 }
@@ -125,6 +127,7 @@ constexpr auto ImageViewIterator<PixelFormat, Mutable>::operator[](std::ptrdiff_
   if constexpr (Mutable) {
     return PixelRef<PixelFormat>(pixel_data, pixelFormat());
   } else {
+    instrumentPixelRead<PixelFormat>(pixel_data.data());
     return pixelFormat().read(pixel_data);
   }
 }
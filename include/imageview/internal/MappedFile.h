@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace imageview {
+namespace detail {
+
+// Read-only memory mapping of a whole file.
+// MappedFile is movable, but not copyable.
+class MappedFile {
+ public:
+  // Constructs an object that doesn't map anything.
+  MappedFile() = default;
+
+  // Maps the file @path into memory.
+  // \throw std::runtime_error if the file cannot be opened or mapped.
+  explicit MappedFile(const std::filesystem::path& path);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  // Returns the contents of the file.
+  std::span<const std::byte> data() const noexcept;
+
+ private:
+  void unmap() noexcept;
+
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+inline MappedFile::MappedFile(const std::filesystem::path& path) {
+  const std::string error_message = "MappedFile(): failed to map the file " + path.string();
+#if defined(_WIN32)
+  const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    throw std::runtime_error(error_message);
+  }
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file, &file_size))
+  {
+    CloseHandle(file);
+    throw std::runtime_error(error_message);
+  }
+  if (file_size.QuadPart == 0) {
+    CloseHandle(file);
+    return;
+  }
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    throw std::runtime_error(error_message);
+  }
+  const void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (address == nullptr)
+  {
+    throw std::runtime_error(error_message);
+  }
+  data_ = static_cast<const std::byte*>(address);
+  size_ = static_cast<std::size_t>(file_size.QuadPart);
+#else
+  const int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file < 0)
+  {
+    throw std::runtime_error(error_message);
+  }
+  struct stat file_info;
+  if (::fstat(file, &file_info) != 0)
+  {
+    ::close(file);
+    throw std::runtime_error(error_message);
+  }
+  if (file_info.st_size == 0) {
+    ::close(file);
+    return;
+  }
+  const std::size_t size = static_cast<std::size_t>(file_info.st_size);
+  void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+  ::close(file);
+  if (address == MAP_FAILED)
+  {
+    throw std::runtime_error(error_message);
+  }
+  data_ = static_cast<const std::byte*>(address);
+  size_ = size;
+#endif
+}
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+inline MappedFile::~MappedFile() { unmap(); }
+
+inline std::span<const std::byte> MappedFile::data() const noexcept { return std::span(data_, size_); }
+
+inline void MappedFile::unmap() noexcept {
+  if (data_ == nullptr) {
+    return;
+  }
+#if defined(_WIN32)
+  UnmapViewOfFile(data_);
+#else
+  ::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+}
+
+}  // namespace detail
+}  // namespace imageview
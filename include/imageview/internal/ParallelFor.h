@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace imageview {
+namespace detail {
+
+// Returns the number of bands parallelFor() splits @count items into.
+constexpr std::size_t getNumBands(std::size_t count, unsigned int num_threads) noexcept {
+  return std::max<std::size_t>(1, std::min<std::size_t>(count, num_threads));
+}
+
+// Splits [0; count) into getNumBands(count, num_threads) contiguous bands of (almost) equal size
+// and invokes @function for each band; bands are processed in parallel.
+// \param count - the number of items.
+// \param num_threads - the maximum number of threads to use (including the calling thread).
+//        0 and 1 mean that everything is done on the calling thread.
+// \param function - function with the signature equivalent to
+//          void function(std::size_t band, std::size_t first, std::size_t last);
+//        It must not throw exceptions.
+template <class Function>
+void parallelFor(std::size_t count, unsigned int num_threads, Function function) {
+  const std::size_t num_bands = getNumBands(count, num_threads);
+  if (num_bands == 1) {
+    function(std::size_t{0}, std::size_t{0}, count);
+    return;
+  }
+  const auto band_begin = [count, num_bands](std::size_t band) { return count * band / num_bands; };
+  std::vector<std::thread> threads;
+  threads.reserve(num_bands - 1);
+  for (std::size_t band = 1; band < num_bands; ++band) {
+    threads.emplace_back(function, band, band_begin(band), band_begin(band + 1));
+  }
+  function(std::size_t{0}, std::size_t{0}, band_begin(1));
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace detail
+}  // namespace imageview
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <imageview/Instrumentation.h>
 #include <imageview/IsPixelFormat.h>
+#include <imageview/IsTriviallyEncoded.h>
 #include <imageview/internal/ImageViewStorage.h>
 
+#include <cstring>
 #include <span>
+#include <type_traits>
 
 namespace imageview {
 namespace detail {
@@ -52,6 +56,7 @@ template <class PixelFormat>
 constexpr PixelRef<PixelFormat>::operator color_type() const {
   constexpr std::size_t kBytesPerPixel = PixelFormat::kBytesPerPixel;
   const std::span<const std::byte, kBytesPerPixel> pixel_data(storage_.data_, kBytesPerPixel);
+  detail::instrumentPixelRead<PixelFormat>(storage_.data_);
   return storage_.pixelFormat().read(pixel_data);
 }
 
@@ -59,22 +64,30 @@ template <class PixelFormat>
 constexpr PixelRef<PixelFormat>& PixelRef<PixelFormat>::operator=(const color_type& color) {
   constexpr std::size_t kBytesPerPixel = PixelFormat::kBytesPerPixel;
   const std::span<std::byte, kBytesPerPixel> pixel_data(storage_.data_, kBytesPerPixel);
+  detail::instrumentPixelWrite<PixelFormat>(storage_.data_);
   storage_.pixelFormat().write(color, pixel_data);
   return *this;
 }
 
 template <class PixelFormat>
 constexpr PixelRef<PixelFormat>& PixelRef<PixelFormat>::operator=(const PixelRef& other) {
-  // TODO: In theory, we could just memcpy() the binary data. However, if PixelFormat is stateful,
-  // and the state of our PixelFormat differs from the state of @other, then simply copying the binary
-  // data might lead to the wrong result.
-  // Possible workaround: add a constexpr if for the case when PixelFormat is an empty class.
+  // If PixelFormat is stateful, and the state of our PixelFormat differs from the state of @other, then simply
+  // copying the binary data might lead to the wrong result. This cannot happen for trivially encoded formats.
+  if constexpr (IsTriviallyEncoded<PixelFormat>::value) {
+    if (!std::is_constant_evaluated()) {
+      detail::instrumentPixelRead<PixelFormat>(other.storage_.data_);
+      detail::instrumentPixelWrite<PixelFormat>(storage_.data_);
+      // std::memmove() rather than std::memcpy(): the pixels may be the same (e.g., img(y, x) = img(y, x)).
+      std::memmove(storage_.data_, other.storage_.data_, PixelFormat::kBytesPerPixel);
+      return *this;
+    }
+  }
   return *this = static_cast<color_type>(other);
 }
 
 template <class PixelFormat>
 constexpr PixelRef<PixelFormat>& PixelRef<PixelFormat>::operator=(PixelRef&& other) {
-  return *this = static_cast<color_type>(other);
+  return *this = static_cast<const PixelRef&>(other);
 }
 
 }  // namespace detail
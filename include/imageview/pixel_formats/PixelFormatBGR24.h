@@ -0,0 +1,37 @@
+#pragma once
+
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <cstddef>
+#include <span>
+
+namespace imageview {
+
+// Implementation of the PixelFormat concept for BGR24 pixel format.
+// In this pixel format the color is represented via 3 8-bit integers,
+// specifying the red, green and blue channels. When serializing to /
+// deserializing from a byte array, the order of the channels is BGR (e.g.,
+// as in BMP files). The color type is RGB24, so BGR24 images can be used
+// interchangeably with RGB24 images in algorithms that operate on colors.
+class PixelFormatBGR24 {
+ public:
+  using color_type = RGB24;
+  static constexpr int kBytesPerPixel = 3;
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const;
+};
+
+constexpr PixelFormatBGR24::color_type PixelFormatBGR24::read(std::span<const std::byte, kBytesPerPixel> data) const {
+  return color_type(static_cast<unsigned char>(data[2]), static_cast<unsigned char>(data[1]),
+                    static_cast<unsigned char>(data[0]));
+}
+
+constexpr void PixelFormatBGR24::write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const {
+  data[0] = static_cast<std::byte>(color.blue);
+  data[1] = static_cast<std::byte>(color.green);
+  data[2] = static_cast<std::byte>(color.red);
+}
+
+}  // namespace imageview
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+
+#include <cstddef>
+#include <span>
+
+namespace imageview {
+
+// Implementation of the PixelFormat concept for BGRA32 pixel format.
+// In this pixel format the color is represented via 4 8-bit integers,
+// specifying the red, green, blue and alpha channels. When serializing to /
+// deserializing from a byte array, the order of the channels is BGRA (e.g.,
+// as in 32-bit BMP files). The color type is RGBA32.
+class PixelFormatBGRA32 {
+ public:
+  using color_type = RGBA32;
+  static constexpr int kBytesPerPixel = 4;
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const;
+};
+
+constexpr PixelFormatBGRA32::color_type PixelFormatBGRA32::read(
+    std::span<const std::byte, kBytesPerPixel> data) const {
+  return color_type(static_cast<unsigned char>(data[2]), static_cast<unsigned char>(data[1]),
+                    static_cast<unsigned char>(data[0]), static_cast<unsigned char>(data[3]));
+}
+
+constexpr void PixelFormatBGRA32::write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const {
+  data[0] = static_cast<std::byte>(color.blue);
+  data[1] = static_cast<std::byte>(color.green);
+  data[2] = static_cast<std::byte>(color.red);
+  data[3] = static_cast<std::byte>(color.alpha);
+}
+
+}  // namespace imageview
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <imageview/internal/ByteOrder.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace imageview {
+
+// Implementation of the PixelFormat concept for the 16-bit grayscale pixel
+// format.
+// \param ByteOrder - order of bytes of the intensity in the bitmap.
+template <std::endian ByteOrder>
+class BasicPixelFormatGrayscale16 {
+ public:
+  using color_type = std::uint16_t;
+  static constexpr int kBytesPerPixel = 2;
+  // The bitmap stores the object representation of color_type only if ByteOrder is the native byte order.
+  static constexpr bool kIsTriviallyEncoded = (ByteOrder == std::endian::native);
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const;
+};
+
+// 16-bit grayscale pixel format with little-endian intensities.
+using PixelFormatGrayscale16 = BasicPixelFormatGrayscale16<std::endian::little>;
+// 16-bit grayscale pixel format with big-endian intensities (e.g., as in PNG or PGM).
+using PixelFormatGrayscale16BE = BasicPixelFormatGrayscale16<std::endian::big>;
+
+template <std::endian ByteOrder>
+constexpr auto BasicPixelFormatGrayscale16<ByteOrder>::read(std::span<const std::byte, kBytesPerPixel> data) const
+    -> color_type {
+  return detail::loadUint16<ByteOrder>(data);
+}
+
+template <std::endian ByteOrder>
+constexpr void BasicPixelFormatGrayscale16<ByteOrder>::write(const color_type& color,
+                                                             std::span<std::byte, kBytesPerPixel> data) const {
+  detail::storeUint16<ByteOrder>(color, data);
+}
+
+}  // namespace imageview
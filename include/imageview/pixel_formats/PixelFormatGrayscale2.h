@@ -0,0 +1,26 @@
+#pragma once
+
+namespace imageview {
+
+// Implementation of the bit-packed PixelFormat concept for the 2-bit grayscale
+// pixel format. The color is an intensity within [0; 3].
+class PixelFormatGrayscale2 {
+ public:
+  using color_type = unsigned char;
+  static constexpr int kBitsPerPixel = 2;
+
+  constexpr color_type read(unsigned char code) const;
+
+  // Stores the lowest 2 bits of @color.
+  constexpr unsigned char write(const color_type& color) const;
+};
+
+constexpr PixelFormatGrayscale2::color_type PixelFormatGrayscale2::read(unsigned char code) const {
+  return static_cast<color_type>(code & 3);
+}
+
+constexpr unsigned char PixelFormatGrayscale2::write(const color_type& color) const {
+  return static_cast<unsigned char>(color & 3);
+}
+
+}  // namespace imageview
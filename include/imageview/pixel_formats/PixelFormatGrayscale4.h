@@ -0,0 +1,26 @@
+#pragma once
+
+namespace imageview {
+
+// Implementation of the bit-packed PixelFormat concept for the 4-bit grayscale
+// pixel format. The color is an intensity within [0; 15].
+class PixelFormatGrayscale4 {
+ public:
+  using color_type = unsigned char;
+  static constexpr int kBitsPerPixel = 4;
+
+  constexpr color_type read(unsigned char code) const;
+
+  // Stores the lowest 4 bits of @color.
+  constexpr unsigned char write(const color_type& color) const;
+};
+
+constexpr PixelFormatGrayscale4::color_type PixelFormatGrayscale4::read(unsigned char code) const {
+  return static_cast<color_type>(code & 15);
+}
+
+constexpr unsigned char PixelFormatGrayscale4::write(const color_type& color) const {
+  return static_cast<unsigned char>(color & 15);
+}
+
+}  // namespace imageview
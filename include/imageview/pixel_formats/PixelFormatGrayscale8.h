@@ -11,6 +11,7 @@ class PixelFormatGrayscale8 {
  public:
   using color_type = unsigned char;
   static constexpr int kBytesPerPixel = 1;
+  static constexpr bool kIsTriviallyEncoded = true;
 
   constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
 
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <imageview/internal/ByteOrder.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace imageview {
+
+// Implementation of the PixelFormat concept for the 32-bit floating-point
+// grayscale pixel format. The intensity is stored as an IEEE 754 binary32 number;
+// the nominal range of intensities is [0; 1].
+// \param ByteOrder - order of bytes of the intensity in the bitmap.
+template <std::endian ByteOrder>
+class BasicPixelFormatGrayscaleF32 {
+ public:
+  using color_type = float;
+  static constexpr int kBytesPerPixel = 4;
+  // The bitmap stores the object representation of color_type only if ByteOrder is the native byte order.
+  static constexpr bool kIsTriviallyEncoded = (ByteOrder == std::endian::native);
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const;
+};
+
+// 32-bit floating-point grayscale pixel format with little-endian intensities.
+using PixelFormatGrayscaleF32 = BasicPixelFormatGrayscaleF32<std::endian::little>;
+// 32-bit floating-point grayscale pixel format with big-endian intensities.
+using PixelFormatGrayscaleF32BE = BasicPixelFormatGrayscaleF32<std::endian::big>;
+
+template <std::endian ByteOrder>
+constexpr auto BasicPixelFormatGrayscaleF32<ByteOrder>::read(std::span<const std::byte, kBytesPerPixel> data) const
+    -> color_type {
+  return std::bit_cast<float>(detail::loadUint32<ByteOrder>(data));
+}
+
+template <std::endian ByteOrder>
+constexpr void BasicPixelFormatGrayscaleF32<ByteOrder>::write(const color_type& color,
+                                                              std::span<std::byte, kBytesPerPixel> data) const {
+  detail::storeUint32<ByteOrder>(std::bit_cast<std::uint32_t>(color), data);
+}
+
+}  // namespace imageview
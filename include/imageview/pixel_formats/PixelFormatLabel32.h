@@ -0,0 +1,34 @@
+#pragma once
+
+#include <imageview/internal/ByteOrder.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace imageview {
+
+// Implementation of the PixelFormat concept for 32-bit unsigned integer pixels, e.g. labels of connected
+// components. Values are stored in the native byte order.
+class PixelFormatLabel32 {
+ public:
+  using color_type = std::uint32_t;
+  static constexpr int kBytesPerPixel = 4;
+  static constexpr bool kIsTriviallyEncoded = true;
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const;
+};
+
+constexpr PixelFormatLabel32::color_type PixelFormatLabel32::read(
+    std::span<const std::byte, kBytesPerPixel> data) const {
+  return detail::loadUint32<std::endian::native>(data);
+}
+
+constexpr void PixelFormatLabel32::write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const {
+  detail::storeUint32<std::endian::native>(color, data);
+}
+
+}  // namespace imageview
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace imageview {
+
+// Implementation of the bit-packed PixelFormat concept for binary masks.
+// Each pixel occupies a single bit: 1 for pixels that belong to the mask, 0 otherwise.
+class PixelFormatMask1 {
+ public:
+  using color_type = bool;
+  static constexpr int kBitsPerPixel = 1;
+
+  constexpr color_type read(unsigned char code) const;
+
+  constexpr unsigned char write(const color_type& color) const;
+};
+
+constexpr PixelFormatMask1::color_type PixelFormatMask1::read(unsigned char code) const {
+  return code != 0;
+}
+
+constexpr unsigned char PixelFormatMask1::write(const color_type& color) const {
+  return color ? 1 : 0;
+}
+
+}  // namespace imageview
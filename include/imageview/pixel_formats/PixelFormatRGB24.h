@@ -27,6 +27,7 @@ class PixelFormatRGB24 {
  public:
   using color_type = RGB24;
   static constexpr int kBytesPerPixel = 3;
+  static constexpr bool kIsTriviallyEncoded = true;
 
   constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <imageview/internal/ByteOrder.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace imageview {
+
+// Class representing a color in RGB48 color space.
+class RGB48 {
+ public:
+  constexpr RGB48() noexcept = default;
+  // Construct an RGB48 color from the given channel components.
+  constexpr RGB48(std::uint16_t red, std::uint16_t green, std::uint16_t blue) noexcept
+      : red(red), green(green), blue(blue) {}
+
+  std::uint16_t red = 0;
+  std::uint16_t green = 0;
+  std::uint16_t blue = 0;
+};
+
+// Implementation of the PixelFormat concept for RGB48 pixel format.
+// In this pixel format the color is represented via 3 16-bit integers,
+// specifying the red, green and blue channels (in this order).
+// \param ByteOrder - order of bytes within each channel in the bitmap.
+template <std::endian ByteOrder>
+class BasicPixelFormatRGB48 {
+ public:
+  using color_type = RGB48;
+  static constexpr int kBytesPerPixel = 6;
+  // The bitmap stores the object representation of color_type only if ByteOrder is the native byte order.
+  static constexpr bool kIsTriviallyEncoded = (ByteOrder == std::endian::native);
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const;
+};
+
+// RGB48 pixel format with little-endian channels.
+using PixelFormatRGB48 = BasicPixelFormatRGB48<std::endian::little>;
+// RGB48 pixel format with big-endian channels (e.g., as in PNG).
+using PixelFormatRGB48BE = BasicPixelFormatRGB48<std::endian::big>;
+
+constexpr bool operator==(const RGB48& lhs, const RGB48& rhs) {
+  return lhs.red == rhs.red && lhs.green == rhs.green && lhs.blue == rhs.blue;
+}
+
+constexpr bool operator!=(const RGB48& lhs, const RGB48& rhs) { return !(lhs == rhs); }
+
+template <std::endian ByteOrder>
+constexpr auto BasicPixelFormatRGB48<ByteOrder>::read(std::span<const std::byte, kBytesPerPixel> data) const
+    -> color_type {
+  return color_type(detail::loadUint16<ByteOrder>(data.template subspan<0, 2>()),
+                    detail::loadUint16<ByteOrder>(data.template subspan<2, 2>()),
+                    detail::loadUint16<ByteOrder>(data.template subspan<4, 2>()));
+}
+
+template <std::endian ByteOrder>
+constexpr void BasicPixelFormatRGB48<ByteOrder>::write(const color_type& color,
+                                                       std::span<std::byte, kBytesPerPixel> data) const {
+  detail::storeUint16<ByteOrder>(color.red, data.template subspan<0, 2>());
+  detail::storeUint16<ByteOrder>(color.green, data.template subspan<2, 2>());
+  detail::storeUint16<ByteOrder>(color.blue, data.template subspan<4, 2>());
+}
+
+}  // namespace imageview
@@ -28,6 +28,7 @@ class PixelFormatRGBA32 {
  public:
   using color_type = RGBA32;
   static constexpr int kBytesPerPixel = 4;
+  static constexpr bool kIsTriviallyEncoded = true;
 
   constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <imageview/internal/ByteOrder.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace imageview {
+
+// Class representing a color with floating-point red, green and blue channels.
+// The nominal range of each channel is [0; 1].
+class RGBF32 {
+ public:
+  constexpr RGBF32() noexcept = default;
+  // Construct an RGBF32 color from the given channel components.
+  constexpr RGBF32(float red, float green, float blue) noexcept : red(red), green(green), blue(blue) {}
+
+  float red = 0.0f;
+  float green = 0.0f;
+  float blue = 0.0f;
+};
+
+// Implementation of the PixelFormat concept for RGBF32 pixel format.
+// In this pixel format the color is represented via 3 IEEE 754 binary32 numbers,
+// specifying the red, green and blue channels (in this order).
+// \param ByteOrder - order of bytes within each channel in the bitmap.
+template <std::endian ByteOrder>
+class BasicPixelFormatRGBF32 {
+ public:
+  using color_type = RGBF32;
+  static constexpr int kBytesPerPixel = 12;
+  // The bitmap stores the object representation of color_type only if ByteOrder is the native byte order.
+  static constexpr bool kIsTriviallyEncoded = (ByteOrder == std::endian::native);
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const;
+};
+
+// RGBF32 pixel format with little-endian channels.
+using PixelFormatRGBF32 = BasicPixelFormatRGBF32<std::endian::little>;
+// RGBF32 pixel format with big-endian channels.
+using PixelFormatRGBF32BE = BasicPixelFormatRGBF32<std::endian::big>;
+
+constexpr bool operator==(const RGBF32& lhs, const RGBF32& rhs) {
+  return lhs.red == rhs.red && lhs.green == rhs.green && lhs.blue == rhs.blue;
+}
+
+constexpr bool operator!=(const RGBF32& lhs, const RGBF32& rhs) { return !(lhs == rhs); }
+
+template <std::endian ByteOrder>
+constexpr auto BasicPixelFormatRGBF32<ByteOrder>::read(std::span<const std::byte, kBytesPerPixel> data) const
+    -> color_type {
+  return color_type(std::bit_cast<float>(detail::loadUint32<ByteOrder>(data.template subspan<0, 4>())),
+                    std::bit_cast<float>(detail::loadUint32<ByteOrder>(data.template subspan<4, 4>())),
+                    std::bit_cast<float>(detail::loadUint32<ByteOrder>(data.template subspan<8, 4>())));
+}
+
+template <std::endian ByteOrder>
+constexpr void BasicPixelFormatRGBF32<ByteOrder>::write(const color_type& color,
+                                                        std::span<std::byte, kBytesPerPixel> data) const {
+  detail::storeUint32<ByteOrder>(std::bit_cast<std::uint32_t>(color.red), data.template subspan<0, 4>());
+  detail::storeUint32<ByteOrder>(std::bit_cast<std::uint32_t>(color.green), data.template subspan<4, 4>());
+  detail::storeUint32<ByteOrder>(std::bit_cast<std::uint32_t>(color.blue), data.template subspan<8, 4>());
+}
+
+}  // namespace imageview
@@ -0,0 +1,75 @@
+#include <imageview/AlignedImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace imageview {
+namespace {
+
+static_assert(getAlignedStride<PixelFormatGrayscale8, 64>(1) == 64);
+static_assert(getAlignedStride<PixelFormatGrayscale8, 64>(64) == 64);
+static_assert(getAlignedStride<PixelFormatGrayscale8, 64>(65) == 128);
+static_assert(getAlignedStride<PixelFormatRGB24, 16>(10) == 16);
+static_assert(getAlignedStride<PixelFormatRGB24, 4>(5) == 8);
+
+static_assert(std::is_convertible_v<AlignedImageView<PixelFormatGrayscale8, true, 64>,
+                                    AlignedImageView<PixelFormatGrayscale8, false, 16>>);
+static_assert(!std::is_convertible_v<AlignedImageView<PixelFormatGrayscale8, false, 16>,
+                                     AlignedImageView<PixelFormatGrayscale8, false, 64>>);
+static_assert(!std::is_convertible_v<AlignedImageView<PixelFormatGrayscale8, false, 16>,
+                                     AlignedImageView<PixelFormatGrayscale8, true, 16>>);
+static_assert(std::is_convertible_v<AlignedImageView<PixelFormatGrayscale8, true, 16>,
+                                    ImageView<PixelFormatGrayscale8>>);
+
+constexpr unsigned int kHeight = 4;
+constexpr unsigned int kWidth = 20;
+constexpr unsigned int kStride = getAlignedStride<PixelFormatRGB24, 32>(kWidth);
+
+TEST(AlignedImageView, ValidatesAlignment) {
+  alignas(32) std::array<std::byte, ((kHeight - 1) * kStride + kWidth) * 3 + 32> data{};
+  const std::span<std::byte> aligned_data = std::span(data).first(((kHeight - 1) * kStride + kWidth) * 3);
+  const AlignedImageView<PixelFormatRGB24, true, 32> image(kHeight, kWidth, kStride, aligned_data);
+  EXPECT_EQ(image.height(), kHeight);
+  EXPECT_EQ(image.width(), kWidth);
+  EXPECT_EQ(image.stride(), kStride);
+  for (unsigned int y = 0; y < kHeight; ++y) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(image.alignedRow(y)) % 32, 0);
+    EXPECT_EQ(image.alignedRow(y), image.row(y).data().data());
+  }
+  image(1, 2) = RGB24(1, 2, 3);
+  const ImageView<PixelFormatRGB24> view = image;
+  EXPECT_EQ(view(1, 2), RGB24(1, 2, 3));
+
+  // Misaligned data.
+  EXPECT_THROW((AlignedImageView<PixelFormatRGB24, true, 32>(kHeight, kWidth, kStride, std::span(data).subspan(
+                                                                 3, aligned_data.size()))),
+               std::invalid_argument);
+  // Row pitch is not a multiple of the alignment.
+  EXPECT_THROW((AlignedImageView<PixelFormatRGB24, true, 32>(kHeight, kWidth, kWidth,
+                                                              std::span(data).first(kHeight * kWidth * 3))),
+               std::invalid_argument);
+  // A single row only needs an aligned start.
+  EXPECT_NO_THROW((AlignedImageView<PixelFormatRGB24, true, 32>(1, kWidth, kWidth, std::span(data).first(kWidth * 3))));
+}
+
+TEST(AlignedImageView, Crop) {
+  alignas(16) std::array<std::byte, 4 * 32> data{};
+  const AlignedImageView<PixelFormatGrayscale8, false, 16> image(4, 32, 32, data);
+  const AlignedImageView<PixelFormatGrayscale8, false, 16> cropped = cropAligned(image, 1, 16, 2, 10);
+  EXPECT_EQ(cropped.height(), 2);
+  EXPECT_EQ(cropped.width(), 10);
+  EXPECT_EQ(cropped.data().data(), data.data() + 32 + 16);
+  EXPECT_THROW(cropAligned(image, 1, 8, 2, 10), std::invalid_argument);
+  // crop() drops the guarantee.
+  const auto unaligned = crop(image, 1, 8, 2, 10);
+  static_assert(std::is_same_v<decltype(unaligned), const ImageView<PixelFormatGrayscale8>>);
+  EXPECT_EQ(unaligned.data().data(), data.data() + 32 + 8);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,130 @@
+#include <imageview/BitImageViewUtils.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale2.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale4.h>
+#include <imageview/pixel_formats/PixelFormatMask1.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Fills the mask with a pattern where the pixel (y, x) is set iff (x * y + x + 3 * y + seed) % 5 < 2.
+void fillPattern(BitImageView<PixelFormatMask1, true> image, unsigned int seed) {
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    for (unsigned int x = 0; x < image.width(); ++x) {
+      image(y, x) = (x * y + x + 3 * y + seed) % 5 < 2;
+    }
+  }
+}
+
+TEST(cropBitImageView, CropUnaligned) {
+  std::array<std::byte, 8> data{};
+  const BitImageView<PixelFormatMask1, true> image(4, 16, 16, 0, data);
+  const BitImageView<PixelFormatMask1, true> result = crop(image, 1, 3, 2, 9);
+  EXPECT_EQ(result.height(), 2);
+  EXPECT_EQ(result.width(), 9);
+  EXPECT_EQ(result.stride(), 16);
+  EXPECT_EQ(result.bitOffset(), 3);
+  EXPECT_EQ(result.data().data(), data.data() + 2);
+  result(1, 8) = true;
+  EXPECT_TRUE(image(2, 11));
+}
+
+TEST(BitwiseOperations, MatchPerPixelResult) {
+  // Wide enough to exercise the 64-bit path; crop at different offsets to exercise the unaligned path.
+  constexpr unsigned int kHeight = 5;
+  constexpr unsigned int kWidth = 150;
+  constexpr unsigned int kStride = 160;
+  // The last row is not padded: ((kHeight - 1) * kStride + kWidth) bits round up to 99 bytes.
+  constexpr std::size_t kDataSize = ((kHeight - 1) * kStride + kWidth + 7) / 8;
+  std::vector<std::byte> data_a(kDataSize);
+  std::vector<std::byte> data_b(kDataSize);
+  std::vector<std::byte> data_c(kDataSize);
+  const BitImageView<PixelFormatMask1, true> a(kHeight, kWidth, kStride, 0, data_a);
+  const BitImageView<PixelFormatMask1, true> b(kHeight, kWidth, kStride, 0, data_b);
+  const BitImageView<PixelFormatMask1, true> c(kHeight, kWidth, kStride, 0, data_c);
+  fillPattern(a, 0);
+  fillPattern(b, 1);
+  for (unsigned int shift : {0u, 3u}) {
+    const auto lhs = crop(a, 0, 0, kHeight, kWidth - 3);
+    const auto rhs = crop(b, 0, shift, kHeight, kWidth - 3);
+    const auto dst = crop(c, 0, shift == 0 ? 0 : 1, kHeight, kWidth - 3);
+    for (int op = 0; op < 4; ++op) {
+      fillPattern(c, 2);
+      const bool c_last = c(0, kWidth - 1);
+      switch (op) {
+        case 0: bitwiseAnd(lhs, rhs, dst); break;
+        case 1: bitwiseOr(lhs, rhs, dst); break;
+        case 2: bitwiseXor(lhs, rhs, dst); break;
+        case 3: bitwiseNot(lhs, dst); break;
+      }
+      for (unsigned int y = 0; y < kHeight; ++y) {
+        for (unsigned int x = 0; x < kWidth - 3; ++x) {
+          const bool l = lhs(y, x);
+          const bool r = rhs(y, x);
+          const bool expected = op == 0 ? (l && r) : op == 1 ? (l || r) : op == 2 ? (l != r) : !l;
+          ASSERT_EQ(static_cast<bool>(dst(y, x)), expected) << "op=" << op << " y=" << y << " x=" << x;
+        }
+      }
+      // Pixels outside of the destination view must not be modified.
+      EXPECT_EQ(static_cast<bool>(c(0, kWidth - 1)), c_last);
+    }
+  }
+}
+
+TEST(countNonZero, Mask1) {
+  std::vector<std::byte> data(6 * 100 / 8);
+  const BitImageView<PixelFormatMask1, true> image(6, 100, 100, 0, data);
+  fillPattern(image, 0);
+  const auto cropped = crop(image, 1, 5, 4, 90);
+  std::size_t expected = 0;
+  for (unsigned int y = 0; y < cropped.height(); ++y) {
+    for (unsigned int x = 0; x < cropped.width(); ++x) {
+      expected += cropped(y, x) ? 1 : 0;
+    }
+  }
+  EXPECT_EQ(countNonZero(cropped), expected);
+}
+
+TEST(countNonZero, Grayscale2) {
+  static constexpr std::array<std::byte, 3> kData{std::byte{0b00011011}, std::byte{0b10000000}, std::byte{0b00000010}};
+  constexpr BitImageView<PixelFormatGrayscale2> image(1, 11, 11, 2, kData);
+  EXPECT_EQ(countNonZero(image), 5);
+}
+
+TEST(convertBitImageView, RoundTripGrayscale4) {
+  std::array<std::byte, 8> data{};
+  const BitImageView<PixelFormatGrayscale4, true> image(2, 7, 8, 4, std::span{data}.first(8));
+  for (unsigned int y = 0; y < 2; ++y) {
+    for (unsigned int x = 0; x < 7; ++x) {
+      image(y, x) = static_cast<unsigned char>(y * 7 + x);
+    }
+  }
+  std::array<std::byte, 2 * 7> gray{};
+  const ContinuousImageView<PixelFormatGrayscale8, true> gray_image(2, 7, gray);
+  convert(image, gray_image);
+  EXPECT_EQ(gray_image(0, 1), 17);
+  EXPECT_EQ(gray_image(1, 6), 13 * 17);
+
+  std::array<std::byte, 8> data_out{};
+  const BitImageView<PixelFormatGrayscale4, true> image_out(2, 7, 8, 4, data_out);
+  convert(gray_image, image_out);
+  EXPECT_EQ(data_out, data);
+}
+
+TEST(convertBitImageView, Grayscale8ToMask1) {
+  std::array<std::byte, 10> gray{std::byte{0},   std::byte{127}, std::byte{128}, std::byte{255}, std::byte{1},
+                                 std::byte{200}, std::byte{130}, std::byte{0},   std::byte{255}, std::byte{90}};
+  const ContinuousImageView<PixelFormatGrayscale8> gray_image(1, 10, gray);
+  std::array<std::byte, 2> data{};
+  const BitImageView<PixelFormatMask1, true> mask(1, 10, 10, 0, data);
+  convert(gray_image, mask);
+  EXPECT_EQ(data[0], std::byte{0b00110110});
+  EXPECT_EQ(data[1], std::byte{0b10000000});
+}
+
+}  // namespace
+}  // namespace imageview
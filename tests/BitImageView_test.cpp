@@ -0,0 +1,65 @@
+#include <imageview/BitImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale4.h>
+#include <imageview/pixel_formats/PixelFormatMask1.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <stdexcept>
+
+namespace imageview {
+namespace {
+
+TEST(BitImageView, DefaultConstructor) {
+  constexpr BitImageView<PixelFormatMask1> image;
+  static_assert(image.height() == 0, "Default-constructed BitImageView should have zero height.");
+  static_assert(image.width() == 0, "Default-constructed BitImageView should have zero width.");
+  static_assert(image.data().empty(), "Default-constructed BitImageView should have empty data.");
+}
+
+TEST(BitImageView, RawParamsConstructor) {
+  // 3 rows of 5 pixels, stride 6, starting at bit 2: 2 + (2 * 6 + 5) = 19 bits -> 3 bytes.
+  static constexpr std::array<std::byte, 3> kData{};
+  constexpr BitImageView<PixelFormatMask1> image(3, 5, 6, 2, kData);
+  static_assert(image.height() == 3, "Height should be 3.");
+  static_assert(image.width() == 5, "Width should be 5.");
+  static_assert(image.stride() == 6, "Stride should be 6.");
+  static_assert(image.bitOffset() == 2, "Bit offset should be 2.");
+  static_assert(image.data().size() == 3, "data() should return a span of 3 bytes.");
+  static_assert(image.rowBitOffset(2) == 14, "Row 2 should start at bit 14.");
+}
+
+TEST(BitImageView, InvalidArguments) {
+  std::array<std::byte, 3> data{};
+  EXPECT_THROW((BitImageView<PixelFormatMask1>(3, 5, 6, 2, std::span{data}.first(2))), std::invalid_argument);
+  EXPECT_THROW((BitImageView<PixelFormatMask1>(3, 5, 4, 2, data)), std::invalid_argument);
+  EXPECT_THROW((BitImageView<PixelFormatMask1>(3, 5, 6, 8, data)), std::invalid_argument);
+  EXPECT_THROW((BitImageView<PixelFormatGrayscale4>(1, 4, 4, 2, data)), std::invalid_argument);
+}
+
+TEST(BitImageView, ReadElement) {
+  // Pixels are packed starting from the most significant bit.
+  static constexpr std::array<std::byte, 2> kData{std::byte{0b10110000}, std::byte{0b00000001}};
+  constexpr BitImageView<PixelFormatMask1> image(2, 4, 8, 0, kData);
+  static_assert(image(0, 0) == true, "Must be true.");
+  static_assert(image(0, 1) == false, "Must be false.");
+  static_assert(image(0, 2) == true, "Must be true.");
+  static_assert(image(0, 3) == true, "Must be true.");
+  static_assert(image(1, 0) == false, "Must be false.");
+  static_assert(image(1, 3) == false, "Must be false.");
+}
+
+TEST(BitImageView, WriteElement) {
+  std::array<std::byte, 2> data{std::byte{0xFF}, std::byte{0x00}};
+  const BitImageView<PixelFormatGrayscale4, true> image(1, 3, 3, 4, data);
+  EXPECT_EQ(image(0, 0), 15);
+  image(0, 0) = 3;
+  image(0, 2) = 9;
+  EXPECT_EQ(data[0], std::byte{0xF3});
+  EXPECT_EQ(data[1], std::byte{0x09});
+  EXPECT_EQ(image(0, 1), 0);
+  EXPECT_THROW(image(0, 3), std::out_of_range);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,170 @@
+#include <imageview/BmpCodec.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+std::vector<std::byte> makeBitmap(std::size_t size) {
+  std::vector<std::byte> data(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<std::byte>((i * 37 + 11) % 256);
+  }
+  return data;
+}
+
+template <class PixelFormat>
+std::vector<std::byte> writeToMemory(ImageView<PixelFormat> image) {
+  std::ostringstream stream;
+  writeBmp(image, stream);
+  const std::string data = stream.str();
+  const auto bytes = std::as_bytes(std::span(data.data(), data.size()));
+  return std::vector<std::byte>(bytes.begin(), bytes.end());
+}
+
+TEST(BmpCodec, RoundTripRGB24WithPadding) {
+  for (unsigned int width = 1; width <= 8; ++width) {
+    SCOPED_TRACE(width);
+    constexpr unsigned int kHeight = 3;
+    const std::vector<std::byte> data = makeBitmap(kHeight * width * 3);
+    const ImageView<PixelFormatRGB24> image(kHeight, width, width, data);
+    const std::vector<std::byte> file = writeToMemory(image);
+    const std::size_t row_pitch = (width * 3 + 3) / 4 * 4;
+    ASSERT_EQ(file.size(), 54 + row_pitch * kHeight);
+
+    const BmpImage bmp(file);
+    EXPECT_EQ(bmp.height(), kHeight);
+    EXPECT_EQ(bmp.width(), width);
+    EXPECT_EQ(bmp.info().bits_per_pixel, 24u);
+    EXPECT_TRUE(bmp.info().bottom_up);
+    EXPECT_EQ(bmp.info().row_pitch, row_pitch);
+    for (unsigned int y = 0; y < kHeight; ++y) {
+      const ImageRowView<PixelFormatBGR24> row = bmp.row<PixelFormatBGR24>(y);
+      // The rows point into the file: the top row is stored last.
+      EXPECT_EQ(row.data().data(), file.data() + 54 + (kHeight - 1 - y) * row_pitch);
+      for (unsigned int x = 0; x < width; ++x) {
+        EXPECT_EQ(row[x], image(y, x));
+      }
+    }
+    // Padding bytes are zeros.
+    for (std::size_t offset = width * 3; offset < row_pitch; ++offset) {
+      EXPECT_EQ(file[54 + offset], std::byte{0});
+    }
+  }
+}
+
+TEST(BmpCodec, StorageOrderView) {
+  const std::vector<std::byte> data = makeBitmap(2 * 4 * 3);
+  const std::vector<std::byte> file = writeToMemory(ImageView<PixelFormatRGB24>(2, 4, 4, data));
+  const BmpImage bmp(file);
+  const std::optional<ImageView<PixelFormatBGR24>> view = bmp.storageOrderView<PixelFormatBGR24>();
+  ASSERT_TRUE(view.has_value());
+  EXPECT_EQ(view->data().data(), file.data() + 54);
+  EXPECT_EQ((*view)(0, 1), bmp.row<PixelFormatBGR24>(1)[1]);
+  EXPECT_EQ((*view)(1, 3), bmp.row<PixelFormatBGR24>(0)[3]);
+
+  // 5 * 3 bytes are padded to 16, which is not a multiple of 3.
+  const std::vector<std::byte> data5 = makeBitmap(2 * 5 * 3);
+  const std::vector<std::byte> file5 = writeToMemory(ImageView<PixelFormatRGB24>(2, 5, 5, data5));
+  EXPECT_FALSE(BmpImage(file5).storageOrderView<PixelFormatBGR24>().has_value());
+  EXPECT_THROW(BmpImage(file5).storageOrderView<PixelFormatBGRA32>(), std::invalid_argument);
+}
+
+TEST(BmpCodec, RoundTripRGBA32AndGrayscale8) {
+  const std::vector<std::byte> rgba_data = makeBitmap(3 * 5 * 4);
+  const ImageView<PixelFormatRGBA32> rgba(3, 5, 5, rgba_data);
+  const std::vector<std::byte> rgba_file = writeToMemory(rgba);
+  const BmpImage rgba_bmp(rgba_file);
+  EXPECT_EQ(rgba_bmp.info().bits_per_pixel, 32u);
+  // The alpha channel is declared via BITMAPV4HEADER.
+  EXPECT_EQ(rgba_bmp.info().pixel_data_offset, 14u + 108u);
+  EXPECT_TRUE(rgba_bmp.info().has_alpha);
+  for (unsigned int y = 0; y < rgba.height(); ++y) {
+    for (unsigned int x = 0; x < rgba.width(); ++x) {
+      EXPECT_EQ(rgba_bmp.row<PixelFormatBGRA32>(y)[x], rgba(y, x));
+    }
+  }
+  EXPECT_THROW(rgba_bmp.row<PixelFormatBGR24>(0), std::invalid_argument);
+  EXPECT_THROW(rgba_bmp.row<PixelFormatBGRA32>(3), std::out_of_range);
+
+  const std::vector<std::byte> gray_data = makeBitmap(2 * 3);
+  const ImageView<PixelFormatGrayscale8> gray(2, 3, 3, gray_data);
+  const std::vector<std::byte> gray_file = writeToMemory(gray);
+  const BmpImage gray_bmp(gray_file);
+  EXPECT_FALSE(gray_bmp.info().has_alpha);
+  for (unsigned int y = 0; y < gray.height(); ++y) {
+    for (unsigned int x = 0; x < gray.width(); ++x) {
+      const unsigned char value = gray(y, x);
+      EXPECT_EQ(gray_bmp.row<PixelFormatBGR24>(y)[x], RGB24(value, value, value));
+    }
+  }
+}
+
+TEST(BmpCodec, TopDownImage) {
+  const std::vector<std::byte> data = makeBitmap(3 * 4 * 3);
+  const ImageView<PixelFormatRGB24> image(3, 4, 4, data);
+  std::vector<std::byte> file = writeToMemory(image);
+  // Make the height negative and reverse the rows.
+  detail::storeBmpUint32(static_cast<std::uint32_t>(-3), file.data() + 22);
+  std::vector<std::byte> top_down(file.begin(), file.begin() + 54);
+  for (unsigned int row = 3; row-- > 0;) {
+    top_down.insert(top_down.end(), file.begin() + 54 + row * 12, file.begin() + 54 + (row + 1) * 12);
+  }
+  const BmpImage bmp(top_down);
+  EXPECT_FALSE(bmp.info().bottom_up);
+  EXPECT_EQ(bmp.height(), 3u);
+  const std::optional<ImageView<PixelFormatBGR24>> view = bmp.storageOrderView<PixelFormatBGR24>();
+  ASSERT_TRUE(view.has_value());
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    for (unsigned int x = 0; x < image.width(); ++x) {
+      EXPECT_EQ((*view)(y, x), image(y, x));
+      EXPECT_EQ(bmp.row<PixelFormatBGR24>(y)[x], image(y, x));
+    }
+  }
+}
+
+TEST(BmpCodec, MapsFile) {
+  const std::vector<std::byte> data = makeBitmap(7 * 6 * 3);
+  const ImageView<PixelFormatRGB24> image(7, 6, 6, data);
+  const std::filesystem::path path = std::filesystem::temp_directory_path() / "imageview_BmpCodec_test.bmp";
+  {
+    std::ofstream stream(path, std::ios::binary);
+    writeBmp(image, stream);
+  }
+  {
+    const BmpImage bmp(path);
+    ASSERT_EQ(bmp.height(), 7u);
+    EXPECT_EQ(bmp.row<PixelFormatBGR24>(6)[5], image(6, 5));
+  }
+  std::filesystem::remove(path);
+  EXPECT_THROW(BmpImage bmp(path), std::runtime_error);
+}
+
+TEST(BmpCodec, InvalidInput) {
+  const std::vector<std::byte> data = makeBitmap(2 * 2 * 3);
+  const std::vector<std::byte> file = writeToMemory(ImageView<PixelFormatRGB24>(2, 2, 2, data));
+  EXPECT_THROW(BmpImage(std::span(file).first(60)), std::runtime_error);
+  std::vector<std::byte> corrupted = file;
+  corrupted[0] = std::byte{'X'};
+  EXPECT_THROW(parseBmpHeader(corrupted), std::runtime_error);
+  corrupted = file;
+  detail::storeBmpUint16(8, corrupted.data() + 28);
+  EXPECT_THROW(parseBmpHeader(corrupted), std::runtime_error);
+  corrupted = file;
+  detail::storeBmpUint32(1, corrupted.data() + 30);
+  EXPECT_THROW(parseBmpHeader(corrupted), std::runtime_error);
+
+  std::ostringstream stream;
+  EXPECT_THROW(writeBmp(ImageView<PixelFormatRGB24>(), stream), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,75 @@
+#include <imageview/ColorDepthConversions.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <limits>
+
+namespace imageview {
+namespace {
+
+TEST(ColorDepthConversions, Grayscale8To16AndBack) {
+  std::array<std::byte, 256> data8{};
+  for (int i = 0; i < 256; ++i) {
+    data8[i] = static_cast<std::byte>(i);
+  }
+  const ImageView<PixelFormatGrayscale8> image8(16, 16, 16, data8);
+  std::array<std::byte, 512> data16{};
+  const ImageView<PixelFormatGrayscale16BE, true> image16(16, 16, 16, data16);
+  convert(image8, image16);
+  EXPECT_EQ(image16(0, 0), 0);
+  EXPECT_EQ(image16(0, 1), 257);
+  EXPECT_EQ(image16(15, 15), 65535);
+
+  std::array<std::byte, 256> data8_out{};
+  convert(ImageView<PixelFormatGrayscale16BE>(image16), ImageView<PixelFormatGrayscale8, true>(16, 16, 16, data8_out));
+  EXPECT_EQ(data8_out, data8);
+}
+
+TEST(ColorDepthConversions, Narrow16Rounds) {
+  std::array<std::byte, 8> data16{};
+  const ImageView<PixelFormatGrayscale16, true> image16(1, 4, 4, data16);
+  image16(0, 0) = 128;    // 0.498 -> 0
+  image16(0, 1) = 129;    // 0.502 -> 1
+  image16(0, 2) = 65406;  // 254.498 -> 254
+  image16(0, 3) = 65407;  // 254.502 -> 255
+  std::array<std::byte, 4> data8{};
+  const ImageView<PixelFormatGrayscale8, true> image8(1, 4, 4, data8);
+  convert(image16, image8);
+  EXPECT_EQ(image8(0, 0), 0);
+  EXPECT_EQ(image8(0, 1), 1);
+  EXPECT_EQ(image8(0, 2), 254);
+  EXPECT_EQ(image8(0, 3), 255);
+}
+
+TEST(ColorDepthConversions, RGBF32SaturatesStrided) {
+  // 2x2 image with stride 3.
+  std::array<std::byte, (3 + 2) * PixelFormatRGBF32::kBytesPerPixel> data_f32{};
+  const ImageView<PixelFormatRGBF32, true> image_f32(2, 2, 3, data_f32);
+  image_f32(0, 0) = RGBF32(-0.5f, 0.5f, 2.0f);
+  image_f32(0, 1) = RGBF32(std::numeric_limits<float>::quiet_NaN(), 1.0f, 0.0f);
+  image_f32(1, 0) = RGBF32(0.1f, 0.2f, 0.3f);
+  image_f32(1, 1) = RGBF32(1.0f / 255.0f, 254.5f / 255.0f, std::numeric_limits<float>::infinity());
+  std::array<std::byte, 4 * PixelFormatRGB24::kBytesPerPixel> data24{};
+  const ImageView<PixelFormatRGB24, true> image24(2, 2, 2, data24);
+  convert(image_f32, image24);
+  EXPECT_EQ(image24(0, 0), RGB24(0, 128, 255));
+  EXPECT_EQ(image24(0, 1), RGB24(0, 255, 0));
+  EXPECT_EQ(image24(1, 0), RGB24(26, 51, 77));
+  EXPECT_EQ(image24(1, 1), RGB24(1, 255, 255));
+
+  convert(ImageView<PixelFormatRGB24>(image24), image_f32);
+  EXPECT_EQ(image_f32(0, 1), RGBF32(0.0f, 1.0f, 0.0f));
+  EXPECT_EQ(image_f32(1, 0), RGBF32(26 / 255.0f, 51 / 255.0f, 77 / 255.0f));
+}
+
+TEST(ColorDepthConversions, DimensionMismatch) {
+  std::array<std::byte, 4> data8{};
+  std::array<std::byte, 6> data16{};
+  EXPECT_THROW(convert(ImageView<PixelFormatGrayscale8>(2, 2, 2, data8),
+                       ImageView<PixelFormatGrayscale16, true>(1, 3, 3, data16)),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,142 @@
+#include <imageview/ConnectedComponents.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <array>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Straightforward flood-fill labeling; components are numbered in raster order of their first pixels.
+std::vector<std::uint32_t> labelNaive(ImageView<PixelFormatGrayscale8> mask, Connectivity connectivity) {
+  const int height = mask.height();
+  const int width = mask.width();
+  std::vector<std::uint32_t> labels(mask.area(), 0);
+  std::uint32_t num_labels = 0;
+  std::vector<std::pair<int, int>> stack;
+  for (int y0 = 0; y0 < height; ++y0) {
+    for (int x0 = 0; x0 < width; ++x0) {
+      if (mask(y0, x0) == 0 || labels[y0 * width + x0] != 0) {
+        continue;
+      }
+      ++num_labels;
+      labels[y0 * width + x0] = num_labels;
+      stack.emplace_back(y0, x0);
+      while (!stack.empty()) {
+        const auto [y, x] = stack.back();
+        stack.pop_back();
+        for (int dy = -1; dy <= 1; ++dy) {
+          for (int dx = -1; dx <= 1; ++dx) {
+            if ((dy != 0 && dx != 0 && connectivity == Connectivity::k4) || y + dy < 0 || y + dy >= height ||
+                x + dx < 0 || x + dx >= width) {
+              continue;
+            }
+            std::uint32_t& label = labels[(y + dy) * width + x + dx];
+            if (mask(y + dy, x + dx) != 0 && label == 0) {
+              label = num_labels;
+              stack.emplace_back(y + dy, x + dx);
+            }
+          }
+        }
+      }
+    }
+  }
+  return labels;
+}
+
+std::vector<std::uint32_t> toVector(ImageView<PixelFormatLabel32> labels) {
+  std::vector<std::uint32_t> result;
+  for (unsigned int y = 0; y < labels.height(); ++y) {
+    result.insert(result.end(), labels.row(y).begin(), labels.row(y).end());
+  }
+  return result;
+}
+
+TEST(ConnectedComponents, MatchesFloodFill) {
+  constexpr unsigned int kHeight = 41;
+  constexpr unsigned int kWidth = 37;
+  constexpr unsigned int kStride = 40;
+  std::vector<std::byte> mask_data((kHeight - 1) * kStride + kWidth);
+  test::Lcg generator(7);
+  for (std::byte& value : mask_data) {
+    value = (generator.next() % 100 < 45) ? std::byte{255} : std::byte{0};
+  }
+  const ImageView<PixelFormatGrayscale8> mask(kHeight, kWidth, kStride, mask_data);
+  std::vector<std::byte> labels_data(kHeight * kWidth * 4);
+  const ImageView<PixelFormatLabel32, true> labels(kHeight, kWidth, kWidth, labels_data);
+  for (Connectivity connectivity : {Connectivity::k4, Connectivity::k8}) {
+    const std::vector<std::uint32_t> expected = labelNaive(mask, connectivity);
+    const std::uint32_t expected_count = *std::max_element(expected.begin(), expected.end());
+    for (unsigned int num_threads : {1u, 3u, 8u, 100u}) {
+      EXPECT_EQ(labelComponents(mask, labels, connectivity, num_threads), expected_count);
+      EXPECT_EQ(toVector(labels), expected);
+    }
+  }
+}
+
+TEST(ConnectedComponents, Stats) {
+  // 0 1 1 0 0
+  // 0 1 0 0 1
+  // 0 0 1 1 1
+  constexpr std::array<std::byte, 15> kMask = {
+      std::byte{0}, std::byte{1}, std::byte{1}, std::byte{0}, std::byte{0},
+      std::byte{0}, std::byte{1}, std::byte{0}, std::byte{0}, std::byte{1},
+      std::byte{0}, std::byte{0}, std::byte{1}, std::byte{1}, std::byte{1}};
+  const ImageView<PixelFormatGrayscale8> mask(3, 5, 5, kMask);
+  std::array<std::byte, 15 * 4> labels_data = {};
+  const ImageView<PixelFormatLabel32, true> labels(3, 5, 5, labels_data);
+
+  const std::vector<ComponentStats> stats_4 = labelComponentsWithStats(mask, labels, Connectivity::k4);
+  ASSERT_EQ(stats_4.size(), 2);
+  EXPECT_EQ(stats_4[0].area, 3);
+  EXPECT_EQ(stats_4[0].first_row, 0);
+  EXPECT_EQ(stats_4[0].first_column, 1);
+  EXPECT_EQ(stats_4[0].num_rows, 2);
+  EXPECT_EQ(stats_4[0].num_columns, 2);
+  EXPECT_DOUBLE_EQ(stats_4[0].centroid_y, 1.0 / 3);
+  EXPECT_DOUBLE_EQ(stats_4[0].centroid_x, 4.0 / 3);
+  EXPECT_EQ(stats_4[1].area, 4);
+  EXPECT_EQ(stats_4[1].first_row, 1);
+  EXPECT_EQ(stats_4[1].first_column, 2);
+  EXPECT_DOUBLE_EQ(stats_4[1].centroid_x, 13.0 / 4);
+  EXPECT_EQ(labels(2, 3), 2);
+
+  const std::vector<ComponentStats> stats_8 = labelComponentsWithStats(mask, labels, Connectivity::k8, 2);
+  ASSERT_EQ(stats_8.size(), 1);
+  EXPECT_EQ(stats_8[0].area, 7);
+  EXPECT_EQ(stats_8[0].num_rows, 3);
+  EXPECT_EQ(stats_8[0].num_columns, 4);
+  EXPECT_EQ(labels(2, 3), 1);
+}
+
+TEST(ConnectedComponents, BitPackedMask) {
+  std::array<std::byte, 8> mask_data = {};
+  const BitImageView<PixelFormatMask1, true> mask(8, 8, 8, 0, mask_data);
+  mask(0, 0) = true;
+  mask(1, 1) = true;
+  mask(5, 6) = true;
+  mask(5, 7) = true;
+  std::array<std::byte, 64 * 4> labels_data = {};
+  const ImageView<PixelFormatLabel32, true> labels(8, 8, 8, labels_data);
+  EXPECT_EQ(labelComponents(mask, labels, Connectivity::k4), 3);
+  EXPECT_EQ(labelComponents(mask, labels, Connectivity::k8, 4), 2);
+  EXPECT_EQ(labels(1, 1), 1);
+  EXPECT_EQ(labels(5, 7), 2);
+  EXPECT_EQ(labels(5, 5), 0);
+}
+
+TEST(ConnectedComponents, WrongDimensions) {
+  std::array<std::byte, 6> mask_data = {};
+  std::array<std::byte, 6 * 4> labels_data = {};
+  EXPECT_THROW(labelComponents(ImageView<PixelFormatGrayscale8>(2, 3, 3, mask_data),
+                               ImageView<PixelFormatLabel32, true>(3, 2, 2, labels_data)),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
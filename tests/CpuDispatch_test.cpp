@@ -0,0 +1,88 @@
+#include <imageview/ColorDepthConversions.h>
+#include <imageview/CpuDispatch.h>
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageViewUtils.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+constexpr InstructionSet kAllInstructionSets[] = {InstructionSet::kBaseline, InstructionSet::kSse42,
+                                                  InstructionSet::kAvx2, InstructionSet::kAvx512};
+
+// Removes the override when the test ends.
+class CpuDispatch : public ::testing::Test {
+ protected:
+  void TearDown() override { setInstructionSetOverride(std::nullopt); }
+};
+
+TEST_F(CpuDispatch, OverrideIsClampedToDetected) {
+  const InstructionSet detected = detectInstructionSet();
+  EXPECT_EQ(getInstructionSet(), detected);
+  setInstructionSetOverride(InstructionSet::kBaseline);
+  EXPECT_EQ(getInstructionSet(), InstructionSet::kBaseline);
+  setInstructionSetOverride(InstructionSet::kAvx512);
+  EXPECT_EQ(getInstructionSet(), detected);
+  setInstructionSetOverride(std::nullopt);
+  EXPECT_EQ(getInstructionSet(), detected);
+}
+
+TEST_F(CpuDispatch, InstructionSetNames) {
+  EXPECT_STREQ(getInstructionSetName(InstructionSet::kBaseline), "baseline");
+  EXPECT_STREQ(getInstructionSetName(InstructionSet::kAvx2), "avx2");
+}
+
+TEST_F(CpuDispatch, AllInstructionSetsComputeTheSameMetrics) {
+  constexpr unsigned int kHeight = 37;
+  constexpr unsigned int kWidth = 101;
+  const std::vector<std::byte> lhs_data = test::makeBitmap(kHeight * kWidth * 3, 1);
+  const std::vector<std::byte> rhs_data = test::makeBitmap(kHeight * kWidth * 3, 2);
+  const ImageView<PixelFormatRGB24> lhs(kHeight, kWidth, kWidth, lhs_data);
+  const ImageView<PixelFormatRGB24> rhs(kHeight, kWidth, kWidth, rhs_data);
+  const ImageView<PixelFormatRGB24> lhs_cropped = crop(lhs, 1, 3, kHeight - 2, kWidth - 5);
+  const ImageView<PixelFormatRGB24> rhs_cropped = crop(rhs, 1, 3, kHeight - 2, kWidth - 5);
+
+  setInstructionSetOverride(InstructionSet::kBaseline);
+  const std::uint64_t expected_sad = sad(lhs, rhs);
+  const std::uint64_t expected_sad_cropped = sad(lhs_cropped, rhs_cropped);
+  const double expected_mse = mse(lhs, rhs);
+  for (const InstructionSet instruction_set : kAllInstructionSets) {
+    setInstructionSetOverride(instruction_set);
+    SCOPED_TRACE(getInstructionSetName(getInstructionSet()));
+    EXPECT_EQ(sad(lhs, rhs), expected_sad);
+    EXPECT_EQ(sad(lhs_cropped, rhs_cropped), expected_sad_cropped);
+    EXPECT_EQ(mse(lhs, rhs), expected_mse);
+  }
+}
+
+TEST_F(CpuDispatch, AllInstructionSetsComputeTheSameConversions) {
+  constexpr unsigned int kHeight = 9;
+  constexpr unsigned int kWidth = 77;
+  const std::vector<std::byte> src_data = test::makeBitmap(kHeight * kWidth * 3, 3);
+  const ImageView<PixelFormatRGB24> src(kHeight, kWidth, kWidth, src_data);
+
+  setInstructionSetOverride(InstructionSet::kBaseline);
+  std::vector<std::byte> expected_wide(kHeight * kWidth * PixelFormatRGBF32::kBytesPerPixel);
+  convert(src, ImageView<PixelFormatRGBF32, true>(kHeight, kWidth, kWidth, expected_wide));
+  for (const InstructionSet instruction_set : kAllInstructionSets) {
+    setInstructionSetOverride(instruction_set);
+    SCOPED_TRACE(getInstructionSetName(getInstructionSet()));
+    std::vector<std::byte> wide(expected_wide.size());
+    const ImageView<PixelFormatRGBF32, true> wide_view(kHeight, kWidth, kWidth, wide);
+    convert(src, wide_view);
+    EXPECT_EQ(wide, expected_wide);
+    std::vector<std::byte> narrow(src_data.size());
+    convert(ImageView<PixelFormatRGBF32>(wide_view), ImageView<PixelFormatRGB24, true>(kHeight, kWidth, kWidth, narrow));
+    EXPECT_EQ(narrow, src_data);
+  }
+}
+
+}  // namespace
+}  // namespace imageview
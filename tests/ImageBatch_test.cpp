@@ -0,0 +1,130 @@
+#include <imageview/ColorDepthConversions.h>
+#include <imageview/ImageBatch.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale16.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <array>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+TEST(ImageBatch, ConstructFromSingleBuffer) {
+  constexpr std::size_t kCount = 5;
+  constexpr unsigned int kHeight = 3;
+  constexpr unsigned int kWidth = 2;
+  constexpr unsigned int kStride = 4;
+  std::vector<std::byte> data = test::makeBitmap(kCount * kHeight * kStride, 1);
+  const ImageBatch<PixelFormatGrayscale8, true> batch(kCount, kHeight, kWidth, kStride, data);
+  ASSERT_EQ(batch.size(), kCount);
+  EXPECT_EQ(batch.area(), kCount * kHeight * kWidth);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    const ImageView<PixelFormatGrayscale8, true> image = batch[i];
+    EXPECT_EQ(image.height(), kHeight);
+    EXPECT_EQ(image.width(), kWidth);
+    EXPECT_EQ(image.stride(), kStride);
+    EXPECT_EQ(image(2, 1), static_cast<unsigned char>(data[i * kHeight * kStride + 2 * kStride + 1]));
+  }
+  EXPECT_THROW(batch.at(kCount), std::out_of_range);
+}
+
+TEST(ImageBatch, ConstructFromSingleBufferInvalid) {
+  std::vector<std::byte> data(10);
+  EXPECT_THROW((ImageBatch<PixelFormatGrayscale8>(2, 1, 5, 4, data)), std::invalid_argument);
+  EXPECT_THROW((ImageBatch<PixelFormatGrayscale8>(3, 1, 4, 4, data)), std::invalid_argument);
+}
+
+TEST(ImageBatch, Add) {
+  std::vector<std::byte> data_a(6);
+  std::vector<std::byte> data_b(12);
+  ImageBatch<PixelFormatGrayscale8, true> batch;
+  EXPECT_TRUE(batch.empty());
+  batch.add(ImageView<PixelFormatGrayscale8, true>(2, 3, 3, data_a));
+  batch.add(ImageView<PixelFormatGrayscale8, true>(3, 3, 4, std::span(data_b).first(11)));
+  ASSERT_EQ(batch.size(), 2);
+  EXPECT_EQ(batch.area(), 15);
+  EXPECT_EQ(batch.heights()[1], 3);
+  EXPECT_EQ(batch.strides()[1], 4);
+  EXPECT_EQ(batch.data()[0], data_a.data());
+  batch[1](2, 2) = 42;
+  EXPECT_EQ(data_b[10], std::byte{42});
+
+  const ImageBatch<PixelFormatGrayscale8> const_batch = batch;
+  EXPECT_EQ(const_batch.size(), 2);
+  EXPECT_EQ(const_batch[1](2, 2), 42);
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(batch.area(), 0);
+}
+
+TEST(ImageBatch, ForEachImageVisitsEveryImageOnce) {
+  // Images of very different sizes, including empty ones.
+  std::vector<std::byte> data(1000);
+  ImageBatch<PixelFormatGrayscale8> batch;
+  for (unsigned int width : {0u, 10u, 1u, 0u, 100u, 3u, 50u, 7u, 0u}) {
+    batch.add(ImageView<PixelFormatGrayscale8>(1, width, width, std::span(data).first(width)));
+  }
+  for (unsigned int num_threads : {1u, 2u, 3u, 16u}) {
+    std::vector<std::atomic<int>> visits(batch.size());
+    forEachImage(batch, num_threads, [&](std::size_t i, ImageView<PixelFormatGrayscale8> image) {
+      EXPECT_EQ(image.width(), batch.widths()[i]);
+      ++visits[i];
+    });
+    for (const std::atomic<int>& count : visits) {
+      EXPECT_EQ(count, 1) << "num_threads = " << num_threads;
+    }
+  }
+}
+
+TEST(ImageBatch, CopyAndFill) {
+  constexpr std::size_t kCount = 7;
+  const std::vector<std::byte> src_data = test::makeBitmap(kCount * 4 * 4, 2);
+  std::vector<std::byte> dst_data(kCount * 4 * 5);
+  const ImageBatch<PixelFormatGrayscale8> src(kCount, 4, 4, 4, src_data);
+  const ImageBatch<PixelFormatGrayscale8, true> dst(kCount, 4, 4, 5, dst_data);
+  copy(src, dst, 4);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    EXPECT_TRUE(equal(src[i], dst[i]));
+  }
+  EXPECT_EQ(sad(src, dst, 3), std::vector<std::uint64_t>(kCount, 0));
+  EXPECT_EQ(hash(src, 2), hash(dst));
+
+  fill(dst, 9, 2);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    EXPECT_EQ(dst[i](3, 3), 9);
+  }
+  const std::vector<double> errors = mse(src, dst);
+  ASSERT_EQ(errors.size(), kCount);
+  EXPECT_DOUBLE_EQ(errors[3], mse(src[3], dst[3]));
+}
+
+TEST(ImageBatch, Convert) {
+  constexpr std::size_t kCount = 4;
+  const std::vector<std::byte> src_data = test::makeBitmap(kCount * 3 * 3, 3);
+  std::vector<std::byte> dst_data(kCount * 3 * 3 * 2);
+  const ImageBatch<PixelFormatGrayscale8> src(kCount, 3, 3, 3, src_data);
+  const ImageBatch<PixelFormatGrayscale16, true> dst(kCount, 3, 3, 3, dst_data);
+  convert(src, dst, 2);
+  for (std::size_t i = 0; i < kCount; ++i) {
+    EXPECT_EQ(dst[i](1, 2), src[i](1, 2) * 257);
+  }
+}
+
+TEST(ImageBatch, DifferentDimensions) {
+  std::vector<std::byte> src_data(12);
+  std::vector<std::byte> dst_data(12);
+  const ImageBatch<PixelFormatGrayscale8> src(2, 2, 3, 3, src_data);
+  const ImageBatch<PixelFormatGrayscale8, true> dst(2, 3, 2, 2, dst_data);
+  EXPECT_THROW(copy(src, dst), std::invalid_argument);
+  EXPECT_THROW(sad(src, ImageBatch<PixelFormatGrayscale8>(dst)), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,182 @@
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageViewUtils.h>
+#include <imageview/pixel_formats/PixelFormatGrayscaleF32.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Straightforward implementation of SSIM over uniform windows of a grayscale image.
+double computeSsimNaive(ImageView<PixelFormatGrayscale8> lhs, ImageView<PixelFormatGrayscale8> rhs,
+                        unsigned int window) {
+  const double c1 = (0.01 * 255) * (0.01 * 255);
+  const double c2 = (0.03 * 255) * (0.03 * 255);
+  const double n = window * window;
+  double total = 0.0;
+  for (unsigned int y0 = 0; y0 + window <= lhs.height(); ++y0) {
+    for (unsigned int x0 = 0; x0 + window <= lhs.width(); ++x0) {
+      double l = 0, r = 0, ll = 0, rr = 0, lr = 0;
+      for (unsigned int y = y0; y < y0 + window; ++y) {
+        for (unsigned int x = x0; x < x0 + window; ++x) {
+          const double a = lhs(y, x);
+          const double b = rhs(y, x);
+          l += a;
+          r += b;
+          ll += a * a;
+          rr += b * b;
+          lr += a * b;
+        }
+      }
+      const double ml = l / n;
+      const double mr = r / n;
+      total += ((2 * ml * mr + c1) * (2 * (lr / n - ml * mr) + c2)) /
+               ((ml * ml + mr * mr + c1) * (ll / n - ml * ml + rr / n - mr * mr + c2));
+    }
+  }
+  return total / ((lhs.height() - window + 1) * (lhs.width() - window + 1));
+}
+
+TEST(equal, ContinuousAndStrided) {
+  const std::vector<std::byte> data = test::makeBitmap(6 * 8 * 3, 1);
+  std::vector<std::byte> copy(data);
+  const ImageView<PixelFormatRGB24> image(6, 8, 8, data);
+  const ImageView<PixelFormatRGB24> image_copy(6, 8, 8, copy);
+  EXPECT_TRUE(equal(image, image_copy));
+  // Strided views: the columns outside of the crop are ignored.
+  copy[7 * 3] = ~copy[7 * 3];
+  EXPECT_FALSE(equal(image, image_copy));
+  EXPECT_TRUE(equal(crop(image, 1, 2, 4, 5), crop(image_copy, 1, 2, 4, 5)));
+  // Different layouts with the same content.
+  std::vector<std::byte> compact(4 * 5 * 3);
+  const ImageView<PixelFormatRGB24, true> compact_image(4, 5, 5, compact);
+  for (unsigned int y = 0; y < 4; ++y) {
+    for (unsigned int x = 0; x < 5; ++x) {
+      compact_image(y, x) = image(y + 1, x + 2);
+    }
+  }
+  EXPECT_TRUE(equal(compact_image, crop(image, 1, 2, 4, 5)));
+  const RGB24 color = image(4, 6);
+  compact_image(3, 4) = RGB24(color.red ^ 1, color.green, color.blue);
+  EXPECT_FALSE(equal(compact_image, crop(image, 1, 2, 4, 5)));
+  EXPECT_FALSE(equal(compact_image, crop(image, 1, 2, 4, 4)));
+}
+
+TEST(hash, ConsistentWithEqual) {
+  const std::vector<std::byte> data = test::makeBitmap(6 * 8 * 3, 6);
+  const ImageView<PixelFormatRGB24> image(6, 8, 8, data);
+  const ImageView<PixelFormatRGB24> cropped = crop(image, 1, 2, 4, 5);
+  std::vector<std::byte> compact(4 * 5 * 3);
+  const ImageView<PixelFormatRGB24, true> compact_image(4, 5, 5, compact);
+  copy(cropped, compact_image);
+  EXPECT_EQ(hash(compact_image), hash(cropped));
+  EXPECT_NE(hash(crop(image, 1, 2, 4, 4)), hash(cropped));
+  compact_image(2, 2) = RGB24(0, 0, 0);
+  compact_image(2, 3) = RGB24(0, 0, 1);
+  EXPECT_NE(hash(compact_image), hash(cropped));
+}
+
+// PixelFormat that stores grayscale intensities inverted; it is not trivially encoded.
+class PixelFormatInverted8 {
+ public:
+  using color_type = unsigned char;
+  static constexpr int kBytesPerPixel = 1;
+
+  constexpr color_type read(std::span<const std::byte, 1> data) const {
+    return static_cast<color_type>(~static_cast<unsigned char>(data[0]));
+  }
+
+  constexpr void write(const color_type& color, std::span<std::byte, 1> data) const {
+    data[0] = static_cast<std::byte>(~color);
+  }
+};
+
+TEST(equal, NotTriviallyEncoded) {
+  const std::vector<std::byte> data = test::makeBitmap(5 * 6, 7);
+  std::vector<std::byte> copy(data);
+  const ImageView<PixelFormatInverted8> image(5, 6, 6, data);
+  const ImageView<PixelFormatInverted8> image_copy(5, 6, 6, copy);
+  EXPECT_TRUE(equal(image, image_copy));
+  EXPECT_EQ(hash(image), hash(image_copy));
+  copy[13] = ~copy[13];
+  EXPECT_FALSE(equal(image, image_copy));
+  EXPECT_TRUE(equal(crop(image, 3, 0, 2, 6), crop(image_copy, 3, 0, 2, 6)));
+}
+
+template <std::endian ByteOrder>
+void checkSignedZeros() {
+  using PixelFormat = BasicPixelFormatGrayscaleF32<ByteOrder>;
+  std::array<std::byte, 8> lhs_data = {};
+  std::array<std::byte, 8> rhs_data = {};
+  const ImageView<PixelFormat, true> lhs(1, 2, 2, lhs_data);
+  const ImageView<PixelFormat, true> rhs(1, 2, 2, rhs_data);
+  lhs(0, 0) = 1.0f;
+  rhs(0, 0) = 1.0f;
+  lhs(0, 1) = 0.0f;
+  rhs(0, 1) = -0.0f;
+  EXPECT_FALSE(equal(lhs, rhs));
+  rhs(0, 1) = 0.0f;
+  EXPECT_TRUE(equal(lhs, rhs));
+  EXPECT_EQ(hash(lhs), hash(rhs));
+  lhs(0, 1) = std::bit_cast<float>(0x7FC00001u);
+  rhs(0, 1) = std::bit_cast<float>(0x7FC00001u);
+  EXPECT_TRUE(equal(lhs, rhs));
+  EXPECT_EQ(hash(lhs), hash(rhs));
+}
+
+TEST(equal, FloatingPointComparesEncodedBytes) {
+  checkSignedZeros<std::endian::little>();
+  checkSignedZeros<std::endian::big>();
+}
+
+TEST(sad, MatchesDefinition) {
+  const std::vector<std::byte> lhs_data = test::makeBitmap(5 * 7 * 4, 2);
+  const std::vector<std::byte> rhs_data = test::makeBitmap(5 * 7 * 4, 3);
+  const ImageView<PixelFormatRGBA32> lhs(5, 7, 7, lhs_data);
+  const ImageView<PixelFormatRGBA32> rhs(5, 7, 7, rhs_data);
+  std::uint64_t expected = 0;
+  for (std::size_t i = 0; i < lhs_data.size(); ++i) {
+    expected += std::abs(static_cast<int>(lhs_data[i]) - static_cast<int>(rhs_data[i]));
+  }
+  EXPECT_EQ(sad(lhs, rhs), expected);
+  EXPECT_EQ(sad(lhs, rhs, 3), expected);
+  EXPECT_EQ(sad(lhs, lhs), 0);
+}
+
+TEST(mse, MatchesDefinition) {
+  static constexpr std::array<std::byte, 4> kLhs{std::byte{0}, std::byte{10}, std::byte{20}, std::byte{255}};
+  static constexpr std::array<std::byte, 4> kRhs{std::byte{1}, std::byte{13}, std::byte{20}, std::byte{251}};
+  const ImageView<PixelFormatGrayscale8> lhs(2, 2, 2, kLhs);
+  const ImageView<PixelFormatGrayscale8> rhs(2, 2, 2, kRhs);
+  EXPECT_DOUBLE_EQ(mse(lhs, rhs), (1.0 + 9.0 + 0.0 + 16.0) / 4);
+  EXPECT_DOUBLE_EQ(psnr(lhs, rhs), 10.0 * std::log10(255.0 * 255.0 / 6.5));
+  EXPECT_TRUE(std::isinf(psnr(lhs, lhs)));
+  EXPECT_THROW(mse(lhs, ImageView<PixelFormatGrayscale8>(1, 4, 4, kRhs)), std::invalid_argument);
+}
+
+TEST(ssim, MatchesNaiveImplementation) {
+  const std::vector<std::byte> lhs_data = test::makeBitmap(20 * 24, 4);
+  std::vector<std::byte> rhs_data(lhs_data);
+  const std::vector<std::byte> noise = test::makeBitmap(20 * 24, 5);
+  for (std::size_t i = 0; i < rhs_data.size(); ++i) {
+    rhs_data[i] = static_cast<std::byte>(static_cast<unsigned int>(rhs_data[i]) / 2 +
+                                         static_cast<unsigned int>(noise[i]) / 4);
+  }
+  const auto lhs = crop(ImageView<PixelFormatGrayscale8>(20, 24, 24, lhs_data), 1, 2, 18, 21);
+  const auto rhs = crop(ImageView<PixelFormatGrayscale8>(20, 24, 24, rhs_data), 1, 2, 18, 21);
+  const double expected = computeSsimNaive(lhs, rhs, 7);
+  EXPECT_NEAR(ssim(lhs, rhs, 7), expected, 1e-9);
+  EXPECT_NEAR(ssim(lhs, rhs, 7, 4), expected, 1e-9);
+  EXPECT_NEAR(ssim(lhs, lhs, 7), 1.0, 1e-12);
+  EXPECT_THROW(ssim(lhs, rhs, 19), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,182 @@
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageLoader.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+std::vector<std::byte> makeBitmap(unsigned int height, unsigned int width, unsigned int seed) {
+  std::vector<std::byte> data(static_cast<std::size_t>(height) * width * 3);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>((i / 7 + seed * 31) % 256);
+  }
+  return data;
+}
+
+class ImageLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    directory_ = std::filesystem::temp_directory_path() / "imageview_ImageLoader_test";
+    std::filesystem::create_directories(directory_);
+  }
+
+  void TearDown() override { std::filesystem::remove_all(directory_); }
+
+  // Writes the bitmap as a QOI file if @index is even, and as a BMP file otherwise.
+  std::filesystem::path writeImage(unsigned int index, ImageView<PixelFormatRGB24> image) {
+    const std::filesystem::path path = directory_ / ("image" + std::to_string(index));
+    std::ofstream stream(path, std::ios::binary);
+    if (index % 2 == 0) {
+      encodeQoi(image, stream);
+    } else {
+      writeBmp(image, stream);
+    }
+    return path;
+  }
+
+  std::filesystem::path directory_;
+};
+
+TEST_F(ImageLoaderTest, LoadsFilesInOrder) {
+  constexpr unsigned int kNumImages = 9;
+  std::vector<std::vector<std::byte>> bitmaps;
+  std::vector<std::filesystem::path> paths;
+  for (unsigned int i = 0; i < kNumImages; ++i) {
+    bitmaps.push_back(makeBitmap(10 + i % 2, 13, i));
+    paths.push_back(writeImage(i, ImageView<PixelFormatRGB24>(10 + i % 2, 13, 13, bitmaps.back())));
+  }
+  ImagePool pool;
+  {
+    AsyncImageLoader<PixelFormatRGB24> loader(paths, pool, AsyncImageLoaderOptions{3, 2});
+    EXPECT_EQ(loader.size(), kNumImages);
+    for (unsigned int i = 0; i < kNumImages; ++i) {
+      std::optional<LoadedImage<PixelFormatRGB24>> loaded = loader.next();
+      ASSERT_TRUE(loaded.has_value());
+      EXPECT_EQ(loaded->index, i);
+      EXPECT_TRUE(equal(ImageView<PixelFormatRGB24>(loaded->image),
+                        ImageView<PixelFormatRGB24>(10 + i % 2, 13, 13, bitmaps[i])));
+    }
+    EXPECT_FALSE(loader.next().has_value());
+  }
+  // Images of the same size reuse the buffers of the images delivered earlier.
+  EXPECT_GT(pool.stats().hits, 0u);
+}
+
+TEST_F(ImageLoaderTest, ConvertsToRGBA32) {
+  const std::vector<std::byte> bitmap = makeBitmap(4, 5, 1);
+  const ImageView<PixelFormatRGB24> image(4, 5, 5, bitmap);
+  ImagePool pool;
+  AsyncImageLoader<PixelFormatRGBA32> loader({writeImage(0, image), writeImage(1, image)}, pool);
+  for (unsigned int i = 0; i < 2; ++i) {
+    const std::optional<LoadedImage<PixelFormatRGBA32>> loaded = loader.next();
+    ASSERT_TRUE(loaded.has_value());
+    const ImageView<PixelFormatRGBA32> view = loaded->image;
+    for (unsigned int y = 0; y < image.height(); ++y) {
+      for (unsigned int x = 0; x < image.width(); ++x) {
+        const RGB24 color = image(y, x);
+        EXPECT_EQ(view(y, x), RGBA32(color.red, color.green, color.blue, 255));
+      }
+    }
+  }
+}
+
+// Returns a 1x2 32-bit BMP file whose pixels have 0 in the 4th byte. If @alpha_mask is true, the file has a
+// BITMAPV4HEADER that declares the 4th byte as alpha; otherwise it is a BI_RGB file with BITMAPINFOHEADER.
+std::vector<std::byte> makeBmp32(bool alpha_mask) {
+  const std::size_t info_header_size = alpha_mask ? 108 : 40;
+  const std::size_t pixel_data_offset = 14 + info_header_size;
+  std::vector<std::byte> file(pixel_data_offset + 8);
+  file[0] = std::byte{'B'};
+  file[1] = std::byte{'M'};
+  detail::storeBmpUint32(static_cast<std::uint32_t>(file.size()), file.data() + 2);
+  detail::storeBmpUint32(static_cast<std::uint32_t>(pixel_data_offset), file.data() + 10);
+  detail::storeBmpUint32(static_cast<std::uint32_t>(info_header_size), file.data() + 14);
+  detail::storeBmpUint32(2, file.data() + 18);
+  detail::storeBmpUint32(1, file.data() + 22);
+  detail::storeBmpUint16(1, file.data() + 26);
+  detail::storeBmpUint16(32, file.data() + 28);
+  if (alpha_mask) {
+    detail::storeBmpUint32(detail::kBmpCompressionBitfields, file.data() + 30);
+    detail::storeBmpUint32(0x00FF0000, file.data() + 54);
+    detail::storeBmpUint32(0x0000FF00, file.data() + 58);
+    detail::storeBmpUint32(0x000000FF, file.data() + 62);
+    detail::storeBmpUint32(0xFF000000, file.data() + 66);
+  }
+  // BGRA
+  const std::array<std::byte, 8> pixels = {std::byte{1}, std::byte{2}, std::byte{3}, std::byte{0},
+                                           std::byte{4}, std::byte{5}, std::byte{6}, std::byte{0}};
+  std::copy(pixels.begin(), pixels.end(), file.begin() + pixel_data_offset);
+  return file;
+}
+
+TEST_F(ImageLoaderTest, ReservedByteOfBmpIsNotAlpha) {
+  std::vector<std::filesystem::path> paths;
+  for (bool alpha_mask : {false, true}) {
+    const std::vector<std::byte> file = makeBmp32(alpha_mask);
+    paths.push_back(directory_ / (alpha_mask ? "alpha.bmp" : "rgb.bmp"));
+    std::ofstream(paths.back(), std::ios::binary)
+        .write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+  }
+  ImagePool pool;
+  AsyncImageLoader<PixelFormatRGBA32> loader(paths, pool);
+  const std::optional<LoadedImage<PixelFormatRGBA32>> opaque = loader.next();
+  ASSERT_TRUE(opaque.has_value());
+  EXPECT_EQ(ImageView<PixelFormatRGBA32>(opaque->image)(0, 0), RGBA32(3, 2, 1, 255));
+  EXPECT_EQ(ImageView<PixelFormatRGBA32>(opaque->image)(0, 1), RGBA32(6, 5, 4, 255));
+  const std::optional<LoadedImage<PixelFormatRGBA32>> transparent = loader.next();
+  ASSERT_TRUE(transparent.has_value());
+  EXPECT_EQ(ImageView<PixelFormatRGBA32>(transparent->image)(0, 0), RGBA32(3, 2, 1, 0));
+  EXPECT_EQ(ImageView<PixelFormatRGBA32>(transparent->image)(0, 1), RGBA32(6, 5, 4, 0));
+}
+
+TEST_F(ImageLoaderTest, ReportsErrorsAndContinues) {
+  const std::vector<std::byte> bitmap = makeBitmap(3, 3, 2);
+  const std::filesystem::path garbage = directory_ / "garbage";
+  std::ofstream(garbage) << "not an image";
+  ImagePool pool;
+  AsyncImageLoader<PixelFormatRGB24> loader(
+      {directory_ / "missing", garbage, writeImage(0, ImageView<PixelFormatRGB24>(3, 3, 3, bitmap))}, pool);
+  EXPECT_THROW(loader.next(), std::runtime_error);
+  EXPECT_THROW(loader.next(), std::runtime_error);
+  const std::optional<LoadedImage<PixelFormatRGB24>> loaded = loader.next();
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(loaded->index, 2u);
+  EXPECT_FALSE(loader.next().has_value());
+  EXPECT_THROW(AsyncImageLoader<PixelFormatRGB24>({}, pool, AsyncImageLoaderOptions{0, 1}), std::invalid_argument);
+}
+
+TEST_F(ImageLoaderTest, ReadAheadIsBounded) {
+  const std::vector<std::byte> bitmap = makeBitmap(8, 8, 3);
+  std::vector<std::filesystem::path> paths;
+  for (unsigned int i = 0; i < 6; ++i) {
+    paths.push_back(writeImage(i, ImageView<PixelFormatRGB24>(8, 8, 8, bitmap)));
+  }
+  ImagePool pool;
+  AsyncImageLoader<PixelFormatRGB24> loader(paths, pool, AsyncImageLoaderOptions{4, 2});
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LE(pool.stats().acquisitions, 2u);
+  const std::optional<LoadedImage<PixelFormatRGB24>> first = loader.next();
+  ASSERT_TRUE(first.has_value());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_LE(pool.stats().acquisitions, 3u);
+  // Destroying the loader with undelivered files doesn't block.
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,114 @@
+#include <imageview/ImagePool.h>
+#include <imageview/ImageViewUtils.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+TEST(ImagePool, RecyclesBuffers) {
+  ImagePool pool;
+  const std::byte* first_data = nullptr;
+  {
+    PooledImage<PixelFormatRGB24> image = pool.acquire<PixelFormatRGB24>(20, 30);
+    EXPECT_EQ(image.height(), 20u);
+    EXPECT_EQ(image.width(), 30u);
+    EXPECT_EQ(image.stride(), 30u);
+    first_data = image.view().data().data();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first_data) % ImagePool::kAlignment, 0u);
+    fill(image.view(), RGB24(1, 2, 3));
+    const ImageView<PixelFormatRGB24> view = image;
+    EXPECT_EQ(view(19, 29), RGB24(1, 2, 3));
+    EXPECT_EQ(image.continuousView().area(), 20u * 30u);
+  }
+  ImagePoolStats stats = pool.stats();
+  EXPECT_EQ(stats.acquisitions, 1u);
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(stats.bytes_resident, 20u * 30u * 3u);
+  EXPECT_EQ(stats.bytes_cached, 20u * 30u * 3u);
+
+  // A buffer of the same size is reused, even for another pixel format.
+  PooledImage<PixelFormatRGBA32> image = pool.acquire<PixelFormatRGBA32>(15, 30);
+  EXPECT_EQ(image.view().data().data(), first_data);
+  PooledImage<PixelFormatRGB24> other = pool.acquire<PixelFormatRGB24>(20, 30);
+  EXPECT_NE(other.view().data().data(), first_data);
+  stats = pool.stats();
+  EXPECT_EQ(stats.acquisitions, 3u);
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 1.0 / 3.0);
+  EXPECT_EQ(stats.bytes_cached, 0u);
+  EXPECT_EQ(stats.bytes_resident, 2u * 20u * 30u * 3u);
+  EXPECT_EQ(stats.peak_bytes_resident, 2u * 20u * 30u * 3u);
+
+  image.reset();
+  EXPECT_TRUE(image.empty());
+  other = PooledImage<PixelFormatRGB24>();
+  EXPECT_EQ(pool.stats().bytes_cached, 2u * 20u * 30u * 3u);
+  pool.trim();
+  stats = pool.stats();
+  EXPECT_EQ(stats.bytes_cached, 0u);
+  EXPECT_EQ(stats.bytes_resident, 0u);
+  EXPECT_EQ(stats.peak_bytes_resident, 2u * 20u * 30u * 3u);
+}
+
+TEST(ImagePool, StrideAndMove) {
+  ImagePool pool(false);
+  PooledImage<PixelFormatGrayscale8> image = pool.acquire<PixelFormatGrayscale8>(4, 5, 64);
+  EXPECT_EQ(image.view().stride(), 64u);
+  EXPECT_THROW(image.continuousView(), std::logic_error);
+  const PooledImage<PixelFormatGrayscale8> moved = std::move(image);
+  EXPECT_TRUE(image.empty());
+  EXPECT_EQ(moved.width(), 5u);
+  EXPECT_THROW(pool.acquire<PixelFormatGrayscale8>(4, 5, 4), std::invalid_argument);
+  EXPECT_TRUE(pool.acquire<PixelFormatGrayscale8>(0, 5).view().empty());
+}
+
+TEST(ImagePool, ExcessBuffersAreFreed) {
+  ImagePool pool;
+  std::vector<PooledImage<PixelFormatGrayscale8>> images;
+  for (std::size_t i = 0; i < ImagePool::kSlotsPerSizeClass + 3; ++i) {
+    images.push_back(pool.acquire<PixelFormatGrayscale8>(8, 8));
+  }
+  images.clear();
+  const ImagePoolStats stats = pool.stats();
+  EXPECT_EQ(stats.bytes_cached, ImagePool::kSlotsPerSizeClass * 64);
+  EXPECT_EQ(stats.bytes_resident, ImagePool::kSlotsPerSizeClass * 64);
+}
+
+TEST(ImagePool, ConcurrentUse) {
+  ImagePool pool;
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool, t] {
+      for (unsigned int i = 0; i < 200; ++i) {
+        PooledImage<PixelFormatGrayscale8> image = pool.acquire<PixelFormatGrayscale8>(16, 16 + i % 3);
+        fill(image.view(), static_cast<unsigned char>(t));
+        for (unsigned char value : image.continuousView()) {
+          ASSERT_EQ(value, t);
+        }
+        // The counter must never wrap around, even while other threads release and acquire buffers.
+        ASSERT_LE(pool.stats().bytes_cached, 4u * ImagePool::kSlotsPerSizeClass * 16u * 18u);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  const ImagePoolStats stats = pool.stats();
+  EXPECT_EQ(stats.acquisitions, 800u);
+  EXPECT_GT(stats.hits, 700u);
+  EXPECT_EQ(stats.bytes_resident, stats.bytes_cached);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,73 @@
+#include <imageview/ImageView.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// 3x2 image with stride 4:
+//   0 1 . .
+//   4 5 . .
+//   8 9
+constexpr std::array<std::byte, 10> kSampleData{std::byte{0}, std::byte{1}, std::byte{2}, std::byte{3},
+                                                std::byte{4}, std::byte{5}, std::byte{6}, std::byte{7},
+                                                std::byte{8}, std::byte{9}};
+constexpr ImageView<PixelFormatGrayscale8> kSampleImage(3, 2, 4, kSampleData);
+
+TEST(ImageViewFlatIterator, SkipsGaps) {
+  std::vector<unsigned char> values;
+  for (unsigned char value : kSampleImage) {
+    values.push_back(value);
+  }
+  EXPECT_EQ(values, (std::vector<unsigned char>{0, 1, 4, 5, 8, 9}));
+  static_assert(kSampleImage.end() - kSampleImage.begin() == 6, "The range must have 6 elements.");
+}
+
+TEST(ImageViewFlatIterator, Arithmetic) {
+  constexpr auto first = kSampleImage.begin();
+  static_assert(first[3] == 5, "Must be 5.");
+  static_assert(*(first + 4) == 8, "Must be 8.");
+  static_assert(*(kSampleImage.end() - 1) == 9, "Must be 9.");
+  static_assert((first + 3).rowIndex() == 1, "Must be in row 1.");
+  static_assert((first + 3).columnIndex() == 1, "Must be in column 1.");
+  static_assert(first + 6 == kSampleImage.end(), "Must be equal to end().");
+  auto iter = kSampleImage.end();
+  --iter;
+  --iter;
+  EXPECT_EQ(*iter, 8);
+  EXPECT_TRUE(first < iter);
+}
+
+TEST(ImageViewFlatIterator, Segments) {
+  constexpr auto iter = kSampleImage.begin() + 2;
+  static_assert(iter.localEnd() - iter.local() == 2, "The row segment must have 2 pixels.");
+  static_assert(*iter.local() == 4, "Must be 4.");
+  constexpr auto iter2 = kSampleImage.begin() + 3;
+  static_assert(iter2.localEnd() - iter2.local() == 1, "The rest of the row must have 1 pixel.");
+}
+
+TEST(ImageViewFlatIterator, EmptyImage) {
+  static constexpr std::array<std::byte, 0> kData{};
+  constexpr ImageView<PixelFormatGrayscale8> image(3, 0, 0, kData);
+  static_assert(image.begin() == image.end(), "The range must be empty.");
+}
+
+TEST(ImageViewFlatIterator, Write) {
+  std::array<std::byte, 10> data{};
+  const ImageView<PixelFormatGrayscale8, true> image(3, 2, 4, data);
+  unsigned char value = 1;
+  for (auto&& pixel : image) {
+    pixel = value++;
+  }
+  EXPECT_EQ(data[0], std::byte{1});
+  EXPECT_EQ(data[2], std::byte{0});
+  EXPECT_EQ(data[5], std::byte{4});
+  EXPECT_EQ(data[9], std::byte{6});
+}
+
+}  // namespace
+}  // namespace imageview
@@ -1,9 +1,11 @@
 #include <imageview/ImageViewUtils.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
 #include <imageview/pixel_formats/PixelFormatRGB24.h>
 
 #include <gtest/gtest.h>
 
 #include <array>
+#include <vector>
 
 namespace imageview {
 namespace {
@@ -85,5 +87,58 @@ TEST(cropImageView, CropStrided) {
                 "data() should point to the element (1, 1) in the original image.");
 }
 
+// PixelFormat that stores RGB24 colors in BGR order; it is not trivially encoded.
+class PixelFormatBGR24 {
+ public:
+  using color_type = RGB24;
+  static constexpr int kBytesPerPixel = 3;
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const {
+    return RGB24(static_cast<unsigned char>(data[2]), static_cast<unsigned char>(data[1]),
+                 static_cast<unsigned char>(data[0]));
+  }
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const {
+    data[0] = static_cast<std::byte>(color.blue);
+    data[1] = static_cast<std::byte>(color.green);
+    data[2] = static_cast<std::byte>(color.red);
+  }
+};
+
+template <class PixelFormat>
+void testFillAndCopy() {
+  constexpr RGB24 kBackground(1, 2, 3);
+  constexpr RGB24 kColor(10, 20, 30);
+  constexpr unsigned int kHeight = 4;
+  constexpr unsigned int kStride = 7;
+  std::vector<std::byte> data(kHeight * kStride * 3);
+  const ImageView<PixelFormat, true> image(kHeight, kStride, kStride, data);
+  fill(image, kBackground);
+  fill(crop(image, 1, 2, 2, 4), kColor);
+  for (unsigned int y = 0; y < kHeight; ++y) {
+    for (unsigned int x = 0; x < kStride; ++x) {
+      const bool inside = y >= 1 && y < 3 && x >= 2 && x < 6;
+      EXPECT_EQ(image(y, x), inside ? kColor : kBackground) << "y=" << y << " x=" << x;
+    }
+  }
+  std::vector<std::byte> copy_data(2 * 4 * 3);
+  const ImageView<PixelFormat, true> copy_image(2, 4, 4, copy_data);
+  copy(crop(image, 1, 1, 2, 4), copy_image);
+  EXPECT_EQ(copy_image(0, 0), kBackground);
+  EXPECT_EQ(copy_image(1, 3), kColor);
 }
+
+TEST(fillAndCopy, TriviallyEncoded) { testFillAndCopy<PixelFormatRGB24>(); }
+
+TEST(fillAndCopy, NotTriviallyEncoded) { testFillAndCopy<PixelFormatBGR24>(); }
+
+TEST(fill, Grayscale8) {
+  std::array<std::byte, 6> data{};
+  fill(ImageView<PixelFormatGrayscale8, true>(2, 3, 3, data), static_cast<unsigned char>(200));
+  for (std::byte value : data) {
+    EXPECT_EQ(value, std::byte{200});
+  }
 }
+
+}  // namespace
+}  // namespace imageview
@@ -68,5 +68,15 @@ TEST(ImageView, ReadElement) {
   static_assert(image(1, 1) == RGB24(0, 0, 0), "Must be {0, 0, 0}.");
 }
 
+TEST(ImageView, AssignElement) {
+  std::array<std::byte, 2 * PixelFormatRGB24::kBytesPerPixel> data = makeByteArray("\x01\x02\x03" "\x04\x05\x06");
+  const ImageView<PixelFormatRGB24, true> image(1, 2, 2, data);
+  image(0, 1) = image(0, 0);
+  EXPECT_EQ(image(0, 1), RGB24(1, 2, 3));
+  // Self-assignment must leave the pixel unchanged.
+  image(0, 0) = image(0, 0);
+  EXPECT_EQ(image(0, 0), RGB24(1, 2, 3));
+}
+
 }  // namespace
 }  // namespace imageview
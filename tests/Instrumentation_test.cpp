@@ -0,0 +1,146 @@
+#define IMAGEVIEW_ENABLE_INSTRUMENTATION
+#include <imageview/ContinuousImageView.h>
+#include <imageview/ImageView.h>
+#include <imageview/Instrumentation.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <sstream>
+#include <string>
+
+namespace imageview {
+namespace {
+
+// Pixel format used only in this file. The instrumentation hooks are instantiated per pixel format, so using a
+// dedicated format keeps the instrumented instantiations separate from those in other test files.
+class InstrumentedPixelFormat {
+ public:
+  using color_type = unsigned char;
+  static constexpr int kBytesPerPixel = 1;
+
+  constexpr color_type read(std::span<const std::byte, kBytesPerPixel> data) const {
+    return static_cast<color_type>(data[0]);
+  }
+
+  constexpr void write(const color_type& color, std::span<std::byte, kBytesPerPixel> data) const {
+    data[0] = static_cast<std::byte>(color);
+  }
+};
+
+const instrumentation::CallSiteReport* findReport(const std::vector<instrumentation::CallSiteReport>& reports,
+                                                  unsigned int line) {
+  for (const instrumentation::CallSiteReport& report : reports) {
+    if (report.line == line) {
+      return &report;
+    }
+  }
+  return nullptr;
+}
+
+TEST(Instrumentation, CountsAccessesPerCallSite) {
+  instrumentation::resetReports();
+  std::array<std::byte, 4 * 200> data{};
+  const ImageView<InstrumentedPixelFormat, true> image(4, 100, 200, std::span(data).first(3 * 200 + 100));
+  unsigned int write_line = 0;
+  unsigned int read_line = 0;
+  {
+    IMAGEVIEW_INSTRUMENTATION_SCOPE();
+    write_line = __LINE__ - 1;
+    // Column-major traversal: every access jumps by the stride.
+    for (unsigned int x = 0; x < image.width(); ++x) {
+      for (unsigned int y = 0; y < image.height(); ++y) {
+        image(y, x) = static_cast<unsigned char>(x);
+      }
+    }
+  }
+  {
+    IMAGEVIEW_INSTRUMENTATION_SCOPE();
+    read_line = __LINE__ - 1;
+    const ImageView<InstrumentedPixelFormat> input(image);
+    unsigned int sum = 0;
+    for (unsigned int y = 0; y < input.height(); ++y) {
+      for (unsigned char value : input.row(y)) {
+        sum += value;
+      }
+    }
+    EXPECT_EQ(sum, 4 * 99 * 100 / 2);
+  }
+  // Accesses outside of scopes are not recorded.
+  image(0, 0) = 1;
+
+  const std::vector<instrumentation::CallSiteReport> reports = instrumentation::getReports();
+  const instrumentation::CallSiteReport* write_report = findReport(reports, write_line);
+  ASSERT_NE(write_report, nullptr);
+  EXPECT_EQ(write_report->stats.writes, 400);
+  EXPECT_EQ(write_report->stats.bytes_written, 400);
+  EXPECT_EQ(write_report->stats.reads, 0);
+  EXPECT_EQ(write_report->stats.stride_jumps, 399);
+
+  const instrumentation::CallSiteReport* read_report = findReport(reports, read_line);
+  ASSERT_NE(read_report, nullptr);
+  EXPECT_EQ(read_report->stats.reads, 400);
+  EXPECT_EQ(read_report->stats.bytes_read, 400);
+  EXPECT_EQ(read_report->stats.row_calls, 4);
+  // Only the transitions between rows jump.
+  EXPECT_EQ(read_report->stats.stride_jumps, 3);
+
+  std::ostringstream stream;
+  instrumentation::printReports(stream);
+  EXPECT_NE(stream.str().find("writes=400"), std::string::npos);
+}
+
+TEST(Instrumentation, NestedScopes) {
+  instrumentation::resetReports();
+  std::array<std::byte, 4> data{};
+  const ContinuousImageView<InstrumentedPixelFormat, true> image(2, 2, data);
+  unsigned int outer_line = 0;
+  unsigned int inner_line = 0;
+  {
+    IMAGEVIEW_INSTRUMENTATION_SCOPE();
+    outer_line = __LINE__ - 1;
+    image(0, 0) = 1;
+    {
+      IMAGEVIEW_INSTRUMENTATION_SCOPE();
+      inner_line = __LINE__ - 1;
+      image(0, 1) = image(0, 0);
+    }
+    EXPECT_EQ(image(0, 1), 1);
+  }
+  const std::vector<instrumentation::CallSiteReport> reports = instrumentation::getReports();
+  ASSERT_EQ(reports.size(), 2);
+  const instrumentation::CallSiteReport* outer = findReport(reports, outer_line);
+  const instrumentation::CallSiteReport* inner = findReport(reports, inner_line);
+  ASSERT_NE(outer, nullptr);
+  ASSERT_NE(inner, nullptr);
+  EXPECT_EQ(outer->stats.writes, 1);
+  EXPECT_EQ(outer->stats.reads, 1);
+  EXPECT_EQ(inner->stats.writes, 1);
+  EXPECT_EQ(inner->stats.reads, 1);
+}
+
+TEST(Instrumentation, NestedScopeDoesNotAffectJumpsOfParent) {
+  instrumentation::resetReports();
+  std::array<std::byte, 2 * 1000> data{};
+  const ContinuousImageView<InstrumentedPixelFormat, true> image(2, 1000, data);
+  unsigned int outer_line = 0;
+  {
+    IMAGEVIEW_INSTRUMENTATION_SCOPE();
+    outer_line = __LINE__ - 1;
+    image(0, 0) = 1;
+    {
+      IMAGEVIEW_INSTRUMENTATION_SCOPE();
+      image(1, 999) = 2;
+    }
+    // Adjacent to the previous access of the outer scope.
+    image(0, 1) = 3;
+  }
+  const std::vector<instrumentation::CallSiteReport> reports = instrumentation::getReports();
+  const instrumentation::CallSiteReport* outer = findReport(reports, outer_line);
+  ASSERT_NE(outer, nullptr);
+  EXPECT_EQ(outer->stats.writes, 2);
+  EXPECT_EQ(outer->stats.stride_jumps, 0);
+}
+
+}  // namespace
+}  // namespace imageview
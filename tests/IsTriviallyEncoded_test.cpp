@@ -0,0 +1,52 @@
+#include <imageview/IsTriviallyEncoded.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale16.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+#include <imageview/pixel_formats/PixelFormatRGBA32.h>
+#include <imageview/pixel_formats/PixelFormatRGBF32.h>
+
+#include <bit>
+
+namespace imageview {
+namespace {
+
+static_assert(IsTriviallyEncoded<PixelFormatGrayscale8>::value, "PixelFormatGrayscale8 must be trivially encoded.");
+static_assert(IsTriviallyEncoded<PixelFormatRGB24>::value, "PixelFormatRGB24 must be trivially encoded.");
+static_assert(IsTriviallyEncoded<PixelFormatRGBA32>::value, "PixelFormatRGBA32 must be trivially encoded.");
+static_assert(IsTriviallyEncoded<BasicPixelFormatGrayscale16<std::endian::native>>::value,
+              "Native-endian PixelFormatGrayscale16 must be trivially encoded.");
+static_assert(IsTriviallyEncoded<PixelFormatRGBF32>::value == (std::endian::native == std::endian::little),
+              "PixelFormatRGBF32 must be trivially encoded only on little-endian platforms.");
+
+// Not a PixelFormat at all.
+static_assert(!IsTriviallyEncoded<int>::value, "int is not a PixelFormat.");
+
+// A valid PixelFormat that doesn't declare kIsTriviallyEncoded.
+class PixelFormatBGR24 {
+ public:
+  using color_type = RGB24;
+  static constexpr int kBytesPerPixel = 3;
+
+  constexpr color_type read(std::span<const std::byte, 3> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, 3> data) const;
+};
+static_assert(!IsTriviallyEncoded<PixelFormatBGR24>::value,
+              "IsTriviallyEncoded should be false for PixelFormatBGR24 - it doesn't opt in.");
+
+// A PixelFormat that opts in, but whose color_type has a different size.
+class PixelFormatPadded {
+ public:
+  using color_type = RGBA32;
+  static constexpr int kBytesPerPixel = 3;
+  static constexpr bool kIsTriviallyEncoded = true;
+
+  constexpr color_type read(std::span<const std::byte, 3> data) const;
+
+  constexpr void write(const color_type& color, std::span<std::byte, 3> data) const;
+};
+static_assert(!IsTriviallyEncoded<PixelFormatPadded>::value,
+              "IsTriviallyEncoded should be false for PixelFormatPadded - sizeof(color_type) != kBytesPerPixel.");
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,91 @@
+#include <imageview/MedianFilter.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Straightforward sort-based implementation of the median filter for continuous images.
+std::vector<std::byte> computeMedianNaive(const std::vector<std::byte>& data, int height, int width, int channels,
+                                          int radius) {
+  std::vector<std::byte> result(data.size());
+  std::vector<std::byte> window;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      for (int c = 0; c < channels; ++c) {
+        window.clear();
+        for (int dy = -radius; dy <= radius; ++dy) {
+          for (int dx = -radius; dx <= radius; ++dx) {
+            const int yy = std::clamp(y + dy, 0, height - 1);
+            const int xx = std::clamp(x + dx, 0, width - 1);
+            window.push_back(data[(yy * width + xx) * channels + c]);
+          }
+        }
+        std::nth_element(window.begin(), window.begin() + window.size() / 2, window.end());
+        result[(y * width + x) * channels + c] = window[window.size() / 2];
+      }
+    }
+  }
+  return result;
+}
+
+TEST(MedianFilter, Grayscale8) {
+  constexpr unsigned int kHeight = 23;
+  constexpr unsigned int kWidth = 150;
+  const std::vector<std::byte> src_data = test::makeBitmap(kHeight * kWidth, 1);
+  const ImageView<PixelFormatGrayscale8> src(kHeight, kWidth, kWidth, src_data);
+  for (unsigned int radius : {0u, 1u, 4u, 10u, 30u}) {
+    const std::vector<std::byte> expected = computeMedianNaive(src_data, kHeight, kWidth, 1, radius);
+    for (unsigned int num_threads : {1u, 4u}) {
+      std::vector<std::byte> dst_data(kHeight * kWidth);
+      medianFilter(src, ImageView<PixelFormatGrayscale8, true>(kHeight, kWidth, kWidth, dst_data), radius,
+                   num_threads);
+      EXPECT_EQ(dst_data, expected) << "radius = " << radius << ", num_threads = " << num_threads;
+    }
+  }
+}
+
+TEST(MedianFilter, RGB24) {
+  constexpr unsigned int kHeight = 9;
+  constexpr unsigned int kWidth = 70;
+  constexpr unsigned int kStride = 72;
+  const std::vector<std::byte> continuous_data = test::makeBitmap(kHeight * kWidth * 3, 2);
+  // Copy the data into a bitmap with gaps between rows.
+  std::vector<std::byte> src_data(((kHeight - 1) * kStride + kWidth) * 3);
+  for (unsigned int y = 0; y < kHeight; ++y) {
+    std::copy_n(continuous_data.begin() + y * kWidth * 3, kWidth * 3, src_data.begin() + y * kStride * 3);
+  }
+  const ImageView<PixelFormatRGB24> src(kHeight, kWidth, kStride, src_data);
+  std::vector<std::byte> dst_data(kHeight * kWidth * 3);
+  medianFilter(src, ImageView<PixelFormatRGB24, true>(kHeight, kWidth, kWidth, dst_data), 2, 3);
+  EXPECT_EQ(dst_data, computeMedianNaive(continuous_data, kHeight, kWidth, 3, 2));
+}
+
+TEST(MedianFilter, RemovesImpulseNoise) {
+  std::array<std::byte, 25> data = {};
+  data[12] = std::byte{255};
+  std::array<std::byte, 25> result = {};
+  medianFilter(ImageView<PixelFormatGrayscale8>(5, 5, 5, data), ImageView<PixelFormatGrayscale8, true>(5, 5, 5, result),
+               1);
+  EXPECT_EQ(result, (std::array<std::byte, 25>{}));
+}
+
+TEST(MedianFilter, InvalidArguments) {
+  std::array<std::byte, 6> src_data = {};
+  std::array<std::byte, 6> dst_data = {};
+  const ImageView<PixelFormatGrayscale8> src(2, 3, 3, src_data);
+  EXPECT_THROW(medianFilter(src, ImageView<PixelFormatGrayscale8, true>(3, 2, 2, dst_data), 1),
+               std::invalid_argument);
+  EXPECT_THROW(medianFilter(src, ImageView<PixelFormatGrayscale8, true>(2, 3, 3, dst_data), 128),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
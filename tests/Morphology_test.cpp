@@ -0,0 +1,135 @@
+#include <imageview/Morphology.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Straightforward implementation of erosion/dilation.
+std::vector<std::byte> computeNaive(ImageView<PixelFormatGrayscale8> image, unsigned int kernel_height,
+                                    unsigned int kernel_width, bool is_erosion) {
+  std::vector<std::byte> result(image.area());
+  const int anchor_y = kernel_height / 2;
+  const int anchor_x = kernel_width / 2;
+  for (int y = 0; y < static_cast<int>(image.height()); ++y) {
+    for (int x = 0; x < static_cast<int>(image.width()); ++x) {
+      int value = is_erosion ? 255 : 0;
+      for (int yy = std::max(0, y - anchor_y);
+           yy < std::min<int>(image.height(), y - anchor_y + static_cast<int>(kernel_height)); ++yy) {
+        for (int xx = std::max(0, x - anchor_x);
+             xx < std::min<int>(image.width(), x - anchor_x + static_cast<int>(kernel_width)); ++xx) {
+          value = is_erosion ? std::min<int>(value, image(yy, xx)) : std::max<int>(value, image(yy, xx));
+        }
+      }
+      result[y * image.width() + x] = static_cast<std::byte>(value);
+    }
+  }
+  return result;
+}
+
+TEST(Morphology, MatchesNaiveImplementation) {
+  constexpr unsigned int kHeight = 29;
+  constexpr unsigned int kWidth = 300;
+  constexpr unsigned int kStride = 301;
+  const std::vector<std::byte> src_data = test::makeBitmap((kHeight - 1) * kStride + kWidth, 1);
+  const ImageView<PixelFormatGrayscale8> src(kHeight, kWidth, kStride, src_data);
+  for (const auto [kernel_height, kernel_width] :
+       {std::array{1u, 1u}, std::array{3u, 3u}, std::array{2u, 5u}, std::array{7u, 1u}, std::array{40u, 17u}}) {
+    std::vector<std::byte> dst_data(kHeight * kWidth);
+    const ImageView<PixelFormatGrayscale8, true> dst(kHeight, kWidth, kWidth, dst_data);
+    erode(src, dst, kernel_height, kernel_width);
+    EXPECT_EQ(dst_data, computeNaive(src, kernel_height, kernel_width, true))
+        << "kernel " << kernel_height << "x" << kernel_width;
+    dilate(src, dst, kernel_height, kernel_width);
+    EXPECT_EQ(dst_data, computeNaive(src, kernel_height, kernel_width, false))
+        << "kernel " << kernel_height << "x" << kernel_width;
+  }
+}
+
+TEST(Morphology, InPlace) {
+  constexpr unsigned int kHeight = 10;
+  constexpr unsigned int kWidth = 12;
+  std::vector<std::byte> data = test::makeBitmap(kHeight * kWidth, 2);
+  const std::vector<std::byte> expected =
+      computeNaive(ImageView<PixelFormatGrayscale8>(kHeight, kWidth, kWidth, data), 5, 4, true);
+  const ImageView<PixelFormatGrayscale8, true> image(kHeight, kWidth, kWidth, data);
+  erode(image, image, 5, 4);
+  EXPECT_EQ(data, expected);
+}
+
+TEST(Morphology, OpenAndClose) {
+  // A binary mask with a 1-pixel speck and a 1-pixel hole in a 3x4 rectangle.
+  constexpr unsigned int kHeight = 7;
+  constexpr unsigned int kWidth = 8;
+  std::vector<std::byte> data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> mask(kHeight, kWidth, kWidth, data);
+  mask(0, 7) = 255;
+  for (unsigned int y = 2; y < 5; ++y) {
+    for (unsigned int x = 1; x < 5; ++x) {
+      mask(y, x) = 255;
+    }
+  }
+  mask(3, 2) = 0;
+
+  std::vector<std::byte> closed_data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> closed(kHeight, kWidth, kWidth, closed_data);
+  close(mask, closed, 3, 3);
+  EXPECT_EQ(closed(3, 2), 255);
+  EXPECT_EQ(closed(0, 7), 255);
+
+  std::vector<std::byte> opened_data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> opened(kHeight, kWidth, kWidth, opened_data);
+  open(closed, opened, 3, 3);
+  EXPECT_EQ(opened(0, 7), 0);
+  EXPECT_EQ(opened(3, 2), 255);
+  EXPECT_EQ(opened(2, 1), 255);
+  EXPECT_EQ(opened(5, 1), 0);
+}
+
+TEST(Morphology, OpenAndCloseWithEvenKernelSizes) {
+  std::array<std::byte, 4> row_data = {std::byte{0}, std::byte{255}, std::byte{255}, std::byte{0}};
+  const ImageView<PixelFormatGrayscale8> row(1, 4, 4, row_data);
+  std::array<std::byte, 4> row_result = {};
+  open(row, ImageView<PixelFormatGrayscale8, true>(1, 4, 4, row_result), 1, 2);
+  EXPECT_EQ(row_result, row_data);
+  close(row, ImageView<PixelFormatGrayscale8, true>(1, 4, 4, row_result), 1, 2);
+  // Pixels outside of the image are ignored, so the last pixel is covered by the element {3, 4}.
+  EXPECT_EQ(row_result, (std::array{std::byte{0}, std::byte{255}, std::byte{255}, std::byte{255}}));
+
+  // Opening is anti-extensive and closing is extensive for any structuring element.
+  constexpr unsigned int kHeight = 23;
+  constexpr unsigned int kWidth = 31;
+  const std::vector<std::byte> src_data = test::makeBitmap(kHeight * kWidth, 3);
+  const ImageView<PixelFormatGrayscale8> src(kHeight, kWidth, kWidth, src_data);
+  std::vector<std::byte> opened_data(kHeight * kWidth);
+  std::vector<std::byte> closed_data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> opened(kHeight, kWidth, kWidth, opened_data);
+  const ImageView<PixelFormatGrayscale8, true> closed(kHeight, kWidth, kWidth, closed_data);
+  for (const auto [kernel_height, kernel_width] :
+       {std::array{2u, 2u}, std::array{1u, 4u}, std::array{6u, 1u}, std::array{4u, 3u}, std::array{8u, 10u}}) {
+    open(src, opened, kernel_height, kernel_width);
+    close(src, closed, kernel_height, kernel_width);
+    for (std::size_t i = 0; i < src_data.size(); ++i) {
+      ASSERT_LE(opened_data[i], src_data[i]) << "kernel " << kernel_height << "x" << kernel_width << ", pixel " << i;
+      ASSERT_GE(closed_data[i], src_data[i]) << "kernel " << kernel_height << "x" << kernel_width << ", pixel " << i;
+    }
+  }
+}
+
+TEST(Morphology, InvalidArguments) {
+  std::array<std::byte, 6> src_data = {};
+  std::array<std::byte, 6> dst_data = {};
+  const ImageView<PixelFormatGrayscale8> src(2, 3, 3, src_data);
+  EXPECT_THROW(erode(src, ImageView<PixelFormatGrayscale8, true>(3, 2, 2, dst_data), 3, 3), std::invalid_argument);
+  EXPECT_THROW(dilate(src, ImageView<PixelFormatGrayscale8, true>(2, 3, 3, dst_data), 0, 3), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
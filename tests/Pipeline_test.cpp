@@ -0,0 +1,151 @@
+#include <imageview/Pipeline.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+unsigned char toGray(const RGB24& color) {
+  return static_cast<unsigned char>((color.red + color.green * 2 + color.blue) / 4);
+}
+
+// Averages the pixels in the 3x3 neighbourhood (replicating the borders).
+template <class Image>
+unsigned char blurredPixel(Image image, unsigned int y, unsigned int x) {
+  unsigned int sum = 0;
+  for (int dy = -1; dy <= 1; ++dy) {
+    for (int dx = -1; dx <= 1; ++dx) {
+      const int yy = std::clamp(static_cast<int>(y) + dy, 0, static_cast<int>(image.height()) - 1);
+      const int xx = std::clamp(static_cast<int>(x) + dx, 0, static_cast<int>(image.width()) - 1);
+      sum += image(yy, xx);
+    }
+  }
+  return static_cast<unsigned char>(sum / 9);
+}
+
+// Returns the "convert -> blur -> threshold" pipeline.
+auto makeTestPipeline() {
+  return Pipeline(
+      makePipelineStage<PixelFormatRGB24, PixelFormatGrayscale8>(
+          0, 0,
+          [](const RowWindow<PixelFormatRGB24>& input, ImageRowView<PixelFormatGrayscale8, true> output) {
+            std::transform(input.row(0).begin(), input.row(0).end(), output.begin(), toGray);
+          }),
+      makePipelineStage<PixelFormatGrayscale8, PixelFormatGrayscale8>(
+          1, 1,
+          [](const RowWindow<PixelFormatGrayscale8>& input, ImageRowView<PixelFormatGrayscale8, true> output) {
+            const std::array<ImageRowView<PixelFormatGrayscale8>, 3> rows = {input.row(-1), input.row(0),
+                                                                             input.row(1)};
+            const int width = static_cast<int>(input.width());
+            for (int x = 0; x < width; ++x) {
+              unsigned int sum = 0;
+              for (const auto& row : rows) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                  sum += row[std::clamp(x + dx, 0, width - 1)];
+                }
+              }
+              output[x] = static_cast<unsigned char>(sum / 9);
+            }
+          }),
+      makePipelineStage<PixelFormatGrayscale8, PixelFormatGrayscale8>(
+          0, 0,
+          [](const RowWindow<PixelFormatGrayscale8>& input, ImageRowView<PixelFormatGrayscale8, true> output) {
+            std::transform(input.row(0).begin(), input.row(0).end(), output.begin(),
+                           [](unsigned char value) -> unsigned char { return value >= 128 ? 255 : 0; });
+          }));
+}
+
+TEST(Pipeline, Context) {
+  const auto pipeline = makeTestPipeline();
+  static_assert(decltype(pipeline)::kNumStages == 3);
+  EXPECT_EQ(pipeline.contextAbove(0), 1);
+  EXPECT_EQ(pipeline.contextBelow(0), 1);
+  EXPECT_EQ(pipeline.contextAbove(1), 0);
+  EXPECT_EQ(pipeline.contextBelow(2), 0);
+}
+
+TEST(Pipeline, MatchesFullFrameProcessing) {
+  constexpr unsigned int kHeight = 37;
+  constexpr unsigned int kWidth = 23;
+  constexpr unsigned int kStride = 25;
+  const std::vector<std::byte> src_data =
+      test::makeBitmap(((kHeight - 1) * kStride + kWidth) * PixelFormatRGB24::kBytesPerPixel, 1);
+  const ImageView<PixelFormatRGB24> src(kHeight, kWidth, kStride, src_data);
+
+  // Reference: materialize every intermediate image.
+  std::vector<std::byte> gray_data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> gray(kHeight, kWidth, kWidth, gray_data);
+  for (unsigned int y = 0; y < kHeight; ++y) {
+    for (unsigned int x = 0; x < kWidth; ++x) {
+      gray(y, x) = toGray(src(y, x));
+    }
+  }
+  std::vector<std::byte> expected_data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> expected(kHeight, kWidth, kWidth, expected_data);
+  for (unsigned int y = 0; y < kHeight; ++y) {
+    for (unsigned int x = 0; x < kWidth; ++x) {
+      expected(y, x) = blurredPixel(gray, y, x) >= 128 ? 255 : 0;
+    }
+  }
+
+  const auto pipeline = makeTestPipeline();
+  for (unsigned int num_threads : {1u, 2u, 5u, 64u}) {
+    std::vector<std::byte> dst_data(kHeight * kWidth);
+    pipeline.run(src, ImageView<PixelFormatGrayscale8, true>(kHeight, kWidth, kWidth, dst_data), num_threads);
+    EXPECT_EQ(dst_data, expected_data) << "num_threads = " << num_threads;
+  }
+}
+
+TEST(Pipeline, SingleRowImage) {
+  std::array<std::byte, 4 * 3> src_data = {};
+  src_data[3] = std::byte{255};
+  src_data[4] = std::byte{255};
+  src_data[5] = std::byte{255};
+  const ImageView<PixelFormatRGB24> src(1, 4, 4, src_data);
+  std::array<std::byte, 4> dst_data = {};
+  makeTestPipeline().run(src, ImageView<PixelFormatGrayscale8, true>(1, 4, 4, dst_data));
+  // Blurred values are {85, 85, 0, 0}.
+  EXPECT_EQ(dst_data, (std::array<std::byte, 4>{}));
+}
+
+TEST(Pipeline, WrongDimensions) {
+  std::array<std::byte, 6 * 3> src_data = {};
+  std::array<std::byte, 6> dst_data = {};
+  const ImageView<PixelFormatRGB24> src(2, 3, 3, src_data);
+  EXPECT_THROW(makeTestPipeline().run(src, ImageView<PixelFormatGrayscale8, true>(3, 2, 2, dst_data)),
+               std::invalid_argument);
+}
+
+TEST(RowWindow, ClampsRowsToImage) {
+  constexpr std::array<std::byte, 3> kData = {std::byte{1}, std::byte{2}, std::byte{3}};
+  const ImageView<PixelFormatGrayscale8> rows(3, 1, 1, kData);
+  const RowWindow<PixelFormatGrayscale8> window(rows, 3, 0, 2, 1);
+  EXPECT_EQ(window.rowIndex(), 0);
+  EXPECT_EQ(window.row(-2)[0], 1);
+  EXPECT_EQ(window.row(0)[0], 1);
+  EXPECT_EQ(window.row(1)[0], 2);
+  EXPECT_THROW(window.row(2), std::out_of_range);
+  EXPECT_THROW(window.row(-3), std::out_of_range);
+}
+
+TEST(RowWindow, RingBuffer) {
+  // Rows 3 and 4 of a 5-row image stored in a ring buffer with capacity 2.
+  constexpr std::array<std::byte, 2> kData = {std::byte{4}, std::byte{3}};
+  const ImageView<PixelFormatGrayscale8> rows(2, 1, 1, kData);
+  const RowWindow<PixelFormatGrayscale8> window(rows, 5, 4, 1, 1);
+  EXPECT_EQ(window.row(-1)[0], 3);
+  EXPECT_EQ(window.row(0)[0], 4);
+  EXPECT_EQ(window.row(1)[0], 4);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,38 @@
+#include <imageview/pixel_formats/PixelFormatBGRA32.h>
+#include <imageview/IsPixelFormat.h>
+#include <imageview/IsTriviallyEncoded.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace imageview {
+namespace {
+
+static_assert(IsPixelFormat<PixelFormatBGRA32>::value, "PixelFormatBGRA32 must be a valid PixelFormat.");
+static_assert(PixelFormatBGRA32::kBytesPerPixel == 4, "Color depth of PixelFormatBGRA32 must be 32 bpp.");
+static_assert(!IsTriviallyEncoded<PixelFormatBGRA32>::value, "PixelFormatBGRA32 must not be trivially encoded.");
+
+TEST(PixelFormatBGRA32, Read) {
+  static constexpr std::array<const std::byte, 4> kPixelData{std::byte{123}, std::byte{215}, std::byte{7},
+                                                              std::byte{42}};
+  constexpr PixelFormatBGRA32 pixel_format;
+  static_assert(pixel_format.read(kPixelData) == RGBA32(7, 215, 123, 42), "Must be {7, 215, 123, 42}.");
+}
+
+TEST(PixelFormatBGRA32, Write) {
+  static constexpr PixelFormatBGRA32 pixel_format;
+  static constexpr RGBA32 color(123, 215, 7, 42);
+  constexpr std::array<std::byte, 4> pixel_data = [] {
+    std::array<std::byte, 4> pixel_data{};
+    pixel_format.write(color, pixel_data);
+    return pixel_data;
+  }();
+  static_assert(pixel_data[0] == std::byte{7}, "Must be 7.");
+  static_assert(pixel_data[1] == std::byte{215}, "Must be 215.");
+  static_assert(pixel_data[2] == std::byte{123}, "Must be 123.");
+  static_assert(pixel_data[3] == std::byte{42}, "Must be 42.");
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,39 @@
+#include <imageview/IsPixelFormat.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale16.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace imageview {
+namespace {
+
+static_assert(IsPixelFormat<PixelFormatGrayscale16>::value, "PixelFormatGrayscale16 must be a valid PixelFormat.");
+static_assert(IsPixelFormat<PixelFormatGrayscale16BE>::value, "PixelFormatGrayscale16BE must be a valid PixelFormat.");
+static_assert(PixelFormatGrayscale16::kBytesPerPixel == 2, "Color depth of PixelFormatGrayscale16 must be 16 bpp.");
+
+TEST(PixelFormatGrayscale16, Read) {
+  static constexpr std::array<const std::byte, 2> kPixelData{std::byte{0x34}, std::byte{0x12}};
+  static_assert(PixelFormatGrayscale16().read(kPixelData) == 0x1234, "Must be 0x1234.");
+  static_assert(PixelFormatGrayscale16BE().read(kPixelData) == 0x3412, "Must be 0x3412.");
+}
+
+TEST(PixelFormatGrayscale16, Write) {
+  constexpr std::array<std::byte, 2> pixel_data = [] {
+    std::array<std::byte, 2> pixel_data{};
+    PixelFormatGrayscale16().write(0xABCD, pixel_data);
+    return pixel_data;
+  }();
+  static_assert(pixel_data[0] == std::byte{0xCD}, "Must be 0xCD.");
+  static_assert(pixel_data[1] == std::byte{0xAB}, "Must be 0xAB.");
+  constexpr std::array<std::byte, 2> pixel_data_be = [] {
+    std::array<std::byte, 2> pixel_data{};
+    PixelFormatGrayscale16BE().write(0xABCD, pixel_data);
+    return pixel_data;
+  }();
+  static_assert(pixel_data_be[0] == std::byte{0xAB}, "Must be 0xAB.");
+  static_assert(pixel_data_be[1] == std::byte{0xCD}, "Must be 0xCD.");
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,26 @@
+#include <imageview/IsBitPackedPixelFormat.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale2.h>
+
+#include <gtest/gtest.h>
+
+namespace imageview {
+namespace {
+
+static_assert(IsBitPackedPixelFormat<PixelFormatGrayscale2>::value,
+              "PixelFormatGrayscale2 must be a valid bit-packed PixelFormat.");
+static_assert(PixelFormatGrayscale2::kBitsPerPixel == 2, "Color depth of PixelFormatGrayscale2 must be 2 bpp.");
+
+TEST(PixelFormatGrayscale2, Read) {
+  constexpr PixelFormatGrayscale2 pixel_format;
+  static_assert(pixel_format.read(3) == 3, "Must be 3.");
+  static_assert(pixel_format.read(1) == 1, "Must be 1.");
+}
+
+TEST(PixelFormatGrayscale2, Write) {
+  constexpr PixelFormatGrayscale2 pixel_format;
+  static_assert(pixel_format.write(3) == 3, "Must be 3.");
+  static_assert(pixel_format.write(4) == 0, "Only the lowest 2 bits must be stored.");
+}
+
+}  // namespace
+}  // namespace imageview
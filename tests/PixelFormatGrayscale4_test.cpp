@@ -0,0 +1,26 @@
+#include <imageview/IsBitPackedPixelFormat.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale4.h>
+
+#include <gtest/gtest.h>
+
+namespace imageview {
+namespace {
+
+static_assert(IsBitPackedPixelFormat<PixelFormatGrayscale4>::value,
+              "PixelFormatGrayscale4 must be a valid bit-packed PixelFormat.");
+static_assert(PixelFormatGrayscale4::kBitsPerPixel == 4, "Color depth of PixelFormatGrayscale4 must be 4 bpp.");
+
+TEST(PixelFormatGrayscale4, Read) {
+  constexpr PixelFormatGrayscale4 pixel_format;
+  static_assert(pixel_format.read(15) == 15, "Must be 15.");
+  static_assert(pixel_format.read(1) == 1, "Must be 1.");
+}
+
+TEST(PixelFormatGrayscale4, Write) {
+  constexpr PixelFormatGrayscale4 pixel_format;
+  static_assert(pixel_format.write(15) == 15, "Must be 15.");
+  static_assert(pixel_format.write(16) == 0, "Only the lowest 4 bits must be stored.");
+}
+
+}  // namespace
+}  // namespace imageview
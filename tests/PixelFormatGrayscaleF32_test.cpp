@@ -0,0 +1,36 @@
+#include <imageview/IsPixelFormat.h>
+#include <imageview/pixel_formats/PixelFormatGrayscaleF32.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace imageview {
+namespace {
+
+static_assert(IsPixelFormat<PixelFormatGrayscaleF32>::value, "PixelFormatGrayscaleF32 must be a valid PixelFormat.");
+static_assert(PixelFormatGrayscaleF32::kBytesPerPixel == 4, "Color depth of PixelFormatGrayscaleF32 must be 32 bpp.");
+
+TEST(PixelFormatGrayscaleF32, Read) {
+  // 1.0f is 0x3F800000 in IEEE 754 binary32.
+  static constexpr std::array<const std::byte, 4> kPixelDataLE{std::byte{0x00}, std::byte{0x00}, std::byte{0x80},
+                                                               std::byte{0x3F}};
+  static constexpr std::array<const std::byte, 4> kPixelDataBE{std::byte{0x3F}, std::byte{0x80}, std::byte{0x00},
+                                                               std::byte{0x00}};
+  static_assert(PixelFormatGrayscaleF32().read(kPixelDataLE) == 1.0f, "Must be 1.0f.");
+  static_assert(PixelFormatGrayscaleF32BE().read(kPixelDataBE) == 1.0f, "Must be 1.0f.");
+}
+
+TEST(PixelFormatGrayscaleF32, Write) {
+  constexpr std::array<std::byte, 4> pixel_data = [] {
+    std::array<std::byte, 4> pixel_data{};
+    PixelFormatGrayscaleF32BE().write(-2.0f, pixel_data);
+    return pixel_data;
+  }();
+  // -2.0f is 0xC0000000 in IEEE 754 binary32.
+  static_assert(pixel_data[0] == std::byte{0xC0}, "Must be 0xC0.");
+  static_assert(pixel_data[3] == std::byte{0x00}, "Must be 0x00.");
+}
+
+}  // namespace
+}  // namespace imageview
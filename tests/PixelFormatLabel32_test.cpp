@@ -0,0 +1,29 @@
+#include <imageview/IsPixelFormat.h>
+#include <imageview/IsTriviallyEncoded.h>
+#include <imageview/pixel_formats/PixelFormatLabel32.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace imageview {
+namespace {
+
+static_assert(IsPixelFormat<PixelFormatLabel32>::value, "PixelFormatLabel32 must be a valid PixelFormat.");
+static_assert(IsTriviallyEncoded<PixelFormatLabel32>::value, "PixelFormatLabel32 must be trivially encoded.");
+static_assert(PixelFormatLabel32::kBytesPerPixel == 4, "Color depth of PixelFormatLabel32 must be 32 bpp.");
+
+TEST(PixelFormatLabel32, ReadWrite) {
+  constexpr std::array<std::byte, 4> pixel_data = [] {
+    std::array<std::byte, 4> pixel_data{};
+    PixelFormatLabel32().write(0x12345678, pixel_data);
+    return pixel_data;
+  }();
+  static_assert(PixelFormatLabel32().read(pixel_data) == 0x12345678, "Must be 0x12345678.");
+  static_assert(std::bit_cast<std::uint32_t>(pixel_data) == 0x12345678, "Must be stored in the native byte order.");
+}
+
+}  // namespace
+}  // namespace imageview
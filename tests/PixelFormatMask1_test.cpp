@@ -0,0 +1,27 @@
+#include <imageview/IsBitPackedPixelFormat.h>
+#include <imageview/pixel_formats/PixelFormatMask1.h>
+
+#include <gtest/gtest.h>
+
+namespace imageview {
+namespace {
+
+static_assert(IsBitPackedPixelFormat<PixelFormatMask1>::value,
+              "PixelFormatMask1 must be a valid bit-packed PixelFormat.");
+static_assert(!IsPixelFormat<PixelFormatMask1>::value, "PixelFormatMask1 must not be a byte-aligned PixelFormat.");
+static_assert(PixelFormatMask1::kBitsPerPixel == 1, "Color depth of PixelFormatMask1 must be 1 bpp.");
+
+TEST(PixelFormatMask1, Read) {
+  constexpr PixelFormatMask1 pixel_format;
+  static_assert(pixel_format.read(0) == false, "Must be false.");
+  static_assert(pixel_format.read(1) == true, "Must be true.");
+}
+
+TEST(PixelFormatMask1, Write) {
+  constexpr PixelFormatMask1 pixel_format;
+  static_assert(pixel_format.write(false) == 0, "Must be 0.");
+  static_assert(pixel_format.write(true) == 1, "Must be 1.");
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,38 @@
+#include <imageview/IsPixelFormat.h>
+#include <imageview/pixel_formats/PixelFormatRGB48.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace imageview {
+namespace {
+
+static_assert(IsPixelFormat<PixelFormatRGB48>::value, "PixelFormatRGB48 must be a valid PixelFormat.");
+static_assert(IsPixelFormat<PixelFormatRGB48BE>::value, "PixelFormatRGB48BE must be a valid PixelFormat.");
+static_assert(PixelFormatRGB48::kBytesPerPixel == 6, "Color depth of PixelFormatRGB48 must be 48 bpp.");
+
+TEST(PixelFormatRGB48, Read) {
+  static constexpr std::array<const std::byte, 6> kPixelData{std::byte{0x01}, std::byte{0x02}, std::byte{0x03},
+                                                             std::byte{0x04}, std::byte{0x05}, std::byte{0x06}};
+  static_assert(PixelFormatRGB48().read(kPixelData) == RGB48(0x0201, 0x0403, 0x0605),
+                "Must be {0x0201, 0x0403, 0x0605}.");
+  static_assert(PixelFormatRGB48BE().read(kPixelData) == RGB48(0x0102, 0x0304, 0x0506),
+                "Must be {0x0102, 0x0304, 0x0506}.");
+}
+
+TEST(PixelFormatRGB48, Write) {
+  static constexpr RGB48 color(0x0102, 0x0304, 0x0506);
+  constexpr std::array<std::byte, 6> pixel_data = [] {
+    std::array<std::byte, 6> pixel_data{};
+    PixelFormatRGB48BE().write(color, pixel_data);
+    return pixel_data;
+  }();
+  static_assert(pixel_data[0] == std::byte{0x01}, "Must be 0x01.");
+  static_assert(pixel_data[3] == std::byte{0x04}, "Must be 0x04.");
+  static_assert(pixel_data[5] == std::byte{0x06}, "Must be 0x06.");
+  static_assert(PixelFormatRGB48BE().read(pixel_data) == color, "Must round-trip.");
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,29 @@
+#include <imageview/IsPixelFormat.h>
+#include <imageview/pixel_formats/PixelFormatRGBF32.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace imageview {
+namespace {
+
+static_assert(IsPixelFormat<PixelFormatRGBF32>::value, "PixelFormatRGBF32 must be a valid PixelFormat.");
+static_assert(PixelFormatRGBF32::kBytesPerPixel == 12, "Color depth of PixelFormatRGBF32 must be 96 bpp.");
+
+TEST(PixelFormatRGBF32, WriteRead) {
+  static constexpr RGBF32 color(0.25f, -1.5f, 3.0f);
+  constexpr std::array<std::byte, 12> pixel_data = [] {
+    std::array<std::byte, 12> pixel_data{};
+    PixelFormatRGBF32().write(color, pixel_data);
+    return pixel_data;
+  }();
+  // 0.25f is 0x3E800000 in IEEE 754 binary32.
+  static_assert(pixel_data[3] == std::byte{0x3E}, "Must be 0x3E.");
+  static_assert(pixel_data[2] == std::byte{0x80}, "Must be 0x80.");
+  static_assert(PixelFormatRGBF32().read(pixel_data) == color, "Must round-trip.");
+  static_assert(PixelFormatRGBF32BE().read(pixel_data) != color, "Byte order must matter.");
+}
+
+}  // namespace
+}  // namespace imageview
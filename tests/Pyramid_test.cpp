@@ -0,0 +1,116 @@
+#include <imageview/Pyramid.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Straightforward implementation of a single downsampling step.
+std::vector<unsigned char> downsampleReference(const std::vector<unsigned char>& src, int height, int width,
+                                               PyramidMode mode) {
+  const int dst_height = (height + 1) / 2;
+  const int dst_width = (width + 1) / 2;
+  const auto at = [&](int y, int x) {
+    return static_cast<int>(src[std::clamp(y, 0, height - 1) * width + std::clamp(x, 0, width - 1)]);
+  };
+  constexpr int kWeights[5] = {1, 4, 6, 4, 1};
+  std::vector<unsigned char> dst(dst_height * dst_width);
+  for (int y = 0; y < dst_height; ++y) {
+    for (int x = 0; x < dst_width; ++x) {
+      int value = 0;
+      if (mode == PyramidMode::kBox2x2) {
+        value = (at(2 * y, 2 * x) + at(2 * y, 2 * x + 1) + at(2 * y + 1, 2 * x) + at(2 * y + 1, 2 * x + 1) + 2) / 4;
+      } else {
+        int sum = 0;
+        for (int dy = -2; dy <= 2; ++dy) {
+          for (int dx = -2; dx <= 2; ++dx) {
+            sum += kWeights[dy + 2] * kWeights[dx + 2] * at(2 * y + dy, 2 * x + dx);
+          }
+        }
+        value = (sum + 128) / 256;
+      }
+      dst[y * dst_width + x] = static_cast<unsigned char>(value);
+    }
+  }
+  return dst;
+}
+
+void checkAgainstReference(PyramidMode mode) {
+  constexpr int kHeight = 37;
+  constexpr int kWidth = 45;
+  constexpr int kStride = 50;
+  std::vector<std::byte> data((kHeight - 1) * kStride + kWidth);
+  std::vector<unsigned char> expected(kHeight * kWidth);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      const auto value = static_cast<unsigned char>((y * 31 + x * 17 + (x * y) % 7) % 256);
+      data[y * kStride + x] = static_cast<std::byte>(value);
+      expected[y * kWidth + x] = value;
+    }
+  }
+  const ImageView<PixelFormatGrayscale8> image(kHeight, kWidth, kStride, data);
+  const ImagePyramid<PixelFormatGrayscale8> pyramid = buildPyramid(image, 7, mode);
+  ASSERT_EQ(pyramid.size(), 7);
+  EXPECT_EQ(pyramid[0].data().data(), image.data().data());
+  int height = kHeight;
+  int width = kWidth;
+  for (std::size_t level = 1; level < pyramid.size(); ++level) {
+    expected = downsampleReference(expected, height, width, mode);
+    height = (height + 1) / 2;
+    width = (width + 1) / 2;
+    const ImageView<PixelFormatGrayscale8> actual = pyramid[level];
+    ASSERT_EQ(actual.height(), height);
+    ASSERT_EQ(actual.width(), width);
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        ASSERT_EQ(actual(y, x), expected[y * width + x]) << "level " << level << " (" << y << ", " << x << ")";
+      }
+    }
+  }
+  // Levels 5 and 6 are 2x2 and 1x1.
+  EXPECT_EQ(pyramid[6].height(), 1);
+  EXPECT_EQ(pyramid[6].width(), 1);
+}
+
+TEST(Pyramid, Box2x2) { checkAgainstReference(PyramidMode::kBox2x2); }
+
+TEST(Pyramid, Gaussian5) { checkAgainstReference(PyramidMode::kGaussian5); }
+
+TEST(Pyramid, LevelsAreContiguous) {
+  std::vector<std::byte> data(16 * 16 * PixelFormatRGB24::kBytesPerPixel);
+  const ImageView<PixelFormatRGB24, true> image(16, 16, 16, data);
+  image(0, 0) = RGB24(100, 0, 255);
+  image(0, 1) = RGB24(200, 0, 255);
+  image(1, 0) = RGB24(100, 0, 255);
+  image(1, 1) = RGB24(201, 0, 255);
+  const ImagePyramid<PixelFormatRGB24> pyramid = buildPyramid(image, 4, PyramidMode::kBox2x2);
+  EXPECT_EQ(pyramid[1](0, 0), RGB24(150, 0, 255));
+  const std::span<const ImageView<PixelFormatRGB24>> levels = pyramid.levels();
+  ASSERT_EQ(levels.size(), 4);
+  for (std::size_t level = 1; level + 1 < levels.size(); ++level) {
+    EXPECT_EQ(levels[level].data().data() + levels[level].data().size(), levels[level + 1].data().data());
+  }
+}
+
+TEST(Pyramid, SingleLevelAndEmpty) {
+  std::array<std::byte, 4> data{};
+  const ImageView<PixelFormatGrayscale8> image(2, 2, 2, data);
+  const ImagePyramid<PixelFormatGrayscale8> single = buildPyramid(image, 1, PyramidMode::kGaussian5);
+  EXPECT_EQ(single.size(), 1);
+  EXPECT_THROW(single.at(1), std::out_of_range);
+  EXPECT_THROW(buildPyramid(image, 0, PyramidMode::kBox2x2), std::invalid_argument);
+
+  const ImagePyramid<PixelFormatGrayscale8> empty =
+      buildPyramid(ImageView<PixelFormatGrayscale8>(), 3, PyramidMode::kGaussian5);
+  EXPECT_EQ(empty.size(), 3);
+  EXPECT_TRUE(empty[2].empty());
+}
+
+}  // namespace
+}  // namespace imageview
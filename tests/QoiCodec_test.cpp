@@ -0,0 +1,192 @@
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageViewUtils.h>
+#include <imageview/QoiCodec.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Returns a bitmap with long runs, smooth gradients and noise, so that every QOI operation is used.
+std::vector<std::byte> makeBitmap(unsigned int height, unsigned int width, unsigned int bytes_per_pixel) {
+  std::vector<std::byte> data(static_cast<std::size_t>(height) * width * bytes_per_pixel);
+  test::Lcg generator(1);
+  for (unsigned int y = 0; y < height; ++y) {
+    for (unsigned int x = 0; x < width; ++x) {
+      const unsigned int random = generator.next();
+      for (unsigned int c = 0; c < bytes_per_pixel; ++c) {
+        unsigned int value = 0;
+        switch (y % 4) {
+          case 0:
+            value = 17 * c;
+            break;
+          case 1:
+            value = x + 3 * c;
+            break;
+          case 2:
+            value = x * (c + 1) + (x / 8) * 40;
+            break;
+          default:
+            value = (random >> (2 * c)) & 0xFF;
+            break;
+        }
+        data[(static_cast<std::size_t>(y) * width + x) * bytes_per_pixel + c] = static_cast<std::byte>(value);
+      }
+    }
+  }
+  return data;
+}
+
+std::span<const std::byte> asBytes(const std::string& data) {
+  return std::as_bytes(std::span(data.data(), data.size()));
+}
+
+TEST(QoiCodec, EncodesRunsOfThePreviousPixel) {
+  const std::vector<std::byte> data(2 * 2 * 3);
+  std::vector<std::byte> encoded;
+  encodeQoi(ImageView<PixelFormatRGB24>(2, 2, 2, data), encoded);
+  const std::vector<unsigned char> expected = {'q', 'o', 'i', 'f', 0, 0, 0, 2, 0, 0, 0, 2, 3, 0,
+                                               0xC3, 0, 0, 0, 0, 0, 0, 0, 1};
+  ASSERT_EQ(encoded.size(), expected.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(static_cast<unsigned char>(encoded[i]), expected[i]) << i;
+  }
+}
+
+TEST(QoiCodec, DecodesAllOperations) {
+  const std::vector<unsigned char> encoded = {
+      'q', 'o', 'i', 'f', 0, 0, 0, 6, 0, 0, 0, 1, 4, 0,
+      0xFE, 10, 20, 30,                // RGB: (10, 20, 30, 255)
+      0x40 | (3 << 4) | (0 << 2) | 2,  // DIFF: (+1, -2, 0)
+      0x80 | 40, (3 << 4) | 12,        // LUMA: dg = 8, dr = 3, db = 12
+      0xFF, 1, 2, 3, 4,                // RGBA
+      0x00 | 9,                        // INDEX of (10, 20, 30, 255)
+      0xC0,                            // RUN of 1
+      0, 0, 0, 0, 0, 0, 0, 1};
+  std::vector<std::byte> pixels(6 * 4);
+  const ImageView<PixelFormatRGBA32, true> image(1, 6, 6, pixels);
+  decodeQoi(std::as_bytes(std::span(encoded)), image);
+  EXPECT_EQ(image(0, 0), RGBA32(10, 20, 30, 255));
+  EXPECT_EQ(image(0, 1), RGBA32(11, 18, 30, 255));
+  EXPECT_EQ(image(0, 2), RGBA32(14, 26, 42, 255));
+  EXPECT_EQ(image(0, 3), RGBA32(1, 2, 3, 4));
+  EXPECT_EQ(image(0, 4), RGBA32(10, 20, 30, 255));
+  EXPECT_EQ(image(0, 5), RGBA32(10, 20, 30, 255));
+}
+
+TEST(QoiCodec, RoundTripRGBA32) {
+  constexpr unsigned int kHeight = 40;
+  constexpr unsigned int kWidth = 300;
+  const std::vector<std::byte> data = makeBitmap(kHeight, kWidth, 4);
+  const ImageView<PixelFormatRGBA32> image(kHeight, kWidth, kWidth, data);
+  std::vector<std::byte> encoded;
+  encodeQoi(image, encoded);
+  EXPECT_LT(encoded.size(), data.size());
+  EXPECT_EQ(parseQoiHeader(encoded).channels, 4u);
+
+  std::vector<std::byte> decoded(data.size());
+  const ImageView<PixelFormatRGBA32, true> decoded_image(kHeight, kWidth, kWidth, decoded);
+  decodeQoi(encoded, decoded_image);
+  EXPECT_TRUE(equal(decoded_image, image));
+}
+
+TEST(QoiCodec, RoundTripCroppedRGB24ThroughStreams) {
+  constexpr unsigned int kHeight = 200;
+  constexpr unsigned int kWidth = 300;
+  const std::vector<std::byte> data = makeBitmap(kHeight, kWidth, 3);
+  const ImageView<PixelFormatRGB24> image = crop(ImageView<PixelFormatRGB24>(kHeight, kWidth, kWidth, data), 3, 5,
+                                                 kHeight - 6, kWidth - 10);
+  std::ostringstream output;
+  encodeQoi(image, output, QoiColorspace::kLinear);
+  std::vector<std::byte> encoded;
+  encodeQoi(image, encoded, QoiColorspace::kLinear);
+  const std::string encoded_string = output.str();
+  // The stream is larger than the read buffer of the decoder.
+  ASSERT_GT(encoded_string.size(), QoiDecoder::kBufferSize);
+  const std::span<const std::byte> encoded_bytes = asBytes(encoded_string);
+  EXPECT_TRUE(std::equal(encoded.begin(), encoded.end(), encoded_bytes.begin(), encoded_bytes.end()));
+
+  // Decode into a crop of a larger image.
+  std::vector<std::byte> decoded(data.size());
+  const ImageView<PixelFormatRGB24, true> decoded_image =
+      crop(ImageView<PixelFormatRGB24, true>(kHeight, kWidth, kWidth, decoded), 1, 2, kHeight - 6, kWidth - 10);
+  std::istringstream input(encoded_string);
+  QoiDecoder decoder(input);
+  EXPECT_EQ(decoder.header().colorspace, QoiColorspace::kLinear);
+  for (unsigned int y = 0; y < decoded_image.height(); ++y) {
+    decoder.decodeRow(decoded_image.row(y));
+  }
+  EXPECT_TRUE(equal(decoded_image, image));
+  EXPECT_THROW(decoder.decodeRow(decoded_image.row(0)), std::invalid_argument);
+}
+
+TEST(QoiCodec, Grayscale8IsEncodedAsRGB) {
+  const std::vector<std::byte> data = makeBitmap(5, 70, 1);
+  const ImageView<PixelFormatGrayscale8> image(5, 70, 70, data);
+  std::vector<std::byte> encoded;
+  encodeQoi(image, encoded);
+  std::vector<std::byte> decoded(data.size() * 3);
+  const ImageView<PixelFormatRGB24, true> decoded_image(5, 70, 70, decoded);
+  decodeQoi(encoded, decoded_image);
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    for (unsigned int x = 0; x < image.width(); ++x) {
+      const unsigned char value = image(y, x);
+      EXPECT_EQ(decoded_image(y, x), RGB24(value, value, value));
+    }
+  }
+}
+
+TEST(QoiCodec, ThreeChannelEncoderIgnoresAlpha) {
+  const std::vector<std::byte> data = makeBitmap(3, 20, 4);
+  const ImageView<PixelFormatRGBA32> image(3, 20, 20, data);
+  std::vector<std::byte> encoded;
+  QoiEncoder encoder(encoded, 3, 20, 3);
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    encoder.encodeRow(image.row(y));
+  }
+  EXPECT_THROW(encoder.encodeRow(image.row(0)), std::invalid_argument);
+  encoder.finish();
+  EXPECT_THROW(encoder.finish(), std::invalid_argument);
+
+  std::vector<std::byte> decoded(data.size());
+  const ImageView<PixelFormatRGBA32, true> decoded_image(3, 20, 20, decoded);
+  decodeQoi(encoded, decoded_image);
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    for (unsigned int x = 0; x < image.width(); ++x) {
+      const RGBA32 color = image(y, x);
+      EXPECT_EQ(decoded_image(y, x), RGBA32(color.red, color.green, color.blue, 255));
+    }
+  }
+}
+
+TEST(QoiCodec, InvalidInput) {
+  const std::vector<std::byte> data = makeBitmap(4, 10, 3);
+  const ImageView<PixelFormatRGB24> image(4, 10, 10, data);
+  std::vector<std::byte> encoded;
+  encodeQoi(image, encoded);
+  std::vector<std::byte> decoded(data.size());
+
+  EXPECT_THROW(decodeQoi(encoded, ImageView<PixelFormatRGB24, true>(10, 4, 4, decoded)), std::invalid_argument);
+  const std::span<const std::byte> truncated = std::span(encoded).first(encoded.size() - 10);
+  EXPECT_THROW(decodeQoi(truncated, ImageView<PixelFormatRGB24, true>(4, 10, 10, decoded)), std::runtime_error);
+  std::vector<std::byte> corrupted = encoded;
+  corrupted[0] = std::byte{'Q'};
+  EXPECT_THROW(parseQoiHeader(corrupted), std::runtime_error);
+  corrupted = encoded;
+  corrupted[12] = std::byte{5};
+  EXPECT_THROW(parseQoiHeader(corrupted), std::runtime_error);
+  EXPECT_THROW(parseQoiHeader(std::span(encoded).first(10)), std::runtime_error);
+  EXPECT_THROW(encodeQoi(ImageView<PixelFormatRGB24>(), encoded), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,147 @@
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageViewUtils.h>
+#include <imageview/RleImage.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Returns an RGB24 bitmap with runs of various lengths, including runs longer than 32 bytes.
+std::vector<std::byte> makeBitmap(unsigned int height, unsigned int width) {
+  std::vector<std::byte> data(static_cast<std::size_t>(height) * width * 3);
+  for (unsigned int y = 0; y < height; ++y) {
+    for (unsigned int x = 0; x < width; ++x) {
+      const unsigned int value = (x / (y + 1)) % 3;
+      for (unsigned int c = 0; c < 3; ++c) {
+        data[(static_cast<std::size_t>(y) * width + x) * 3 + c] = static_cast<std::byte>(value * (c + 1));
+      }
+    }
+  }
+  return data;
+}
+
+TEST(RleImage, EncodeAndDecompress) {
+  constexpr unsigned int kHeight = 40;
+  constexpr unsigned int kWidth = 100;
+  const std::vector<std::byte> data = makeBitmap(kHeight, kWidth);
+  const ImageView<PixelFormatRGB24> image = crop(ImageView<PixelFormatRGB24>(kHeight, kWidth, kWidth, data), 1, 3,
+                                                 kHeight - 2, kWidth - 5);
+  const RleImage<PixelFormatRGB24> rle(image);
+  EXPECT_EQ(rle.height(), image.height());
+  EXPECT_EQ(rle.width(), image.width());
+  EXPECT_LT(rle.numRuns(), image.area() / 4);
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    const std::span<const unsigned int> run_ends = rle.runEnds(y);
+    ASSERT_FALSE(run_ends.empty());
+    EXPECT_EQ(run_ends.back(), image.width());
+    for (std::size_t run = 1; run < run_ends.size(); ++run) {
+      // Adjacent runs have different colors.
+      EXPECT_NE(rle.runColor(y, run), rle.runColor(y, run - 1));
+    }
+    for (unsigned int x = 0; x < image.width(); ++x) {
+      EXPECT_EQ(rle(y, x), image(y, x));
+    }
+  }
+
+  std::vector<std::byte> decompressed(data.size());
+  const ImageView<PixelFormatRGB24, true> decompressed_image = crop(
+      ImageView<PixelFormatRGB24, true>(kHeight, kWidth, kWidth, decompressed), 0, 2, kHeight - 2, kWidth - 5);
+  decompress(rle, decompressed_image);
+  EXPECT_TRUE(equal(decompressed_image, image));
+  EXPECT_THROW(decompress(rle, ImageView<PixelFormatRGB24, true>()), std::invalid_argument);
+  EXPECT_THROW(rle(image.height(), 0), std::out_of_range);
+  EXPECT_THROW(rle.runColor(0, rle.runEnds(0).size()), std::out_of_range);
+}
+
+TEST(RleImage, AppendRun) {
+  RleImage<PixelFormatGrayscale8> rle(5);
+  rle.appendRun(1, 2);
+  rle.appendRun(1, 1);
+  EXPECT_EQ(rle.height(), 0u);
+  EXPECT_THROW(rle.appendRun(2, 3), std::invalid_argument);
+  EXPECT_THROW(rle.appendRun(2, 0), std::invalid_argument);
+  rle.appendRun(2, 2);
+  rle.appendRun(2, 5);
+  ASSERT_EQ(rle.height(), 2u);
+  EXPECT_EQ(rle.numRuns(), 3u);
+  EXPECT_EQ(std::vector<unsigned int>(rle.runEnds(0).begin(), rle.runEnds(0).end()),
+            (std::vector<unsigned int>{3, 5}));
+  EXPECT_EQ(rle.runColor(1, 0), 2);
+}
+
+TEST(RleImage, CountAndBoundingBox) {
+  const std::vector<std::byte> data = makeBitmap(20, 60);
+  const ImageView<PixelFormatRGB24> image(20, 60, 60, data);
+  const RleImage<PixelFormatRGB24> rle(image);
+  const RGB24 color(2, 4, 6);
+  EXPECT_EQ(count(rle, color), static_cast<std::size_t>(std::count(image.begin(), image.end(), color)));
+
+  RleImage<PixelFormatGrayscale8> mask(10);
+  mask.appendRun(0, 10);
+  mask.appendRun(0, 4);
+  mask.appendRun(255, 2);
+  mask.appendRun(0, 4);
+  mask.appendRun(0, 1);
+  mask.appendRun(255, 7);
+  mask.appendRun(0, 2);
+  mask.appendRun(0, 10);
+  EXPECT_EQ(count(mask, 255), 9u);
+  const std::optional<BoundingBox> box = boundingBox(mask, 255);
+  ASSERT_TRUE(box.has_value());
+  EXPECT_EQ(box->first_row, 1u);
+  EXPECT_EQ(box->first_column, 1u);
+  EXPECT_EQ(box->num_rows, 2u);
+  EXPECT_EQ(box->num_columns, 7u);
+  EXPECT_FALSE(boundingBox(mask, 1).has_value());
+}
+
+TEST(RleImage, Combine) {
+  RleImage<PixelFormatGrayscale8> lhs(8);
+  lhs.appendRun(255, 5);
+  lhs.appendRun(0, 3);
+  RleImage<PixelFormatGrayscale8> rhs(8);
+  rhs.appendRun(0, 2);
+  rhs.appendRun(255, 6);
+  const RleImage<PixelFormatGrayscale8> intersection = combine(lhs, rhs, std::bit_and<>());
+  EXPECT_EQ(std::vector<unsigned int>(intersection.runEnds(0).begin(), intersection.runEnds(0).end()),
+            (std::vector<unsigned int>{2, 5, 8}));
+  EXPECT_EQ(count(intersection, 255), 3u);
+  const RleImage<PixelFormatGrayscale8> union_mask = combine(lhs, rhs, std::bit_or<>());
+  // Equal adjacent runs are merged.
+  EXPECT_EQ(union_mask.numRuns(), 1u);
+  EXPECT_EQ(union_mask(0, 7), 255);
+  EXPECT_THROW(combine(lhs, RleImage<PixelFormatGrayscale8>(8), std::bit_or<>()), std::invalid_argument);
+}
+
+TEST(RleImage, Fill) {
+  const std::vector<std::byte> data = makeBitmap(12, 50);
+  const ImageView<PixelFormatRGB24> image(12, 50, 50, data);
+  RleImage<PixelFormatRGB24> rle(image);
+  const BoundingBox box{2, 7, 5, 30};
+  const RGB24 color(9, 8, 7);
+  rle.fill(box, color);
+  EXPECT_EQ(rle.height(), image.height());
+  for (unsigned int y = 0; y < image.height(); ++y) {
+    for (unsigned int x = 0; x < image.width(); ++x) {
+      const bool inside = y >= box.first_row && y < box.first_row + box.num_rows && x >= box.first_column &&
+                          x < box.first_column + box.num_columns;
+      EXPECT_EQ(rle(y, x), inside ? color : image(y, x)) << y << ", " << x;
+    }
+  }
+  EXPECT_EQ(count(rle, color), 5u * 30u);
+  // Filling the whole image leaves a single run per row.
+  rle.fill(BoundingBox{0, 0, rle.height(), rle.width()}, color);
+  EXPECT_EQ(rle.numRuns(), rle.height());
+  EXPECT_THROW(rle.fill(BoundingBox{0, 1, 1, rle.width()}, color), std::out_of_range);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,150 @@
+#include <imageview/ImageViewUtils.h>
+#include <imageview/RowGenerator.h>
+#include <imageview/pixel_formats/PixelFormatBGR24.h>
+#include <imageview/pixel_formats/PixelFormatGrayscale8.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+std::vector<std::byte> makeBitmap(unsigned int height, unsigned int width) {
+  std::vector<std::byte> data(static_cast<std::size_t>(height) * width * 3);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(i % 253);
+  }
+  return data;
+}
+
+TEST(CoroutineArena, ReusesMemory) {
+  alignas(CoroutineArena::kAlignment) std::array<std::byte, 256> buffer;
+  CoroutineArena arena(buffer);
+  EXPECT_EQ(arena.capacity(), 256u);
+  void* first = arena.allocate(10);
+  void* second = arena.allocate(20);
+  EXPECT_EQ(first, buffer.data());
+  EXPECT_EQ(second, buffer.data() + CoroutineArena::kAlignment);
+  // The most recent block is reclaimed immediately.
+  arena.deallocate(second, 20);
+  EXPECT_EQ(arena.bytesUsed(), CoroutineArena::kAlignment);
+  EXPECT_EQ(arena.allocate(20), second);
+  arena.deallocate(first, 10);
+  EXPECT_GT(arena.bytesUsed(), 0u);
+  arena.deallocate(second, 20);
+  EXPECT_EQ(arena.bytesUsed(), 0u);
+  EXPECT_THROW(arena.allocate(257), std::bad_alloc);
+}
+
+TEST(RowGenerator, GeneratesRowsOfImage) {
+  const std::vector<std::byte> data = makeBitmap(6, 5);
+  const ImageView<PixelFormatRGB24> image = crop(ImageView<PixelFormatRGB24>(6, 5, 5, data), 1, 1, 4, 3);
+  unsigned int y = 0;
+  for (const ImageRowView<PixelFormatRGB24> row : generateRows(image)) {
+    ASSERT_LT(y, image.height());
+    EXPECT_EQ(row.data().data(), image.row(y).data().data());
+    ++y;
+  }
+  EXPECT_EQ(y, image.height());
+
+  // Mutable rows can be modified.
+  std::vector<std::byte> mutable_data = data;
+  for (const ImageRowView<PixelFormatRGB24, true> row :
+       generateRows(ImageView<PixelFormatRGB24, true>(6, 5, 5, mutable_data))) {
+    row[0] = RGB24(1, 2, 3);
+  }
+  EXPECT_EQ(ImageView<PixelFormatRGB24>(6, 5, 5, mutable_data)(5, 0), RGB24(1, 2, 3));
+}
+
+TEST(RowGenerator, AllocatesFramesFromArena) {
+  std::vector<std::byte> buffer(4096);
+  CoroutineArena arena(buffer);
+  const std::vector<std::byte> data = makeBitmap(3, 4);
+  const ImageView<PixelFormatRGB24> image(3, 4, 4, data);
+  for (int i = 0; i < 3; ++i) {
+    RowGenerator<PixelFormatRGB24> rows = generateRows(std::allocator_arg, arena, image);
+    EXPECT_GT(arena.bytesUsed(), 0u);
+    unsigned int num_rows = 0;
+    for (const ImageRowView<PixelFormatRGB24> row : rows) {
+      EXPECT_EQ(row.size(), 4u);
+      ++num_rows;
+    }
+    EXPECT_EQ(num_rows, 3u);
+  }
+  EXPECT_EQ(arena.bytesUsed(), 0u);
+
+  std::array<std::byte, 8> tiny_buffer;
+  CoroutineArena tiny_arena(tiny_buffer);
+  EXPECT_THROW(generateRows(std::allocator_arg, tiny_arena, image), std::bad_alloc);
+}
+
+TEST(RowGenerator, DecodesQoiLazily) {
+  constexpr unsigned int kHeight = 100;
+  constexpr unsigned int kWidth = 20;
+  const std::vector<std::byte> data = makeBitmap(kHeight, kWidth);
+  const ImageView<PixelFormatRGB24> image(kHeight, kWidth, kWidth, data);
+  std::vector<std::byte> encoded;
+  encodeQoi(image, encoded);
+
+  std::vector<std::byte> buffer(4096);
+  CoroutineArena arena(buffer);
+  {
+    unsigned int y = 0;
+    RowGenerator<PixelFormatRGB24> rows = decodeQoiRows<PixelFormatRGB24>(std::allocator_arg, arena, encoded);
+    for (const ImageRowView<PixelFormatRGB24> row : rows) {
+      EXPECT_TRUE(std::equal(row.begin(), row.end(), image.row(y).begin()));
+      // Stop after 10% of the image; the remaining rows are never decoded.
+      if (++y == kHeight / 10) {
+        break;
+      }
+    }
+    EXPECT_EQ(y, kHeight / 10);
+  }
+  EXPECT_EQ(arena.bytesUsed(), 0u);
+
+  const std::vector<std::byte> truncated(encoded.begin(), encoded.begin() + 10);
+  RowGenerator<PixelFormatRGB24> rows = decodeQoiRows<PixelFormatRGB24>(std::allocator_arg, arena, truncated);
+  EXPECT_THROW(rows.begin(), std::runtime_error);
+}
+
+TEST(RowGenerator, TransformsAndReadsBmpRows) {
+  const std::vector<std::byte> data = makeBitmap(5, 7);
+  const ImageView<PixelFormatRGB24> image(5, 7, 7, data);
+  std::ostringstream stream;
+  writeBmp(image, stream);
+  const std::string bmp_data = stream.str();
+  const BmpImage bmp(std::as_bytes(std::span(bmp_data.data(), bmp_data.size())));
+
+  std::vector<std::byte> buffer(4096);
+  CoroutineArena arena(buffer);
+  {
+    RowGenerator<PixelFormatGrayscale8> gray = transformRows<PixelFormatGrayscale8>(
+        std::allocator_arg, arena, generateBmpRows<PixelFormatBGR24>(std::allocator_arg, arena, bmp), bmp.width(),
+        [](ImageRowView<PixelFormatBGR24> src, ImageRowView<PixelFormatGrayscale8, true> dst) {
+          for (unsigned int x = 0; x < src.size(); ++x) {
+            dst[x] = src[x].green;
+          }
+        });
+    unsigned int y = 0;
+    for (const ImageRowView<PixelFormatGrayscale8> row : gray) {
+      for (unsigned int x = 0; x < row.size(); ++x) {
+        EXPECT_EQ(row[x], image(y, x).green);
+      }
+      ++y;
+    }
+    EXPECT_EQ(y, 5u);
+  }
+  EXPECT_EQ(arena.bytesUsed(), 0u);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,44 @@
+#include <imageview/ImageViewUtils.h>
+#include <imageview/SegmentedAlgorithms.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace imageview {
+namespace {
+
+constexpr RGB24 kRed(255, 0, 0);
+constexpr RGB24 kGreen(0, 255, 0);
+
+TEST(SegmentedAlgorithms, ForEachAndCount) {
+  std::vector<std::byte> data(5 * 6 * 3);
+  const ImageView<PixelFormatRGB24, true> image(5, 6, 6, data);
+  const ImageView<PixelFormatRGB24, true> cropped = crop(image, 1, 1, 3, 4);
+  forEach(cropped, [](auto&& pixel) { pixel = kRed; });
+  EXPECT_EQ(count(image.begin(), image.end(), kRed), 12);
+  EXPECT_EQ(count(cropped.begin(), cropped.end(), kRed), 12);
+  // Partial ranges that start and end in the middle of rows.
+  EXPECT_EQ(count(image.begin() + 8, image.begin() + 21, kRed), 9);
+  EXPECT_EQ(count(cropped.begin() + 1, cropped.begin() + 3, kRed), 2);
+  std::size_t num_pixels = 0;
+  forEach(cropped.cbegin() + 2, cropped.cend() - 1, [&num_pixels](const RGB24&) { ++num_pixels; });
+  EXPECT_EQ(num_pixels, 9);
+}
+
+TEST(SegmentedAlgorithms, Find) {
+  std::vector<std::byte> data(4 * 5 * 3);
+  const ImageView<PixelFormatRGB24, true> image(4, 5, 5, data);
+  const ImageView<PixelFormatRGB24, true> cropped = crop(image, 0, 1, 4, 3);
+  image(2, 4) = kGreen;
+  EXPECT_EQ(find(cropped.begin(), cropped.end(), kGreen), cropped.end());
+  image(2, 2) = kGreen;
+  const auto found = find(cropped.begin(), cropped.end(), kGreen);
+  EXPECT_EQ(found.rowIndex(), 2);
+  EXPECT_EQ(found.columnIndex(), 1);
+  EXPECT_EQ(find(cropped.begin() + 8, cropped.end(), kGreen), cropped.end());
+}
+
+}  // namespace
+}  // namespace imageview
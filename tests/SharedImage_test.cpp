@@ -0,0 +1,84 @@
+#include <imageview/ImageComparison.h>
+#include <imageview/ImageViewUtils.h>
+#include <imageview/SharedImage.h>
+#include <imageview/pixel_formats/PixelFormatRGB24.h>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+TEST(SharedImage, Empty) {
+  SharedImage<PixelFormatRGB24> image;
+  EXPECT_TRUE(image.empty());
+  EXPECT_FALSE(image.isShared());
+  EXPECT_TRUE(image.view().empty());
+  EXPECT_TRUE(image.mutableView().empty());
+}
+
+TEST(SharedImage, CopiesPixelsOfView) {
+  std::vector<std::byte> data(4 * 6 * 3);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(i);
+  }
+  const ImageView<PixelFormatRGB24> source = crop(ImageView<PixelFormatRGB24>(4, 6, 6, data), 1, 2, 3, 3);
+  const SharedImage<PixelFormatRGB24> image(source);
+  EXPECT_EQ(image.height(), 3u);
+  EXPECT_EQ(image.width(), 3u);
+  EXPECT_EQ(image.view().stride(), 3u);
+  EXPECT_NE(image.view().data().data(), source.data().data());
+  EXPECT_TRUE(equal(image.view(), source));
+}
+
+TEST(SharedImage, CopyOnWrite) {
+  SharedImage<PixelFormatRGB24> original(2, 3);
+  original.mutableView()(0, 0) = RGB24(1, 2, 3);
+  const std::byte* original_data = original.view().data().data();
+
+  SharedImage<PixelFormatRGB24> copy = original;
+  EXPECT_TRUE(original.isShared());
+  EXPECT_TRUE(copy.isShared());
+  // Read-only views never copy.
+  EXPECT_EQ(copy.view().data().data(), original_data);
+
+  // The first mutable view of a shared bitmap makes a private copy.
+  const ImageView<PixelFormatRGB24, true> copy_view = copy.mutableView();
+  EXPECT_NE(copy_view.data().data(), original_data);
+  EXPECT_FALSE(original.isShared());
+  EXPECT_FALSE(copy.isShared());
+  copy_view(1, 2) = RGB24(4, 5, 6);
+  EXPECT_EQ(copy.view()(0, 0), RGB24(1, 2, 3));
+  EXPECT_EQ(copy.view()(1, 2), RGB24(4, 5, 6));
+  EXPECT_EQ(original.view()(1, 2), RGB24(0, 0, 0));
+
+  // The bitmap of the only owner is modified in place.
+  EXPECT_EQ(original.mutableView().data().data(), original_data);
+}
+
+TEST(SharedImage, ConcurrentConsumers) {
+  SharedImage<PixelFormatRGB24> frame(16, 16);
+  fill(frame.mutableView(), RGB24(10, 20, 30));
+  std::vector<SharedImage<PixelFormatRGB24>> consumers(4, frame);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < consumers.size(); ++i) {
+    threads.emplace_back([&consumer = consumers[i], i] {
+      if (i % 2 == 0) {
+        fill(consumer.mutableView(), RGB24(static_cast<unsigned char>(i), 0, 0));
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(frame.view()(15, 15), RGB24(10, 20, 30));
+  EXPECT_EQ(consumers[1].view()(15, 15), RGB24(10, 20, 30));
+  EXPECT_EQ(consumers[2].view()(15, 15), RGB24(2, 0, 0));
+  EXPECT_EQ(consumers[1].view().data().data(), frame.view().data().data());
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,99 @@
+#include <imageview/SrgbConversions.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace imageview {
+namespace {
+
+TEST(SrgbConversions, BucketedEncodingIsExact) {
+  const detail::SrgbTables& tables = detail::getSrgbTables();
+  for (std::uint32_t v = 0; v < 65536; ++v) {
+    const long expected = std::lround(detail::encodeSrgb(v / 65535.0) * 255.0);
+    ASSERT_EQ(tables.encode(v), expected) << "v = " << v;
+  }
+}
+
+TEST(SrgbConversions, Grayscale8To16AndBack) {
+  std::array<std::byte, 256> data8{};
+  for (int i = 0; i < 256; ++i) {
+    data8[i] = static_cast<std::byte>(i);
+  }
+  const ImageView<PixelFormatGrayscale8> image8(16, 16, 16, data8);
+  std::array<std::byte, 512> data16{};
+  const ImageView<PixelFormatGrayscale16BE, true> image16(16, 16, 16, data16);
+  srgbToLinear(image8, image16);
+  EXPECT_EQ(image16(0, 0), 0);
+  // decode(10 / 255) = 0.0030353
+  EXPECT_EQ(image16(0, 10), 199);
+  // decode(128 / 255) = 0.2158605
+  EXPECT_EQ(image16(8, 0), 14146);
+  EXPECT_EQ(image16(15, 15), 65535);
+
+  std::array<std::byte, 256> data8_out{};
+  linearToSrgb(ImageView<PixelFormatGrayscale16BE>(image16),
+               ImageView<PixelFormatGrayscale8, true>(16, 16, 16, data8_out));
+  EXPECT_EQ(data8_out, data8);
+}
+
+TEST(SrgbConversions, RGB24ToF32AndBackStrided) {
+  // 2x2 image with stride 3.
+  std::array<std::byte, (3 + 2) * PixelFormatRGB24::kBytesPerPixel> data24{};
+  const ImageView<PixelFormatRGB24, true> image24(2, 2, 3, data24);
+  image24(0, 0) = RGB24(0, 128, 255);
+  image24(0, 1) = RGB24(1, 2, 3);
+  image24(1, 0) = RGB24(50, 100, 150);
+  image24(1, 1) = RGB24(200, 250, 254);
+  std::array<std::byte, 4 * PixelFormatRGBF32::kBytesPerPixel> data_f32{};
+  const ImageView<PixelFormatRGBF32, true> image_f32(2, 2, 2, data_f32);
+  srgbToLinear(image24, image_f32);
+  const RGBF32 color00 = image_f32(0, 0);
+  EXPECT_EQ(color00.red, 0.0f);
+  EXPECT_NEAR(color00.green, 0.2158605, 1e-6);
+  EXPECT_EQ(color00.blue, 1.0f);
+  const RGBF32 color01 = image_f32(0, 1);
+  EXPECT_NEAR(color01.red, 1.0 / 255.0 / 12.92, 1e-9);
+
+  std::array<std::byte, (3 + 2) * PixelFormatRGB24::kBytesPerPixel> data24_out{};
+  const ImageView<PixelFormatRGB24, true> image24_out(2, 2, 3, data24_out);
+  linearToSrgb(image_f32, image24_out);
+  for (unsigned int y = 0; y < 2; ++y) {
+    for (unsigned int x = 0; x < 2; ++x) {
+      EXPECT_EQ(image24_out(y, x), image24(y, x));
+    }
+  }
+}
+
+TEST(SrgbConversions, F32Saturates) {
+  std::array<std::byte, 4 * PixelFormatGrayscaleF32::kBytesPerPixel> data_f32{};
+  const ImageView<PixelFormatGrayscaleF32, true> image_f32(1, 4, 4, data_f32);
+  image_f32(0, 0) = -0.5f;
+  image_f32(0, 1) = 2.0f;
+  image_f32(0, 2) = std::numeric_limits<float>::quiet_NaN();
+  image_f32(0, 3) = 0.5f;
+  std::array<std::byte, 4> data8{};
+  const ImageView<PixelFormatGrayscale8, true> image8(1, 4, 4, data8);
+  linearToSrgb(image_f32, image8);
+  EXPECT_EQ(image8(0, 0), 0);
+  EXPECT_EQ(image8(0, 1), 255);
+  EXPECT_EQ(image8(0, 2), 0);
+  // encode(0.5) = 0.7353570
+  EXPECT_EQ(image8(0, 3), 188);
+}
+
+TEST(SrgbConversions, DimensionMismatch) {
+  std::array<std::byte, 4 * PixelFormatRGB24::kBytesPerPixel> data24{};
+  std::array<std::byte, 3 * PixelFormatRGB48::kBytesPerPixel> data48{};
+  EXPECT_THROW(srgbToLinear(ImageView<PixelFormatRGB24>(2, 2, 2, data24),
+                            ImageView<PixelFormatRGB48, true>(1, 3, 3, data48)),
+               std::invalid_argument);
+  EXPECT_THROW(linearToSrgb(ImageView<PixelFormatRGB48>(1, 3, 3, data48),
+                            ImageView<PixelFormatRGB24, true>(2, 2, 2, data24)),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Helpers shared by the tests.
+
+namespace imageview {
+namespace test {
+
+// Linear congruential generator for deterministic test data.
+class Lcg {
+ public:
+  explicit constexpr Lcg(unsigned int seed) noexcept : state_(seed) {}
+
+  // Returns the next pseudo-random number within [0; 65536).
+  constexpr unsigned int next() noexcept {
+    state_ = state_ * 1103515245u + 12345u;
+    return state_ >> 16;
+  }
+
+ private:
+  unsigned int state_;
+};
+
+// Returns @size pseudo-random bytes.
+inline std::vector<std::byte> makeBitmap(std::size_t size, unsigned int seed) {
+  std::vector<std::byte> data(size);
+  Lcg generator(seed);
+  for (std::byte& value : data) {
+    value = static_cast<std::byte>(generator.next());
+  }
+  return data;
+}
+
+}  // namespace test
+}  // namespace imageview
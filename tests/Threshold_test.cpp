@@ -0,0 +1,95 @@
+#include <imageview/Threshold.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+TEST(Threshold, Global) {
+  constexpr unsigned int kHeight = 5;
+  constexpr unsigned int kWidth = 21;
+  constexpr unsigned int kStride = 23;
+  const std::vector<std::byte> src_data = test::makeBitmap((kHeight - 1) * kStride + kWidth, 1);
+  const ImageView<PixelFormatGrayscale8> src(kHeight, kWidth, kStride, src_data);
+  std::vector<std::byte> dst_data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> dst(kHeight, kWidth, kWidth, dst_data);
+  // Bit-packed mask whose rows don't start at byte boundaries.
+  std::vector<std::byte> mask_data((3 + (kHeight - 1) * 22 + kWidth + 7) / 8);
+  const BitImageView<PixelFormatMask1, true> mask(kHeight, kWidth, 22, 3, mask_data);
+  threshold(src, dst, 100);
+  threshold(src, mask, 100);
+  for (unsigned int y = 0; y < kHeight; ++y) {
+    for (unsigned int x = 0; x < kWidth; ++x) {
+      const bool expected = src(y, x) > 100;
+      EXPECT_EQ(dst(y, x), expected ? 255 : 0);
+      EXPECT_EQ(mask(y, x), expected);
+    }
+  }
+}
+
+TEST(Threshold, Otsu) {
+  // Two clusters around 40 and 200.
+  std::vector<std::byte> data(100);
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<std::byte>(i % 2 == 0 ? 35 + i % 10 : 195 + i % 10);
+  }
+  const ImageView<PixelFormatGrayscale8> image(10, 10, 10, data);
+  const unsigned char value = otsuThreshold(image);
+  EXPECT_GE(value, 43);
+  EXPECT_LT(value, 195);
+  EXPECT_EQ(computeHistogram(image)[35], 10);
+  EXPECT_EQ(otsuThreshold(ImageView<PixelFormatGrayscale8>()), 0);
+}
+
+TEST(Threshold, Adaptive) {
+  constexpr unsigned int kHeight = 17;
+  constexpr unsigned int kWidth = 30;
+  const std::vector<std::byte> src_data = test::makeBitmap(kHeight * kWidth, 2);
+  const ImageView<PixelFormatGrayscale8> src(kHeight, kWidth, kWidth, src_data);
+  std::vector<std::byte> dst_data(kHeight * kWidth);
+  const ImageView<PixelFormatGrayscale8, true> dst(kHeight, kWidth, kWidth, dst_data);
+  std::vector<std::byte> mask_data((kHeight * kWidth + 7) / 8);
+  const BitImageView<PixelFormatMask1, true> mask(kHeight, kWidth, kWidth, 0, mask_data);
+  for (unsigned int radius : {0u, 2u, 40u}) {
+    for (int offset : {-5, 0, 7}) {
+      adaptiveThreshold(src, dst, radius, offset);
+      adaptiveThreshold(src, mask, radius, offset);
+      for (int y = 0; y < static_cast<int>(kHeight); ++y) {
+        for (int x = 0; x < static_cast<int>(kWidth); ++x) {
+          int sum = 0;
+          int count = 0;
+          for (int yy = std::max(0, y - static_cast<int>(radius));
+               yy <= std::min<int>(kHeight - 1, y + static_cast<int>(radius)); ++yy) {
+            for (int xx = std::max(0, x - static_cast<int>(radius));
+                 xx <= std::min<int>(kWidth - 1, x + static_cast<int>(radius)); ++xx) {
+              sum += src(yy, xx);
+              ++count;
+            }
+          }
+          const bool expected = static_cast<double>(src(y, x)) > static_cast<double>(sum) / count - offset;
+          ASSERT_EQ(dst(y, x), expected ? 255 : 0) << "radius = " << radius << ", offset = " << offset;
+          ASSERT_EQ(mask(y, x), expected) << "radius = " << radius << ", offset = " << offset;
+        }
+      }
+    }
+  }
+}
+
+TEST(Threshold, InvalidArguments) {
+  std::array<std::byte, 6> src_data = {};
+  std::array<std::byte, 6> dst_data = {};
+  const ImageView<PixelFormatGrayscale8> src(2, 3, 3, src_data);
+  EXPECT_THROW(threshold(src, ImageView<PixelFormatGrayscale8, true>(3, 2, 2, dst_data), 1), std::invalid_argument);
+  EXPECT_THROW(adaptiveThreshold(src, ImageView<PixelFormatGrayscale8, true>(2, 3, 3, dst_data), 2048, 0),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
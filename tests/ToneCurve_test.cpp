@@ -0,0 +1,106 @@
+#include <imageview/ToneCurve.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+namespace imageview {
+namespace {
+
+TEST(ToneCurve, Identity) {
+  constexpr ToneCurve curve;
+  static_assert(curve(0) == 0);
+  static_assert(curve(200) == 200);
+  static_assert(curve(255) == 255);
+}
+
+TEST(ToneCurve, Levels) {
+  constexpr ToneCurve curve = ToneCurve::levels(16, 235);
+  static_assert(curve(0) == 0);
+  static_assert(curve(16) == 0);
+  static_assert(curve(235) == 255);
+  static_assert(curve(255) == 255);
+  EXPECT_EQ(curve(126), 128);
+  EXPECT_THROW(ToneCurve::levels(100, 100), std::invalid_argument);
+}
+
+TEST(ToneCurve, Gamma) {
+  const ToneCurve curve = ToneCurve::gamma(2.0);
+  EXPECT_EQ(curve(0), 0);
+  EXPECT_EQ(curve(128), 64);
+  EXPECT_EQ(curve(255), 255);
+  EXPECT_THROW(ToneCurve::gamma(0.0), std::invalid_argument);
+  EXPECT_THROW(ToneCurve::gamma(std::nan("")), std::invalid_argument);
+}
+
+TEST(ToneCurve, FromFunctionSaturates) {
+  const ToneCurve curve = ToneCurve::fromFunction([](double value) { return value * 2.0 - 0.25; });
+  EXPECT_EQ(curve(0), 0);
+  EXPECT_EQ(curve(64), 64);
+  EXPECT_EQ(curve(128), 192);
+  EXPECT_EQ(curve(255), 255);
+}
+
+TEST(ToneCurve, Then) {
+  constexpr ToneCurve curve = ToneCurve::levels(0, 127).then(ToneCurve::invert());
+  static_assert(curve(0) == 255);
+  static_assert(curve(127) == 0);
+  static_assert(curve(255) == 0);
+  for (int i = 0; i < 256; ++i) {
+    const auto value = static_cast<unsigned char>(i);
+    EXPECT_EQ(curve(value), ToneCurve::invert()(ToneCurve::levels(0, 127)(value)));
+  }
+}
+
+TEST(ToneCurve, ApplyToGrayscale8InPlace) {
+  std::array<std::byte, 5> data{};
+  const ImageView<PixelFormatGrayscale8, true> image(2, 2, 3, data);
+  image(0, 0) = 0;
+  image(0, 1) = 10;
+  image(1, 0) = 200;
+  image(1, 1) = 255;
+  applyToneCurve(image, image, ToneCurve::invert());
+  EXPECT_EQ(image(0, 0), 255);
+  EXPECT_EQ(image(0, 1), 245);
+  EXPECT_EQ(image(1, 0), 55);
+  EXPECT_EQ(image(1, 1), 0);
+  // Padding is not modified.
+  EXPECT_EQ(data[2], std::byte{0});
+}
+
+TEST(ToneCurve, ApplyToRGBA32KeepsAlpha) {
+  std::array<std::byte, 2 * PixelFormatRGBA32::kBytesPerPixel> src_data{};
+  const ImageView<PixelFormatRGBA32, true> src(1, 2, 2, src_data);
+  src(0, 0) = RGBA32(0, 100, 200, 50);
+  src(0, 1) = RGBA32(255, 1, 2, 255);
+  std::array<std::byte, 2 * PixelFormatRGBA32::kBytesPerPixel> dst_data{};
+  const ImageView<PixelFormatRGBA32, true> dst(1, 2, 2, dst_data);
+  applyToneCurve(src, dst, ToneCurve::invert());
+  EXPECT_EQ(dst(0, 0), RGBA32(255, 155, 55, 50));
+  EXPECT_EQ(dst(0, 1), RGBA32(0, 254, 253, 255));
+
+  applyToneCurves(ImageView<PixelFormatRGBA32>(src), dst, ToneCurve(), ToneCurve::invert(),
+                  ToneCurve::levels(0, 100));
+  EXPECT_EQ(dst(0, 0), RGBA32(0, 155, 255, 50));
+  EXPECT_EQ(dst(0, 1), RGBA32(255, 254, 5, 255));
+}
+
+TEST(ToneCurve, ApplyToRGB24PerChannel) {
+  std::array<std::byte, PixelFormatRGB24::kBytesPerPixel> data{};
+  const ImageView<PixelFormatRGB24, true> image(1, 1, 1, data);
+  image(0, 0) = RGB24(10, 20, 30);
+  applyToneCurves(image, image, ToneCurve::invert(), ToneCurve(), ToneCurve::invert().then(ToneCurve::invert()));
+  EXPECT_EQ(image(0, 0), RGB24(245, 20, 30));
+}
+
+TEST(ToneCurve, DimensionMismatch) {
+  std::array<std::byte, 4> src_data{};
+  std::array<std::byte, 6> dst_data{};
+  EXPECT_THROW(applyToneCurve(ImageView<PixelFormatGrayscale8>(2, 2, 2, src_data),
+                              ImageView<PixelFormatGrayscale8, true>(1, 3, 3, dst_data), ToneCurve()),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
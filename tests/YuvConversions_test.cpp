@@ -0,0 +1,126 @@
+#include <imageview/YuvConversions.h>
+
+#include <gtest/gtest.h>
+
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace imageview {
+namespace {
+
+// Floating-point reference implementation of the conversion of a single YUV sample into RGB.
+std::array<int, 3> yuvToRgbReference(int y, int u, int v, YuvMatrix matrix, YuvRange range) {
+  const double kr = (matrix == YuvMatrix::kBT601) ? 0.299 : 0.2126;
+  const double kb = (matrix == YuvMatrix::kBT601) ? 0.114 : 0.0722;
+  const double kg = 1.0 - kr - kb;
+  const bool full = (range == YuvRange::kFull);
+  const double luma = full ? y : (y - 16) * 255.0 / 219.0;
+  const double cb = full ? u - 128 : (u - 128) * 255.0 / 224.0;
+  const double cr = full ? v - 128 : (v - 128) * 255.0 / 224.0;
+  const auto to_channel = [](double value) { return static_cast<int>(std::clamp(std::round(value), 0.0, 255.0)); };
+  return {to_channel(luma + 2 * (1 - kr) * cr),
+          to_channel(luma - 2 * kb * (1 - kb) / kg * cb - 2 * kr * (1 - kr) / kg * cr),
+          to_channel(luma + 2 * (1 - kb) * cb)};
+}
+
+TEST(YuvConversions, KnownColors) {
+  // 2x2 frame: black, white and 2 saturated red pixels (BT.601, limited range).
+  std::array<std::byte, 4 + 2> data = {std::byte{16}, std::byte{235}, std::byte{81}, std::byte{81},
+                                       std::byte{128}, std::byte{128}};
+  const NV12ImageView<> frame(2, 2, data);
+  std::array<std::byte, 12> rgb_data = {};
+  const ImageView<PixelFormatRGB24, true> rgb(2, 2, 2, rgb_data);
+  convert(frame, rgb);
+  EXPECT_EQ(rgb(0, 0), RGB24(0, 0, 0));
+  EXPECT_EQ(rgb(0, 1), RGB24(255, 255, 255));
+
+  std::array<std::byte, 12> red_data = {};
+  const ImageView<PixelFormatRGB24, true> red(2, 2, 2, red_data);
+  std::fill(red.begin(), red.end(), RGB24(255, 0, 0));
+  std::array<std::byte, 6> yuv_data = {};
+  const NV12ImageView<true> yuv(2, 2, yuv_data);
+  convert(red, yuv);
+  EXPECT_EQ(yuv.luma()(1, 1), 81);
+  EXPECT_EQ(yuv.chroma()(0, 0), 90);
+  EXPECT_EQ(yuv.chroma()(0, 1), 240);
+}
+
+TEST(YuvConversions, MatchesReference) {
+  constexpr unsigned int kHeight = 7;
+  constexpr unsigned int kWidth = 9;
+  std::vector<std::byte> data = test::makeBitmap(kHeight * kWidth + 2 * 4 * 5, 1);
+  const I420ImageView<> frame(kHeight, kWidth, data);
+  std::vector<std::byte> rgba_data(kHeight * kWidth * 4);
+  const ImageView<PixelFormatRGBA32, true> rgba(kHeight, kWidth, kWidth, rgba_data);
+  for (YuvMatrix matrix : {YuvMatrix::kBT601, YuvMatrix::kBT709}) {
+    for (YuvRange range : {YuvRange::kLimited, YuvRange::kFull}) {
+      convert(frame, rgba, matrix, range);
+      for (unsigned int y = 0; y < kHeight; ++y) {
+        for (unsigned int x = 0; x < kWidth; ++x) {
+          const std::array<int, 3> expected =
+              yuvToRgbReference(frame.luma()(y, x), frame.u()(y / 2, x / 2), frame.v()(y / 2, x / 2), matrix, range);
+          const RGBA32 actual = rgba(y, x);
+          EXPECT_LE(std::abs(actual.red - expected[0]), 1);
+          EXPECT_LE(std::abs(actual.green - expected[1]), 1);
+          EXPECT_LE(std::abs(actual.blue - expected[2]), 1);
+          EXPECT_EQ(actual.alpha, 255);
+        }
+      }
+    }
+  }
+}
+
+TEST(YuvConversions, NV12MatchesI420) {
+  constexpr unsigned int kHeight = 5;
+  constexpr unsigned int kWidth = 6;
+  const std::vector<std::byte> rgb_data = test::makeBitmap(kHeight * kWidth * 3, 2);
+  const ImageView<PixelFormatRGB24> rgb(kHeight, kWidth, kWidth, rgb_data);
+  std::vector<std::byte> nv12_data(kHeight * kWidth + 2 * 3 * 3);
+  std::vector<std::byte> i420_data(kHeight * kWidth + 2 * 3 * 3);
+  const NV12ImageView<true> nv12(kHeight, kWidth, nv12_data);
+  const I420ImageView<true> i420(kHeight, kWidth, i420_data);
+  convert(rgb, nv12, YuvMatrix::kBT709);
+  convert(rgb, i420, YuvMatrix::kBT709);
+  for (unsigned int y = 0; y < 3; ++y) {
+    for (unsigned int x = 0; x < 3; ++x) {
+      EXPECT_EQ(nv12.chroma()(y, 2 * x), i420.u()(y, x));
+      EXPECT_EQ(nv12.chroma()(y, 2 * x + 1), i420.v()(y, x));
+    }
+  }
+  std::vector<std::byte> from_nv12(kHeight * kWidth * 3);
+  std::vector<std::byte> from_i420(kHeight * kWidth * 3);
+  convert(nv12, ImageView<PixelFormatRGB24, true>(kHeight, kWidth, kWidth, from_nv12), YuvMatrix::kBT709);
+  convert(i420, ImageView<PixelFormatRGB24, true>(kHeight, kWidth, kWidth, from_i420), YuvMatrix::kBT709);
+  EXPECT_EQ(from_nv12, from_i420);
+}
+
+TEST(YuvConversions, RoundTripOfGray) {
+  // Gray pixels have no chroma, so the round trip only loses precision in luma.
+  std::vector<std::byte> rgb_data(4 * 4 * 3);
+  for (std::size_t i = 0; i < rgb_data.size(); ++i) {
+    rgb_data[i] = static_cast<std::byte>((i / 3) * 16);
+  }
+  const ImageView<PixelFormatRGB24> rgb(4, 4, 4, rgb_data);
+  std::vector<std::byte> yuv_data(16 + 8);
+  const I420ImageView<true> yuv(4, 4, yuv_data);
+  convert(rgb, yuv, YuvMatrix::kBT601, YuvRange::kFull);
+  std::vector<std::byte> result_data(rgb_data.size());
+  convert(yuv, ImageView<PixelFormatRGB24, true>(4, 4, 4, result_data), YuvMatrix::kBT601, YuvRange::kFull);
+  EXPECT_EQ(result_data, rgb_data);
+}
+
+TEST(YuvConversions, WrongDimensions) {
+  std::array<std::byte, 6> yuv_data = {};
+  std::array<std::byte, 12> rgb_data = {};
+  EXPECT_THROW(convert(NV12ImageView<>(2, 2, yuv_data), ImageView<PixelFormatRGB24, true>(1, 4, 4, rgb_data)),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview
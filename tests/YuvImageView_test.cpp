@@ -0,0 +1,65 @@
+#include <imageview/YuvImageView.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <stdexcept>
+
+namespace imageview {
+namespace {
+
+static_assert(getChromaSize(4) == 2, "Must be 2.");
+static_assert(getChromaSize(5) == 3, "Must be 3.");
+
+TEST(NV12ImageView, ContiguousLayout) {
+  // 3x5 frame: 15 luma samples, then 2 rows of 3 interleaved UV pairs.
+  std::array<std::byte, 15 + 12> data = {};
+  const NV12ImageView<true> frame(3, 5, data);
+  EXPECT_EQ(frame.height(), 3);
+  EXPECT_EQ(frame.width(), 5);
+  EXPECT_EQ(frame.chroma().height(), 2);
+  EXPECT_EQ(frame.chroma().width(), 6);
+  frame.luma()(2, 4) = 1;
+  frame.chroma()(1, 5) = 2;
+  EXPECT_EQ(data[14], std::byte{1});
+  EXPECT_EQ(data[26], std::byte{2});
+  const NV12ImageView<> const_frame = frame;
+  EXPECT_EQ(const_frame.chroma()(1, 5), 2);
+  EXPECT_THROW(NV12ImageView<true>(3, 5, std::span(data).first(26)), std::invalid_argument);
+}
+
+TEST(NV12ImageView, Planes) {
+  std::array<std::byte, 16> luma_data = {};
+  std::array<std::byte, 8> chroma_data = {};
+  const ImageView<PixelFormatGrayscale8> luma(4, 4, 4, luma_data);
+  EXPECT_NO_THROW(NV12ImageView<>(luma, ImageView<PixelFormatGrayscale8>(2, 4, 4, chroma_data)));
+  EXPECT_THROW(NV12ImageView<>(luma, ImageView<PixelFormatGrayscale8>(4, 2, 2, chroma_data)), std::invalid_argument);
+}
+
+TEST(I420ImageView, ContiguousLayout) {
+  // 3x5 frame: 15 luma samples, then 2x3 U samples and 2x3 V samples.
+  std::array<std::byte, 15 + 6 + 6> data = {};
+  const I420ImageView<true> frame(3, 5, data);
+  EXPECT_EQ(frame.u().height(), 2);
+  EXPECT_EQ(frame.u().width(), 3);
+  frame.u()(0, 0) = 1;
+  frame.v()(1, 2) = 2;
+  EXPECT_EQ(data[15], std::byte{1});
+  EXPECT_EQ(data[26], std::byte{2});
+  const I420ImageView<> const_frame = frame;
+  EXPECT_EQ(const_frame.v()(1, 2), 2);
+  EXPECT_THROW(I420ImageView<true>(4, 5, data), std::invalid_argument);
+}
+
+TEST(I420ImageView, Planes) {
+  std::array<std::byte, 9> luma_data = {};
+  std::array<std::byte, 4> u_data = {};
+  std::array<std::byte, 4> v_data = {};
+  const ImageView<PixelFormatGrayscale8> luma(3, 3, 3, luma_data);
+  const ImageView<PixelFormatGrayscale8> u(2, 2, 2, u_data);
+  EXPECT_NO_THROW(I420ImageView<>(luma, u, ImageView<PixelFormatGrayscale8>(2, 2, 2, v_data)));
+  EXPECT_THROW(I420ImageView<>(luma, u, ImageView<PixelFormatGrayscale8>(1, 4, 4, v_data)), std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace imageview